@@ -0,0 +1,139 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "context/ColumnBatch.h"
+
+#include "context/Iterator.h"
+
+namespace nebula {
+namespace graph {
+
+Column::Column(Type type, size_t size) : type_(type), size_(size), nulls_(size, false) {
+    switch (type_) {
+        case Type::kInt:
+            ints_.resize(size);
+            break;
+        case Type::kFloat:
+            floats_.resize(size);
+            break;
+        case Type::kBool:
+            bools_.resize(size);
+            break;
+        case Type::kString:
+            strs_.resize(size, nullptr);
+            break;
+        case Type::kValue:
+            nulls_.assign(size, true);
+            values_.resize(size);
+            break;
+    }
+}
+
+// static
+Column::Type Column::typeOf(Value::Type type) {
+    switch (type) {
+        case Value::Type::INT:
+            return Type::kInt;
+        case Value::Type::FLOAT:
+            return Type::kFloat;
+        case Value::Type::BOOL:
+            return Type::kBool;
+        case Value::Type::STRING:
+            return Type::kString;
+        default:
+            return Type::kValue;
+    }
+}
+
+void Column::set(size_t i, Value &&val) {
+    // The string column doesn't own the strings, so the new ones are kept as values
+    if (type_ != Type::kString && typeOf(val.type()) == type_) {
+        switch (type_) {
+            case Type::kInt:
+                ints_[i] = val.getInt();
+                break;
+            case Type::kFloat:
+                floats_[i] = val.getFloat();
+                break;
+            case Type::kBool:
+                bools_[i] = val.getBool();
+                break;
+            default:
+                break;
+        }
+        nulls_[i] = false;
+        return;
+    }
+    if (values_.empty()) {
+        values_.resize(size_);
+    }
+    values_[i] = std::move(val);
+    nulls_[i] = true;
+}
+
+void Column::setRef(size_t i, const Value &val) {
+    if (type_ == Type::kString && val.type() == Value::Type::STRING) {
+        strs_[i] = &val.getStr();
+        nulls_[i] = false;
+        return;
+    }
+    set(i, Value(val));
+}
+
+Value Column::value(size_t i) const {
+    if (nulls_[i]) {
+        return values_[i];
+    }
+    switch (type_) {
+        case Type::kInt:
+            return Value(ints_[i]);
+        case Type::kFloat:
+            return Value(floats_[i]);
+        case Type::kBool:
+            return Value(static_cast<bool>(bools_[i]));
+        case Type::kString:
+            return Value(*strs_[i]);
+        case Type::kValue:
+            break;
+    }
+    return values_[i];
+}
+
+Iterator *ColumnBatch::rowAt(size_t i) const {
+    iter_->reset(begin_ + i);
+    return iter_;
+}
+
+const Column &ColumnBatch::column(size_t colIdx) {
+    auto found = columns_.find(colIdx);
+    if (found != columns_.end()) {
+        return *found->second;
+    }
+
+    // The column type is decided by the first value which is not NULL or EMPTY
+    auto type = Column::Type::kValue;
+    DCHECK_GT(size(), 0);
+    iter_->reset(begin_);
+    for (size_t i = 0; i < size(); ++i, iter_->next()) {
+        auto &val = (*iter_->row())[colIdx];
+        if (!val.isNull() && !val.empty()) {
+            type = Column::typeOf(val.type());
+            break;
+        }
+    }
+
+    auto column = std::make_unique<Column>(type, size());
+    iter_->reset(begin_);
+    for (size_t i = 0; i < size(); ++i, iter_->next()) {
+        column->setRef(i, (*iter_->row())[colIdx]);
+    }
+    auto *ptr = column.get();
+    columns_.emplace(colIdx, std::move(column));
+    return *ptr;
+}
+
+}   // namespace graph
+}   // namespace nebula
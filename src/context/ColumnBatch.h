@@ -0,0 +1,139 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef CONTEXT_COLUMNBATCH_H_
+#define CONTEXT_COLUMNBATCH_H_
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+class Iterator;
+
+/***************************************************************************
+ *
+ * A column of values of a batch of rows. The values of int, float, bool and
+ * string are stored in the typed vector of the column type, the others
+ * (NULL, EMPTY, values of other types and the complex types) are marked in
+ * the null bitmap and kept as they are.
+ *
+ * The string column refers to the strings in the input rows without copying,
+ * so it must not outlive the input.
+ *
+ **************************************************************************/
+class Column final {
+public:
+    enum class Type : uint8_t {
+        kInt,
+        kFloat,
+        kBool,
+        kString,
+        // All the values are kept as they are
+        kValue,
+    };
+
+    Column(Type type, size_t size);
+
+    Type type() const {
+        return type_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    // The value at `i' is not of the column type
+    bool isNull(size_t i) const {
+        return nulls_[i];
+    }
+
+    int64_t getInt(size_t i) const {
+        return ints_[i];
+    }
+
+    double getFloat(size_t i) const {
+        return floats_[i];
+    }
+
+    bool getBool(size_t i) const {
+        return bools_[i];
+    }
+
+    const std::string &getStr(size_t i) const {
+        return *strs_[i];
+    }
+
+    void setInt(size_t i, int64_t val) {
+        ints_[i] = val;
+    }
+
+    void setFloat(size_t i, double val) {
+        floats_[i] = val;
+    }
+
+    void setBool(size_t i, bool val) {
+        bools_[i] = val;
+    }
+
+    // Set a value of any type, it's marked as null if not of the column type
+    void set(size_t i, Value &&val);
+
+    // Refer to the value, the strings are not copied
+    void setRef(size_t i, const Value &val);
+
+    Value value(size_t i) const;
+
+    // The column type which could hold values of `type' without boxing
+    static Type typeOf(Value::Type type);
+
+private:
+    Type type_;
+    size_t size_;
+    std::vector<int64_t> ints_;
+    std::vector<double> floats_;
+    std::vector<uint8_t> bools_;
+    std::vector<const std::string *> strs_;
+    std::vector<bool> nulls_;
+    // The values marked in the null bitmap, only allocated when there is any
+    std::vector<Value> values_;
+};
+
+// The input columns of the rows [begin, end) of a SequentialIter, each column is
+// only built when it's referenced.
+class ColumnBatch final {
+public:
+    ColumnBatch(Iterator *iter, size_t begin, size_t end)
+        : iter_(iter), begin_(begin), end_(end) {}
+
+    size_t begin() const {
+        return begin_;
+    }
+
+    size_t size() const {
+        return end_ - begin_;
+    }
+
+    // The iterator positioned at the `i'th row of batch
+    Iterator *rowAt(size_t i) const;
+
+    const Column &column(size_t colIdx);
+
+private:
+    Iterator *iter_;
+    size_t begin_;
+    size_t end_;
+    std::unordered_map<size_t, std::unique_ptr<Column>> columns_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // CONTEXT_COLUMNBATCH_H_
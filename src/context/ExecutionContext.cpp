@@ -6,6 +6,8 @@
 
 #include "context/ExecutionContext.h"
 
+#include "util/MemoryUtil.h"
+
 namespace nebula {
 namespace graph {
 constexpr int64_t ExecutionContext::kLatestVersion;
@@ -23,6 +25,58 @@ void ExecutionContext::setResult(const std::string& name, Result&& result) {
     hist.emplace_back(std::move(result));
 }
 
+bool ExecutionContext::setResult(const std::string& name,
+                                 Result&& result,
+                                 std::shared_ptr<MemoryTracker> tracker) {
+    auto* value = result.core_.value.get();
+    if (value == nullptr) {
+        setResult(name, std::move(result));
+        return true;
+    }
+    {
+        std::lock_guard<std::mutex> guard(accountedLock_);
+        auto found = accounted_.find(value);
+        if (found != accounted_.end()) {
+            result.core_.reservation = found->second.lock();
+        }
+    }
+    if (result.core_.reservation != nullptr) {
+        setResult(name, std::move(result));
+        return true;
+    }
+
+    // The value is new, or all the results keeping it have been dropped
+    auto bytes = static_cast<int64_t>(MemoryUtil::estimateSize(*value));
+    auto ok = tracker->consume(bytes);
+    result.core_.reservation = std::make_shared<MemoryReservation>(std::move(tracker), bytes);
+    {
+        std::lock_guard<std::mutex> guard(accountedLock_);
+        accounted_[value] = result.core_.reservation;
+        if (accounted_.size() >= purgeSize_) {
+            // Forget the values dropped
+            for (auto it = accounted_.begin(); it != accounted_.end();) {
+                it = it->second.expired() ? accounted_.erase(it) : std::next(it);
+            }
+            purgeSize_ = std::max<size_t>(accounted_.size() * 2, 64);
+        }
+    }
+    setResult(name, std::move(result));
+    return ok;
+}
+
+void ExecutionContext::copyTo(ExecutionContext* ectx) const {
+    for (auto& var : valueMap_) {
+        auto& hist = ectx->valueMap_[var.first];
+        for (auto& result : var.second) {
+            hist.emplace_back(ResultBuilder()
+                                  .value(Value(result.value()))
+                                  .iter(result.iter()->kind())
+                                  .state(result.state())
+                                  .finish());
+        }
+    }
+}
+
 void ExecutionContext::deleteValue(const std::string& name) {
     valueMap_.erase(name);
 }
@@ -7,6 +7,8 @@
 #ifndef CONTEXT_EXECUTIONCONTEXT_H_
 #define CONTEXT_EXECUTIONCONTEXT_H_
 
+#include <mutex>
+
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
 #include "context/Result.h"
@@ -62,6 +64,13 @@ public:
 
     void setResult(const std::string& name, Result&& result);
 
+    // Set the result, and account the bytes of its value in `tracker' as long as some result
+    // keeps the value. A value shared by many results, e.g. one forwarded from the input, is
+    // accounted only once. Return false if the tracker goes beyond its limit.
+    bool setResult(const std::string& name,
+                   Result&& result,
+                   std::shared_ptr<MemoryTracker> tracker);
+
     void deleteValue(const std::string& name);
 
     // Only keep the last several versoins of the Value
@@ -71,12 +80,22 @@ public:
         return valueMap_.find(name) != valueMap_.end();
     }
 
+    // Copy all the versions of all the values into `ectx'. The values are copied instead
+    // of shared, since the executors may modify them in place.
+    void copyTo(ExecutionContext* ectx) const;
+
 private:
     friend class QueryInstance;
     Value moveValue(const std::string& name);
 
     // name -> Value with multiple versions
     std::unordered_map<std::string, std::vector<Result>>     valueMap_;
+
+    // The reservations of the accounted values by their addresses, the results are set
+    // concurrently by the executors so they are guarded by the lock
+    std::mutex                                                          accountedLock_;
+    std::unordered_map<const Value*, std::weak_ptr<MemoryReservation>>  accounted_;
+    size_t                                                              purgeSize_{64};
 };
 
 }  // namespace graph
@@ -6,6 +6,8 @@
 
 #include "context/Iterator.h"
 
+#include <folly/hash/Hash.h>
+
 #include "common/datatypes/Vertex.h"
 #include "common/datatypes/Edge.h"
 #include "common/interface/gen-cpp2/common_types.h"
@@ -46,6 +48,17 @@ bool equal_to<const nebula::graph::LogicalRow*>::operator()(
 
 namespace nebula {
 namespace graph {
+
+namespace {
+
+struct ColNamesHash {
+    size_t operator()(const std::vector<std::string>& colNames) const {
+        return folly::hash::hash_range(colNames.begin(), colNames.end());
+    }
+};
+
+}   // namespace
+
 GetNeighborsIter::GetNeighborsIter(std::shared_ptr<Value> value)
     : Iterator(value, Kind::kGetNeighbors) {
     auto status = processList(value);
@@ -65,60 +78,71 @@ Status GetNeighborsIter::processList(std::shared_ptr<Value> value) {
         ss << "Value type is not list, type: " << value->type();
         return Status::Error(ss.str());
     }
+    // The responses of one request have the same column names, so they are parsed once
+    std::unordered_map<std::vector<std::string>,
+                       std::shared_ptr<const ColumnLayout>,
+                       ColNamesHash>
+        layouts;
     size_t idx = 0;
     for (auto& val : value->getList().values) {
         if (UNLIKELY(!val.isDataSet())) {
             return Status::Error("There is a value in list which is not a data set.");
         }
-        auto status = makeDataSetIndex(val.getDataSet(), idx++);
-        NG_RETURN_IF_ERROR(status);
-        dsIndices_.emplace_back(std::move(status).value());
+        auto& ds = val.getDataSet();
+        auto& layout = layouts[ds.colNames];
+        if (layout == nullptr) {
+            auto status = makeLayout(ds.colNames);
+            NG_RETURN_IF_ERROR(status);
+            layout = std::move(status).value();
+        }
+        dsIndices_.emplace_back(makeDataSetIndex(ds, idx++, layout));
     }
     return Status::OK();
 }
 
-StatusOr<GetNeighborsIter::DataSetIndex> GetNeighborsIter::makeDataSetIndex(const DataSet& ds,
-                                                                            size_t idx) {
+GetNeighborsIter::DataSetIndex GetNeighborsIter::makeDataSetIndex(
+    const DataSet& ds,
+    size_t idx,
+    std::shared_ptr<const ColumnLayout> layout) {
     DataSetIndex dsIndex;
     dsIndex.ds = &ds;
-    auto buildResult = buildIndex(&dsIndex);
-    NG_RETURN_IF_ERROR(buildResult);
-    int64_t edgeStartIndex = std::move(buildResult).value();
-    if (edgeStartIndex < 0) {
+    dsIndex.layout = std::move(layout);
+    if (dsIndex.layout->edgeStartIndex < 0) {
         for (auto& row : dsIndex.ds->rows) {
-            logicalRows_.emplace_back(idx, &row, "", nullptr);
+            logicalRows_.emplace_back(idx, &row, -1, nullptr);
         }
     } else {
-        makeLogicalRowByEdge(edgeStartIndex, idx, dsIndex);
+        makeLogicalRowByEdge(idx, dsIndex);
     }
     return dsIndex;
 }
 
-void GetNeighborsIter::makeLogicalRowByEdge(int64_t edgeStartIndex,
-                                            size_t idx,
-                                            const DataSetIndex& dsIndex) {
+void GetNeighborsIter::makeLogicalRowByEdge(size_t idx, const DataSetIndex& dsIndex) {
+    auto& layout = *dsIndex.layout;
     for (auto& row : dsIndex.ds->rows) {
         auto& cols = row.values;
         bool existEdge = false;
-        for (size_t column = edgeStartIndex; column < cols.size() - 1; ++column) {
+        // The edge columns are followed by the column of `_expr'
+        auto edgeEndIndex = std::min(cols.size() - 1,
+                                     layout.edgeStartIndex + layout.edgeProps.size());
+        for (size_t column = layout.edgeStartIndex; column < edgeEndIndex; ++column) {
             if (!cols[column].isList()) {
                 // Ignore the bad value.
                 continue;
             }
+            auto edgeIdx = static_cast<int32_t>(column - layout.edgeStartIndex);
+            DCHECK_EQ(layout.edgeProps[edgeIdx].colIdx, column);
             for (auto& edge : cols[column].getList().values) {
                 if (!edge.isList()) {
                     // Ignore the bad value.
                     continue;
                 }
                 existEdge = true;
-                auto edgeName = dsIndex.tagEdgeNameIndices.find(column);
-                DCHECK(edgeName != dsIndex.tagEdgeNameIndices.end());
-                logicalRows_.emplace_back(
-                    idx, &row, edgeName->second, &edge.getList());
+                logicalRows_.emplace_back(idx, &row, edgeIdx, &edge.getList());
             }
         }
         if (!existEdge) {
-            noEdgeRows_.emplace_back(idx, &row, "", nullptr);
+            noEdgeRows_.emplace_back(idx, &row, -1, nullptr);
         }
     }
 }
@@ -128,34 +152,38 @@ bool checkColumnNames(const std::vector<std::string>& colNames) {
            colNames.back().find("_expr") != 0;
 }
 
-StatusOr<int64_t> GetNeighborsIter::buildIndex(DataSetIndex* dsIndex) {
-    auto& colNames = dsIndex->ds->colNames;
+StatusOr<std::shared_ptr<const GetNeighborsIter::ColumnLayout>> GetNeighborsIter::makeLayout(
+    const std::vector<std::string>& colNames) {
     if (UNLIKELY(checkColumnNames(colNames))) {
         return Status::Error("Bad column names.");
     }
-    int64_t edgeStartIndex = -1;
+    auto layout = std::make_shared<ColumnLayout>();
+    layout->colNames = colNames;
     for (size_t i = 0; i < colNames.size(); ++i) {
-        dsIndex->colIndices.emplace(colNames[i], i);
+        layout->colIndices.emplace(colNames[i], i);
         auto& colName = colNames[i];
         if (colName.find(nebula::kTag) == 0) {  // "_tag"
-            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, false, dsIndex));
+            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, false, layout.get()));
         } else if (colName.find("_edge") == 0) {
-            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, true, dsIndex));
-            if (edgeStartIndex < 0) {
-                edgeStartIndex = i;
+            if (layout->edgeStartIndex < 0) {
+                layout->edgeStartIndex = i;
+            } else if (UNLIKELY(i != layout->edgeStartIndex + layout->edgeProps.size())) {
+                // The edge of a row is indexed by its offset from the first edge column
+                return Status::Error("Edge columns are not adjacent: %s", colName.c_str());
             }
+            NG_RETURN_IF_ERROR(buildPropIndex(colName, i, true, layout.get()));
         } else {
             // It is "_vid", "_stats", "_expr" in this situation.
         }
     }
 
-    return edgeStartIndex;
+    return std::shared_ptr<const ColumnLayout>(std::move(layout));
 }
 
 Status GetNeighborsIter::buildPropIndex(const std::string& props,
                                        size_t columnId,
                                        bool isEdge,
-                                       DataSetIndex* dsIndex) {
+                                       ColumnLayout* layout) {
     std::vector<std::string> pieces;
     folly::split(":", props, pieces);
     if (UNLIKELY(pieces.size() < 2)) {
@@ -173,17 +201,18 @@ Status GetNeighborsIter::buildPropIndex(const std::string& props,
     propIdx.colIdx = columnId;
     propIdx.propList.resize(pieces.size() - 2);
     std::move(pieces.begin() + 2, pieces.end(), propIdx.propList.begin());
-    std::string name = pieces[1];
+    propIdx.name = std::move(pieces[1]);
+    auto& name = propIdx.name;
     if (isEdge) {
         // The first character of the edge name is +/-.
         if (UNLIKELY(name.empty() || (name[0] != '+' && name[0] != '-'))) {
             return Status::Error("Bad edge name: %s", name.c_str());
         }
-        dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-        dsIndex->edgePropsMap.emplace(name, std::move(propIdx));
+        layout->edgeIndices.emplace(name, layout->edgeProps.size());
+        layout->edgeProps.emplace_back(std::move(propIdx));
     } else {
-        dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-        dsIndex->tagPropsMap.emplace(name, std::move(propIdx));
+        layout->tagIndices.emplace(name, layout->tagProps.size());
+        layout->tagProps.emplace_back(std::move(propIdx));
     }
 
     return Status::OK();
@@ -193,8 +222,7 @@ const Value& GetNeighborsIter::getColumn(const std::string& col) const {
     if (!valid()) {
         return Value::kNullValue;
     }
-    auto segment = currentSeg();
-    auto& index = dsIndices_[segment].colIndices;
+    auto& index = currentLayout().colIndices;
     auto found = index.find(col);
     if (found == index.end()) {
         return Value::kEmpty;
@@ -215,17 +243,17 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag,
         return Value::kNullValue;
     }
 
-    auto segment = currentSeg();
-    auto &tagPropIndices = dsIndices_[segment].tagPropsMap;
-    auto index = tagPropIndices.find(tag);
-    if (index == tagPropIndices.end()) {
+    auto& layout = currentLayout();
+    auto index = layout.tagIndices.find(tag);
+    if (index == layout.tagIndices.end()) {
         return Value::kEmpty;
     }
-    auto propIndex = index->second.propIndices.find(prop);
-    if (propIndex == index->second.propIndices.end()) {
+    auto& tagProp = layout.tagProps[index->second];
+    auto propIndex = tagProp.propIndices.find(prop);
+    if (propIndex == tagProp.propIndices.end()) {
         return Value::kEmpty;
     }
-    auto colId = index->second.colIdx;
+    auto colId = tagProp.colIdx;
     DCHECK_EQ(iter_->segments_.size(), 1);
     auto& row = *(iter_->segments_[0]);
     DCHECK_GT(row.size(), colId);
@@ -242,21 +270,19 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge,
         return Value::kNullValue;
     }
 
-    auto currentEdge = currentEdgeName();
-    if (edge != "*" &&
-            (currentEdge.compare(1, std::string::npos, edge) != 0)) {
-        VLOG(1) << "Current edge: " << currentEdgeName() << " Wanted: " << edge;
+    auto* edgeIndex = currentEdgeIndex();
+    if (edgeIndex == nullptr) {
+        VLOG(1) << "No edge found: " << edge;
         return Value::kEmpty;
     }
-    auto segment = currentSeg();
-    auto index = dsIndices_[segment].edgePropsMap.find(currentEdge);
-    if (index == dsIndices_[segment].edgePropsMap.end()) {
-        VLOG(1) << "No edge found: " << edge;
-        VLOG(1) << "Current edge: " << currentEdge;
+    auto& currentEdge = edgeIndex->name;
+    if (edge != "*" &&
+            (currentEdge.compare(1, std::string::npos, edge) != 0)) {
+        VLOG(1) << "Current edge: " << currentEdge << " Wanted: " << edge;
         return Value::kEmpty;
     }
-    auto propIndex = index->second.propIndices.find(prop);
-    if (propIndex == index->second.propIndices.end()) {
+    auto propIndex = edgeIndex->propIndices.find(prop);
+    if (propIndex == edgeIndex->propIndices.end()) {
         VLOG(1) << "No edge prop found: " << prop;
         return Value::kEmpty;
     }
@@ -264,33 +290,128 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge,
     return list->values[propIndex->second];
 }
 
-Value GetNeighborsIter::getVertex() const {
+std::vector<int64_t> GetNeighborsIter::columnPositions(const std::string& col) const {
+    std::vector<int64_t> positions;
+    positions.reserve(dsIndices_.size());
+    for (auto& dsIndex : dsIndices_) {
+        auto& colIndices = dsIndex.layout->colIndices;
+        auto found = colIndices.find(col);
+        positions.emplace_back(
+            found == colIndices.end() ? -1 : static_cast<int64_t>(found->second));
+    }
+    return positions;
+}
+
+const Value& GetNeighborsIter::getColumnAt(const std::vector<int64_t>& positions) const {
     if (!valid()) {
         return Value::kNullValue;
     }
+    auto index = positions[currentSeg()];
+    if (index < 0) {
+        return Value::kEmpty;
+    }
+    DCHECK_EQ(iter_->segments_.size(), 1);
+    return iter_->segments_[0]->values[index];
+}
+
+std::vector<std::pair<int64_t, int64_t>> GetNeighborsIter::tagPropPositions(
+    const std::string& tag,
+    const std::string& prop) const {
+    std::vector<std::pair<int64_t, int64_t>> positions;
+    positions.reserve(dsIndices_.size());
+    for (auto& dsIndex : dsIndices_) {
+        auto& layout = *dsIndex.layout;
+        std::pair<int64_t, int64_t> pos{-1, -1};
+        auto index = layout.tagIndices.find(tag);
+        if (index != layout.tagIndices.end()) {
+            auto& tagProp = layout.tagProps[index->second];
+            auto propIndex = tagProp.propIndices.find(prop);
+            if (propIndex != tagProp.propIndices.end()) {
+                pos = {static_cast<int64_t>(tagProp.colIdx),
+                       static_cast<int64_t>(propIndex->second)};
+            }
+        }
+        positions.emplace_back(pos);
+    }
+    return positions;
+}
 
-    auto segment = currentSeg();
-    auto vidVal = getColumn(nebula::kVid);
-    if (!SchemaUtil::isValidVid(vidVal)) {
+const Value& GetNeighborsIter::getTagPropAt(
+    const std::vector<std::pair<int64_t, int64_t>>& positions) const {
+    if (!valid()) {
+        return Value::kNullValue;
+    }
+    auto& pos = positions[currentSeg()];
+    if (pos.first < 0) {
+        return Value::kEmpty;
+    }
+    DCHECK_EQ(iter_->segments_.size(), 1);
+    auto& row = *(iter_->segments_[0]);
+    DCHECK_GT(row.size(), static_cast<size_t>(pos.first));
+    if (!row[pos.first].isList()) {
         return Value::kNullBadType;
     }
+    return row[pos.first].getList().values[pos.second];
+}
+
+std::vector<std::vector<int64_t>> GetNeighborsIter::edgePropPositions(
+    const std::string& edge,
+    const std::string& prop) const {
+    std::vector<std::vector<int64_t>> positions;
+    positions.reserve(dsIndices_.size());
+    for (auto& dsIndex : dsIndices_) {
+        auto& edgeProps = dsIndex.layout->edgeProps;
+        std::vector<int64_t> pos(edgeProps.size(), -1);
+        for (size_t i = 0; i < edgeProps.size(); ++i) {
+            if (edgeProps[i].name.compare(1, std::string::npos, edge) != 0) {
+                continue;
+            }
+            auto found = edgeProps[i].propIndices.find(prop);
+            if (found != edgeProps[i].propIndices.end()) {
+                pos[i] = static_cast<int64_t>(found->second);
+            }
+        }
+        positions.emplace_back(std::move(pos));
+    }
+    return positions;
+}
+
+const Value& GetNeighborsIter::getEdgePropAt(
+    const std::vector<std::vector<int64_t>>& positions) const {
+    if (!valid()) {
+        return Value::kNullValue;
+    }
+    auto edgeIdx = iter_->edgeIdx_;
+    if (edgeIdx < 0) {
+        return Value::kEmpty;
+    }
+    auto index = positions[currentSeg()][edgeIdx];
+    if (index < 0) {
+        return Value::kEmpty;
+    }
+    return currentEdgeProps()->values[index];
+}
+
+Value GetNeighborsIter::makeVertex(const Value& vid,
+                                   const Row& row,
+                                   const ColumnLayout& layout,
+                                   bool* existTag) const {
+    *existTag = false;
     Vertex vertex;
-    vertex.vid = vidVal;
-    auto& tagPropMap = dsIndices_[segment].tagPropsMap;
-    for (auto& tagProp : tagPropMap) {
-        DCHECK_EQ(iter_->segments_.size(), 1);
-        auto& row = *(iter_->segments_[0]);
-        auto& tagPropNameList = tagProp.second.propList;
-        auto tagColId = tagProp.second.colIdx;
+    vertex.vid = vid;
+    for (auto& tagProp : layout.tagProps) {
+        auto& tagPropNameList = tagProp.propList;
+        auto tagColId = tagProp.colIdx;
+        DCHECK_GT(row.size(), tagColId);
         if (!row[tagColId].isList()) {
             // Ignore the bad value.
             continue;
         }
-        DCHECK_GE(row.size(), tagColId);
         auto& propList = row[tagColId].getList();
         DCHECK_EQ(tagPropNameList.size(), propList.values.size());
+        *existTag = true;
         Tag tag;
-        tag.name = tagProp.first;
+        tag.name = tagProp.name;
         for (size_t i = 0; i < propList.size(); ++i) {
             tag.props.emplace(tagPropNameList[i], propList[i]);
         }
@@ -299,50 +420,43 @@ Value GetNeighborsIter::getVertex() const {
     return Value(std::move(vertex));
 }
 
+Value GetNeighborsIter::getVertex() const {
+    if (!valid()) {
+        return Value::kNullValue;
+    }
+
+    auto vidVal = getColumn(nebula::kVid);
+    if (!SchemaUtil::isValidVid(vidVal)) {
+        return Value::kNullBadType;
+    }
+    DCHECK_EQ(iter_->segments_.size(), 1);
+    bool existTag = false;
+    return makeVertex(vidVal, *(iter_->segments_[0]), currentLayout(), &existTag);
+}
+
 Value GetNeighborsIter::getNoEdgeVertex() const {
     if (!noEdgeValid()) {
         return Value::kNullValue;
     }
 
-    auto& index = dsIndices_[0].colIndices;
-    auto found = index.find(nebula::kVid);
-    if (found == index.end()) {
+    auto& layout = *dsIndices_[noEdgeIter_->dsIdx_].layout;
+    auto found = layout.colIndices.find(nebula::kVid);
+    if (found == layout.colIndices.end()) {
         return Value::kNullBadType;
     }
     DCHECK_EQ(noEdgeIter_->segments_.size(), 1);
-    auto vidVal = noEdgeIter_->segments_[0]->values[found->second];
+    auto& row = *(noEdgeIter_->segments_[0]);
+    auto& vidVal = row.values[found->second];
     if (!SchemaUtil::isValidVid(vidVal)) {
         return Value::kNullBadType;
     }
-    Vertex vertex;
-    vertex.vid = vidVal;
-    auto& tagPropMap = dsIndices_[0].tagPropsMap;
     bool existTag = false;
-    for (auto& tagProp : tagPropMap) {
-        DCHECK_EQ(noEdgeIter_->segments_.size(), 1);
-        auto& row = *(noEdgeIter_->segments_[0]);
-        auto& tagPropNameList = tagProp.second.propList;
-        auto tagColId = tagProp.second.colIdx;
-        if (!row[tagColId].isList()) {
-            // Ignore the bad value.
-            continue;
-        }
-        DCHECK_GE(row.size(), tagColId);
-        auto& propList = row[tagColId].getList();
-        DCHECK_EQ(tagPropNameList.size(), propList.values.size());
-        existTag = true;
-        Tag tag;
-        tag.name = tagProp.first;
-        for (size_t i = 0; i < propList.size(); ++i) {
-            tag.props.emplace(tagPropNameList[i], propList[i]);
-        }
-        vertex.tags.emplace_back(std::move(tag));
-    }
+    auto vertex = makeVertex(vidVal, row, layout, &existTag);
     if (UNLIKELY(!existTag)) {
         // no exist vertex
         return Value::kNullBadType;
     }
-    return Value(std::move(vertex));
+    return vertex;
 }
 
 List GetNeighborsIter::getVertices() {
@@ -369,9 +483,12 @@ Value GetNeighborsIter::getEdge() const {
         return Value::kNullValue;
     }
 
-    auto segment = currentSeg();
+    auto* edgeIndex = currentEdgeIndex();
+    if (edgeIndex == nullptr) {
+        return Value::kNullValue;
+    }
     Edge edge;
-    auto edgeName = currentEdgeName().substr(1, std::string::npos);
+    auto edgeName = edgeIndex->name.substr(1, std::string::npos);
     edge.name = edgeName;
 
     auto type = getEdgeProp(edgeName, kType);
@@ -398,21 +515,16 @@ Value GetNeighborsIter::getEdge() const {
     }
     edge.ranking = rank.getInt();
 
-    auto& edgePropMap = dsIndices_[segment].edgePropsMap;
-    auto edgeProp = edgePropMap.find(currentEdgeName());
-    if (edgeProp == edgePropMap.end()) {
-        return Value::kNullValue;
-    }
-    auto& edgeNamePropList = edgeProp->second.propList;
+    auto& edgeNamePropList = edgeIndex->propList;
     auto& propList = currentEdgeProps()->values;
     DCHECK_EQ(edgeNamePropList.size(), propList.size());
     for (size_t i = 0; i < propList.size(); ++i) {
-        auto propName = edgeNamePropList[i];
+        auto& propName = edgeNamePropList[i];
         if (propName == kSrc || propName == kDst
                 || propName == kRank || propName == kType) {
             continue;
         }
-        edge.props.emplace(edgeNamePropList[i], propList[i]);
+        edge.props.emplace(propName, propList[i]);
     }
     return Value(std::move(edge));
 }
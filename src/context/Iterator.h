@@ -309,6 +309,25 @@ public:
     const Value& getEdgeProp(const std::string& edge,
                              const std::string& prop) const override;
 
+    // The positions of the column in each dataset, -1 if absent. They are resolved once
+    // to read the column of the current row without looking up its name.
+    std::vector<int64_t> columnPositions(const std::string& col) const;
+
+    const Value& getColumnAt(const std::vector<int64_t>& positions) const;
+
+    // The {column index, property index} of tag property in each dataset, -1 if absent
+    std::vector<std::pair<int64_t, int64_t>> tagPropPositions(const std::string& tag,
+                                                              const std::string& prop) const;
+
+    const Value& getTagPropAt(const std::vector<std::pair<int64_t, int64_t>>& positions) const;
+
+    // The property indices of `edge' in each dataset, indexed by the edge columns of the
+    // dataset, -1 if the edge column isn't `edge' or hasn't `prop'
+    std::vector<std::vector<int64_t>> edgePropPositions(const std::string& edge,
+                                                        const std::string& prop) const;
+
+    const Value& getEdgePropAt(const std::vector<std::vector<int64_t>>& positions) const;
+
     Value getVertex() const override;
 
     Value getNoEdgeVertex() const;
@@ -335,40 +354,60 @@ private:
         return iter_->dsIdx_;
     }
 
-    inline const std::string& currentEdgeName() const {
-        return iter_->edgeName_;
-    }
-
-    inline const List* currentEdgeProps() const {
-        return iter_->edgeProps_;
-    }
-
     struct PropIndex {
+        // The tag name, or the edge name with the +/- direction
+        std::string name;
         size_t colIdx;
         std::vector<std::string> propList;
         std::unordered_map<std::string, size_t> propIndices;
     };
 
-    struct DataSetIndex {
-        const DataSet* ds;
+    // The layout parsed from the column names of a dataset. The datasets with the same
+    // column names, e.g. the responses of each storage host, share one layout.
+    struct ColumnLayout {
+        std::vector<std::string> colNames;
         // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
         // -> {_vid : 0, _stats : 1, _tag:t1:p1:p2 : 2, _edge:d1:p1:p2 : 3}
         std::unordered_map<std::string, size_t> colIndices;
-        // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
-        // -> {2 : t1, 3 : e1}
-        std::unordered_map<size_t, std::string> tagEdgeNameIndices;
-        // _tag:t1:p1:p2  ->  {t1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
-        std::unordered_map<std::string, PropIndex> tagPropsMap;
-        // _edge:e1:p1:p2  ->  {e1 : [column_idx, [p1, p2], {p1 : 0, p2 : 1}]}
-        std::unordered_map<std::string, PropIndex> edgePropsMap;
+        // _tag:t1:p1:p2  ->  [t1, column_idx, [p1, p2], {p1 : 0, p2 : 1}]
+        std::vector<PropIndex> tagProps;
+        // t1 -> index in tagProps
+        std::unordered_map<std::string, size_t> tagIndices;
+        // _edge:+e1:p1:p2  ->  [+e1, column_idx, [p1, p2], {p1 : 0, p2 : 1}]
+        std::vector<PropIndex> edgeProps;
+        // +e1 -> index in edgeProps
+        std::unordered_map<std::string, size_t> edgeIndices;
+        // The column of the first edge, -1 if there is no edge
+        int64_t edgeStartIndex{-1};
+    };
+
+    struct DataSetIndex {
+        const DataSet* ds;
+        std::shared_ptr<const ColumnLayout> layout;
     };
 
+    inline const ColumnLayout& currentLayout() const {
+        return *dsIndices_[iter_->dsIdx_].layout;
+    }
+
+    // nullptr if the current row has no edge
+    inline const PropIndex* currentEdgeIndex() const {
+        if (iter_->edgeIdx_ < 0) {
+            return nullptr;
+        }
+        return &currentLayout().edgeProps[iter_->edgeIdx_];
+    }
+
+    inline const List* currentEdgeProps() const {
+        return iter_->edgeProps_;
+    }
+
     class GetNbrLogicalRow final : public LogicalRow {
     public:
-        GetNbrLogicalRow(size_t dsIdx, const Row* row, std::string edgeName, const List* edgeProps)
+        GetNbrLogicalRow(uint32_t dsIdx, const Row* row, int32_t edgeIdx, const List* edgeProps)
             : LogicalRow({row}),
               dsIdx_(dsIdx),
-              edgeName_(std::move(edgeName)),
+              edgeIdx_(edgeIdx),
               edgeProps_(edgeProps) {}
 
         GetNbrLogicalRow(const GetNbrLogicalRow &) = default;
@@ -383,7 +422,8 @@ private:
 
             segments_ = std::move(r.segments_);
 
-            edgeName_ = std::move(r.edgeName_);
+            edgeIdx_ = r.edgeIdx_;
+            r.edgeIdx_ = -1;
 
             edgeProps_ = r.edgeProps_;
             r.edgeProps_ = nullptr;
@@ -415,21 +455,31 @@ private:
 
     private:
         friend class GetNeighborsIter;
-        size_t dsIdx_;
-        std::string edgeName_;
+        uint32_t dsIdx_;
+        // Index in the edgeProps of the layout, -1 if no edge
+        int32_t edgeIdx_;
         const List* edgeProps_;
     };
 
-    StatusOr<int64_t> buildIndex(DataSetIndex* dsIndex);
+    StatusOr<std::shared_ptr<const ColumnLayout>> makeLayout(
+        const std::vector<std::string>& colNames);
     Status buildPropIndex(const std::string& props,
                           size_t columnId,
                           bool isEdge,
-                          DataSetIndex* dsIndex);
+                          ColumnLayout* layout);
     Status processList(std::shared_ptr<Value> value);
-    StatusOr<DataSetIndex> makeDataSetIndex(const DataSet& ds, size_t idx);
-    void makeLogicalRowByEdge(int64_t edgeStartIndex, size_t idx, const DataSetIndex& dsIndex);
+    DataSetIndex makeDataSetIndex(const DataSet& ds,
+                                  size_t idx,
+                                  std::shared_ptr<const ColumnLayout> layout);
+    void makeLogicalRowByEdge(size_t idx, const DataSetIndex& dsIndex);
+    // Return the vertex with the tags in `row', `existTag' is false if there is no tag
+    Value makeVertex(const Value& vid,
+                     const Row& row,
+                     const ColumnLayout& layout,
+                     bool* existTag) const;
 
     FRIEND_TEST(IteratorTest, TestHead);
+    FRIEND_TEST(IteratorTest, SharedLayout);
 
     bool                       valid_{false};
     RowsType<GetNbrLogicalRow> logicalRows_;
@@ -703,6 +753,18 @@ public:
         iter_ = rows_.begin();
     }
 
+    void addRows(RowsType<JoinLogicalRow>&& rows) {
+        rows_.insert(rows_.end(),
+                     std::make_move_iterator(rows.begin()),
+                     std::make_move_iterator(rows.end()));
+        iter_ = rows_.begin();
+    }
+
+    void reserve(size_t n) {
+        rows_.reserve(n);
+        iter_ = rows_.begin();
+    }
+
     std::unique_ptr<Iterator> copy() const override {
         auto copy = std::make_unique<JoinIter>(*this);
         copy->reset();
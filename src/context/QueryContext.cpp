@@ -37,6 +37,12 @@ void QueryContext::init() {
     idGen_ = std::make_unique<IdGenerator>(0);
     symTable_ = std::make_unique<SymbolTable>(objPool_.get());
     vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
+    auto parentTracker = MemoryTracker::root();
+    if (rctx_ != nullptr && rctx_->session() != nullptr &&
+        rctx_->session()->memTracker() != nullptr) {
+        parentTracker = rctx_->session()->memTracker();
+    }
+    memTracker_ = std::make_shared<MemoryTracker>(std::move(parentTracker));
 }
 
 void QueryContext::addProfilingData(int64_t planNodeId, ProfilingStats&& profilingStats) {
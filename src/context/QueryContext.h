@@ -20,6 +20,10 @@
 #include "parser/SequentialSentences.h"
 #include "service/RequestContext.h"
 #include "util/IdGenerator.h"
+#include "util/MemoryTracker.h"
+#include "util/RowCache.h"
+#include "util/SingleFlight.h"
+#include "util/StatsCache.h"
 #include "common/base/ObjectPool.h"
 #include "context/Symbols.h"
 
@@ -31,6 +35,17 @@ class ProfilingStats;
 class PlanDescription;
 }   // namespace cpp2
 
+// The priority class of query, the tasks of interactive queries are run before the ones of
+// batch queries, see `QueryRunners'
+enum class QueryPriority : uint8_t {
+    kInteractive,
+    kBatch,
+};
+
+// The state and value of a storage request, shared by the identical ones in flight
+using StorageResult = StatusOr<std::pair<Result::State, Value>>;
+using StorageFlight = SingleFlight<StorageResult>;
+
 /***************************************************************************
  *
  * The context for each query request
@@ -82,6 +97,22 @@ public:
         charsetInfo_ = charsetInfo;
     }
 
+    void setVertexCache(RowCache* vertexCache) {
+        vertexCache_ = vertexCache;
+    }
+
+    void setNeighborCache(RowCache* neighborCache) {
+        neighborCache_ = neighborCache;
+    }
+
+    void setStorageFlight(StorageFlight* storageFlight) {
+        storageFlight_ = storageFlight;
+    }
+
+    void setStatsCache(StatsCache* statsCache) {
+        statsCache_ = statsCache;
+    }
+
     RequestContext<ExecutionResponse>* rctx() const {
         return rctx_.get();
     }
@@ -102,6 +133,11 @@ public:
         ep_ = std::move(plan);
     }
 
+    // Drop the results of execution, e.g. when the plan is kept for the later queries
+    void resetExecution() {
+        ectx_ = std::make_unique<ExecutionContext>();
+    }
+
     meta::SchemaManager* schemaMng() const {
         return sm_;
     }
@@ -122,6 +158,26 @@ public:
         return charsetInfo_;
     }
 
+    // The rows of vertex props fetched by GetVertices, nullptr if not cached
+    RowCache* vertexCache() const {
+        return vertexCache_;
+    }
+
+    // The rows of neighbors fetched by GetNeighbors, nullptr if not cached
+    RowCache* neighborCache() const {
+        return neighborCache_;
+    }
+
+    // The storage requests in flight of all queries, nullptr if they are not coalesced
+    StorageFlight* storageFlight() const {
+        return storageFlight_;
+    }
+
+    // The counts of vertices and edges to estimate plans by, nullptr if not used
+    StatsCache* statsCache() const {
+        return statsCache_;
+    }
+
     ObjectPool* objPool() const {
         return objPool_.get();
     }
@@ -146,6 +202,20 @@ public:
         return symTable_.get();
     }
 
+    // Account the memory held by the results of this query, its parent is the tracker of
+    // the session, see `MemoryTracker'
+    const std::shared_ptr<MemoryTracker>& memTracker() const {
+        return memTracker_;
+    }
+
+    QueryPriority priority() const {
+        return priority_;
+    }
+
+    void setPriority(QueryPriority priority) {
+        priority_ = priority;
+    }
+
 private:
     void init();
 
@@ -158,6 +228,10 @@ private:
     storage::GraphStorageClient*                            storageClient_{nullptr};
     meta::MetaClient*                                       metaClient_{nullptr};
     CharsetInfo*                                            charsetInfo_{nullptr};
+    RowCache*                                               vertexCache_{nullptr};
+    RowCache*                                               neighborCache_{nullptr};
+    StorageFlight*                                          storageFlight_{nullptr};
+    StatsCache*                                             statsCache_{nullptr};
 
     // The Object Pool holds all internal generated objects.
     // e.g. expressions, plan nodes, executors
@@ -167,6 +241,8 @@ private:
     std::unique_ptr<PlanDescription>                        planDescription_;
     std::unique_ptr<IdGenerator>                            idGen_;
     std::unique_ptr<SymbolTable>                            symTable_;
+    std::shared_ptr<MemoryTracker>                          memTracker_;
+    QueryPriority                                           priority_{QueryPriority::kInteractive};
 };
 
 }   // namespace graph
@@ -11,11 +11,13 @@
 #include <vector>
 
 #include "context/Iterator.h"
+#include "util/MemoryTracker.h"
 
 namespace nebula {
 namespace graph {
 
 class ExecutionContext;
+class Executor;
 class ResultBuilder;
 
 // An executor will produce a result.
@@ -53,6 +55,7 @@ public:
 private:
     friend class ResultBuilder;
     friend class ExecutionContext;
+    friend class Executor;
 
     Value&& moveValue() {
         return std::move(*core_.value);
@@ -63,6 +66,9 @@ private:
         std::string msg;
         std::shared_ptr<Value> value;
         std::unique_ptr<Iterator> iter;
+        // The bytes of value accounted in the tracker of the executor producing it, shared
+        // by the results of the same value and released when all of them are dropped
+        std::shared_ptr<MemoryReservation> reservation;
     };
 
     explicit Result(Core&& core) : core_(std::move(core)) {}
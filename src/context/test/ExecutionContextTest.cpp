@@ -60,5 +60,36 @@ TEST(ExecutionContextTest, TestResult) {
     EXPECT_TRUE(result.valuePtr()->isDataSet());
 }
 
+TEST(ExecutionContextTest, AccountResult) {
+    auto tracker = std::make_shared<MemoryTracker>(nullptr);
+    auto build = [](std::shared_ptr<Value> value) {
+        return ResultBuilder().value(std::move(value)).iter(Iterator::Kind::kDefault).finish();
+    };
+    ExecutionContext ctx;
+    auto value = std::make_shared<Value>(std::string(1024, 'a'));
+    EXPECT_TRUE(ctx.setResult("v1", build(value), tracker));
+    auto bytes = tracker->current();
+    EXPECT_GT(bytes, 1024);
+
+    // The value forwarded to another variable is accounted only once
+    EXPECT_TRUE(ctx.setResult("v2", build(value), tracker));
+    EXPECT_TRUE(ctx.setResult("v2", build(value), tracker));
+    EXPECT_EQ(tracker->current(), bytes);
+
+    // A new value is accounted until all the results of it are dropped
+    EXPECT_TRUE(ctx.setResult("v2", build(std::make_shared<Value>(1)), tracker));
+    EXPECT_GT(tracker->current(), bytes);
+    ctx.truncHistory("v2", 1);
+    EXPECT_GT(tracker->current(), bytes);
+    ctx.deleteValue("v2");
+    EXPECT_EQ(tracker->current(), bytes);
+    ctx.deleteValue("v1");
+    EXPECT_EQ(tracker->current(), 0);
+    EXPECT_GT(tracker->peak(), bytes);
+
+    tracker->setLimit(1);
+    EXPECT_FALSE(ctx.setResult("v1", build(value), tracker));
+}
+
 }   // namespace graph
 }   // namespace nebula
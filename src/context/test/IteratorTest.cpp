@@ -623,6 +623,88 @@ TEST(IteratorTest, TestHead) {
     }
 }
 
+TEST(IteratorTest, SharedLayout) {
+    std::vector<std::string> colNames = {kVid,
+                                         "_stats",
+                                         "_tag:tag1:prop1:prop2",
+                                         "_edge:+edge1:prop1:_dst:_type:_rank",
+                                         "_edge:-edge2:prop1:_dst:_type:_rank",
+                                         "_expr"};
+    auto makeEdge = [](int64_t prop1, const std::string& dst) {
+        List edge;
+        edge.values.emplace_back(prop1);
+        edge.values.emplace_back(dst);
+        edge.values.emplace_back(1);
+        edge.values.emplace_back(0);
+        return edge;
+    };
+    auto makeDataSet = [&makeEdge](const std::vector<std::string>& names,
+                                   const std::string& vid) {
+        DataSet ds;
+        ds.colNames = names;
+        Row row;
+        row.values.emplace_back(vid);
+        row.values.emplace_back(Value());
+        List tag;
+        tag.values.emplace_back(0);
+        tag.values.emplace_back(1);
+        row.values.emplace_back(std::move(tag));
+        List edges1;
+        edges1.values.emplace_back(makeEdge(10, "a"));
+        row.values.emplace_back(std::move(edges1));
+        List edges2;
+        edges2.values.emplace_back(makeEdge(20, "b"));
+        edges2.values.emplace_back(makeEdge(21, "c"));
+        row.values.emplace_back(std::move(edges2));
+        row.values.emplace_back(Value());
+        ds.rows.emplace_back(std::move(row));
+        return ds;
+    };
+    List datasets;
+    datasets.values.emplace_back(makeDataSet(colNames, "v0"));
+    datasets.values.emplace_back(makeDataSet(colNames, "v1"));
+    auto otherNames = colNames;
+    otherNames[2] = "_tag:tag2:prop1:prop2";
+    datasets.values.emplace_back(makeDataSet(otherNames, "v2"));
+    auto val = std::make_shared<Value>(std::move(datasets));
+
+    GetNeighborsIter iter(val);
+    ASSERT_TRUE(iter.valid_);
+    ASSERT_EQ(iter.dsIndices_.size(), 3);
+    // The responses with the same column names share the layout
+    EXPECT_EQ(iter.dsIndices_[0].layout, iter.dsIndices_[1].layout);
+    EXPECT_NE(iter.dsIndices_[0].layout, iter.dsIndices_[2].layout);
+    EXPECT_EQ(iter.size(), 9);
+
+    std::vector<Value> vids, edge1Props, edge2Props, anyEdgeProps, tag1Props, tag2Props;
+    for (; iter.valid(); iter.next()) {
+        vids.emplace_back(iter.getColumn(kVid));
+        edge1Props.emplace_back(iter.getEdgeProp("edge1", "prop1"));
+        edge2Props.emplace_back(iter.getEdgeProp("edge2", "prop1"));
+        anyEdgeProps.emplace_back(iter.getEdgeProp("*", kDst));
+        tag1Props.emplace_back(iter.getTagProp("tag1", "prop2"));
+        tag2Props.emplace_back(iter.getTagProp("tag2", "prop2"));
+    }
+    std::vector<Value> expected = {"v0", "v0", "v0", "v1", "v1", "v1", "v2", "v2", "v2"};
+    EXPECT_EQ(expected, vids);
+    expected = {10, Value(), Value(), 10, Value(), Value(), 10, Value(), Value()};
+    EXPECT_EQ(expected, edge1Props);
+    expected = {Value(), 20, 21, Value(), 20, 21, Value(), 20, 21};
+    EXPECT_EQ(expected, edge2Props);
+    expected = {"a", "b", "c", "a", "b", "c", "a", "b", "c"};
+    EXPECT_EQ(expected, anyEdgeProps);
+    expected = {1, 1, 1, 1, 1, 1, Value(), Value(), Value()};
+    EXPECT_EQ(expected, tag1Props);
+    expected = {Value(), Value(), Value(), Value(), Value(), Value(), 1, 1, 1};
+    EXPECT_EQ(expected, tag2Props);
+
+    // The copies share the layouts too
+    auto copy = iter.copy();
+    auto* gnCopy = static_cast<GetNeighborsIter*>(copy.get());
+    EXPECT_EQ(iter.dsIndices_[0].layout, gnCopy->dsIndices_[0].layout);
+    EXPECT_EQ(gnCopy->getEdge().getEdge().name, "edge1");
+}
+
 TEST(IteratorTest, EraseRange) {
     // Sequential iterator
     {
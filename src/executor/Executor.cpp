@@ -45,7 +45,6 @@
 #include "executor/admin/DownloadExecutor.h"
 #include "executor/admin/IngestExecutor.h"
 #include "executor/algo/BFSShortestPathExecutor.h"
-#include "executor/algo/ProduceSemiShortestPathExecutor.h"
 #include "executor/algo/ConjunctPathExecutor.h"
 #include "executor/algo/ProduceAllPathsExecutor.h"
 #include "executor/algo/CartesianProductExecutor.h"
@@ -85,6 +84,7 @@
 #include "planner/PlanNode.h"
 #include "planner/Query.h"
 #include "common/base/ObjectPool.h"
+#include "service/GraphFlags.h"
 #include "util/ScopedTimer.h"
 
 using folly::stringPrintf;
@@ -406,9 +406,6 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
         case PlanNode::Kind::kBFSShortest: {
             return pool->add(new BFSShortestPathExecutor(node, qctx));
         }
-        case PlanNode::Kind::kProduceSemiShortestPath: {
-            return pool->add(new ProduceSemiShortestPathExecutor(node, qctx));
-        }
         case PlanNode::Kind::kConjunctPath: {
             return pool->add(new ConjunctPathExecutor(node, qctx));
         }
@@ -494,7 +491,8 @@ Executor::Executor(const std::string &name, const PlanNode *node, QueryContext *
       name_(name),
       node_(DCHECK_NOTNULL(node)),
       qctx_(DCHECK_NOTNULL(qctx)),
-      ectx_(DCHECK_NOTNULL(qctx->ectx())) {
+      ectx_(DCHECK_NOTNULL(qctx->ectx())),
+      memTracker_(std::make_shared<MemoryTracker>(qctx->memTracker())) {
     // Initialize the position in ExecutionContext for each executor before execution plan
     // starting to run. This will avoid lock something for thread safety in real execution
     if (!ectx_->exist(node->outputVar())) {
@@ -508,6 +506,8 @@ Status Executor::open() {
     numRows_ = 0;
     execTime_ = 0;
     totalDuration_.reset();
+    memTracker_->resetPeak();
+    trackMemory_ = qctx_->planDescription() != nullptr || memTracker_->limited();
     return Status::OK();
 }
 
@@ -516,6 +516,12 @@ Status Executor::close() {
     stats.totalDurationInUs = totalDuration_.elapsedInUSec();
     stats.rows = numRows_;
     stats.execDurationInUs = execTime_;
+    if (trackMemory_) {
+        if (otherStats_ == nullptr) {
+            otherStats_ = std::make_unique<std::unordered_map<std::string, std::string>>();
+        }
+        otherStats_->emplace("peak_memory_bytes", folly::to<std::string>(memTracker_->peak()));
+    }
     stats.otherStats = std::move(otherStats_);
     qctx()->addProfilingData(node_->id(), std::move(stats));
     return Status::OK();
@@ -531,10 +537,34 @@ folly::Future<Status> Executor::error(Status status) const {
 
 Status Executor::finish(Result &&result) {
     numRows_ = result.size();
-    ectx_->setResult(node()->outputVar(), std::move(result));
+    if (!trackMemory_) {
+        ectx_->setResult(node()->outputVar(), std::move(result));
+        return Status::OK();
+    }
+    if (!ectx_->setResult(node()->outputVar(), std::move(result), memTracker_)) {
+        return memoryExceeded();
+    }
     return Status::OK();
 }
 
+StatusOr<MemoryReservation> Executor::reserveMemory(int64_t bytes) {
+    if (!trackMemory_ || bytes <= 0) {
+        return MemoryReservation();
+    }
+    auto ok = memTracker_->consume(bytes);
+    MemoryReservation reservation(memTracker_, bytes);
+    if (!ok) {
+        return memoryExceeded();
+    }
+    return reservation;
+}
+
+Status Executor::memoryExceeded() const {
+    return Status::Error("Query exceeds the memory limit %ld bytes in executor `%s'",
+                         qctx_->memTracker()->limit(),
+                         name_.c_str());
+}
+
 Status Executor::finish(Value &&value) {
     return finish(ResultBuilder().value(std::move(value)).iter(Iterator::Kind::kDefault).finish());
 }
@@ -547,5 +577,16 @@ folly::Executor *Executor::runner() const {
     return qctx()->rctx()->runner();
 }
 
+size_t Executor::getBatchSize(size_t totalSize) const {
+    size_t minBatchSize = std::max<size_t>(FLAGS_min_batch_size, 1);
+    size_t maxJobs = std::max<size_t>(FLAGS_max_job_size, 1);
+    // Don't split into more jobs than `max_job_size', and don't make the morsel too small
+    // to amortize the cost of dispatching it.
+    // The batch queries are split in the same way, their tasks yield to the ones of the
+    // interactive queries by the priority of the runner, see QueryRunners.
+    size_t batchSize = (totalSize + maxJobs - 1) / maxJobs;
+    return std::max(batchSize, minBatchSize);
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -7,6 +7,7 @@
 #ifndef EXECUTOR_EXECUTOR_H_
 #define EXECUTOR_EXECUTOR_H_
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -15,10 +16,12 @@
 #include <folly/futures/Future.h>
 
 #include "common/base/Status.h"
+#include "common/base/StatusOr.h"
 #include "common/cpp/helpers.h"
 #include "common/datatypes/Value.h"
 #include "common/time/Duration.h"
 #include "context/ExecutionContext.h"
+#include "util/MemoryTracker.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -84,6 +87,9 @@ public:
     folly::Future<Status> error(Status status) const;
 
 protected:
+    // Pipeline drives a chain of executors and fills their results and profiling data
+    friend class Pipeline;
+
     static Executor *makeExecutor(const PlanNode *node,
                                   QueryContext *qctx,
                                   std::unordered_map<int64_t, Executor *> *visited);
@@ -98,11 +104,34 @@ protected:
 
     folly::Executor *runner() const;
 
-    // Store the result of this executor to execution context
+    // Split the rows of `iter' into morsels and evaluate them by `scatter' concurrently
+    // in the worker pool, then hand all the morsel results in order to `gather'.
+    //   scatter: (size_t begin, size_t end, Iterator *iter) -> T, `iter' is positioned at `begin'
+    //   gather:  (std::vector<T> &&results) -> Status
+    // The morsel size is decided by `getBatchSize' unless `batchSize' is given.
+    template <typename ScatterFunc, typename GatherFunc>
+    folly::Future<Status> runMultiJobs(ScatterFunc &&scatter,
+                                       GatherFunc &&gather,
+                                       Iterator *iter,
+                                       size_t batchSize = 0);
+
+    // Number of rows of each morsel, see FLAGS_max_job_size and FLAGS_min_batch_size
+    size_t getBatchSize(size_t totalSize) const;
+
+    // Store the result of this executor to execution context. The memory of the result is
+    // accounted when profiling or the memory is limited, and the query is killed if it
+    // exceeds the limit.
     Status finish(Result &&result);
     // Store the default result which not used for later executor
     Status finish(Value &&value);
 
+    // Account the bytes of the working set of this executor, e.g. a hash table, in the same
+    // way as the results until the reservation is dropped. Return the error if the query
+    // exceeds the memory limit.
+    StatusOr<MemoryReservation> reserveMemory(int64_t bytes);
+
+    Status memoryExceeded() const;
+
     int64_t id_;
 
     // Executor name
@@ -124,8 +153,39 @@ protected:
     uint64_t execTime_{0};
     time::Duration totalDuration_;
     std::unique_ptr<std::unordered_map<std::string, std::string>> otherStats_;
+
+    // Account the memory of the results of this executor, child of the query tracker
+    std::shared_ptr<MemoryTracker> memTracker_;
+    bool trackMemory_{false};
 };
 
+template <typename ScatterFunc, typename GatherFunc>
+folly::Future<Status> Executor::runMultiJobs(ScatterFunc &&scatter,
+                                             GatherFunc &&gather,
+                                             Iterator *iter,
+                                             size_t batchSize) {
+    using ScatterResult = typename std::result_of<ScatterFunc(size_t, size_t, Iterator *)>::type;
+
+    size_t totalSize = iter->size();
+    if (batchSize == 0) {
+        batchSize = getBatchSize(totalSize);
+    }
+
+    std::vector<folly::Future<ScatterResult>> futures;
+    futures.reserve(totalSize / batchSize + 1);
+    for (size_t begin = 0; begin < totalSize; begin += batchSize) {
+        size_t end = std::min(begin + batchSize, totalSize);
+        // Each job works on its own copy of iterator since the iterator keeps the position
+        futures.emplace_back(
+            folly::via(runner(), [begin, end, tmpIter = iter->copy(), scatter]() mutable {
+                tmpIter->reset(begin);
+                return scatter(begin, end, tmpIter.get());
+            }));
+    }
+
+    return folly::collect(futures).via(runner()).then(std::forward<GatherFunc>(gather));
+}
+
 }   // namespace graph
 }   // namespace nebula
 
@@ -0,0 +1,494 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "executor/Pipeline.h"
+
+#include "context/QueryContext.h"
+#include "context/QueryExpressionContext.h"
+#include "executor/Executor.h"
+#include "executor/query/GetNeighborsExecutor.h"
+#include "executor/query/UnwindExecutor.h"
+#include "parser/Clauses.h"
+#include "planner/PlanNode.h"
+#include "planner/Query.h"
+#include "service/GraphFlags.h"
+#include "util/ScopedTimer.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// Flatten the values of all the segments of the current row of `iter'
+Row copyRow(const Iterator *iter) {
+    Row row;
+    for (auto *segment : iter->row()->segments()) {
+        row.values.insert(row.values.end(), segment->values.begin(), segment->values.end());
+    }
+    return row;
+}
+
+// One executor of the pipeline. Each stage consumes the rows of its upstream one by one and
+// pushes the rows it outputs to the next stage.
+class Stage {
+public:
+    virtual ~Stage() = default;
+
+    void setNext(Stage *next) {
+        next_ = next;
+    }
+
+    // Consume the current row of `iter'. Return false to stop feeding more rows, either no more
+    // rows are wanted (e.g. the limit is reached) or something is wrong, see `status()'.
+    virtual bool consume(Iterator *iter) = 0;
+
+    // Consume a row created by the upstream, only the sink takes rows in this way
+    virtual bool takesRows() const {
+        return false;
+    }
+
+    virtual bool consumeRow(Row &&) {
+        LOG(FATAL) << "Stage doesn't take rows";
+        return false;
+    }
+
+    // All the input rows have been consumed, push the rows kept in this stage downstream
+    virtual void flush() {
+        if (next_ != nullptr) {
+            next_->flush();
+        }
+    }
+
+    // The number of rows output by this stage
+    uint64_t numRows() const {
+        return numRows_;
+    }
+
+    const Status &status() const {
+        return status_;
+    }
+
+protected:
+    Stage *next_{nullptr};
+    uint64_t numRows_{0};
+    Status status_;
+};
+
+// The stage creating new rows, the rows are buffered and handed to the next stage in batches.
+class ProduceStage : public Stage {
+public:
+    explicit ProduceStage(const PlanNode *node)
+        : colNames_(node->colNames()), batchSize_(std::max<size_t>(FLAGS_pipeline_batch_size, 1)) {
+        buffer_.colNames = colNames_;
+    }
+
+    void flush() override {
+        drain();
+        Stage::flush();
+    }
+
+protected:
+    bool emit(Row &&row) {
+        ++numRows_;
+        if (next_->takesRows()) {
+            return next_->consumeRow(std::move(row));
+        }
+        buffer_.rows.emplace_back(std::move(row));
+        if (buffer_.rows.size() >= batchSize_) {
+            return drain();
+        }
+        return true;
+    }
+
+private:
+    bool drain() {
+        if (buffer_.rows.empty()) {
+            return true;
+        }
+        auto value = std::make_shared<Value>(std::move(buffer_));
+        buffer_ = DataSet();
+        buffer_.colNames = colNames_;
+        SequentialIter iter(value);
+        for (; iter.valid(); iter.next()) {
+            if (!next_->consume(&iter)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> colNames_;
+    size_t batchSize_;
+    DataSet buffer_;
+};
+
+class FilterStage final : public Stage {
+public:
+    FilterStage(const Filter *filter, ExecutionContext *ectx)
+        : condition_(filter->condition()->clone()), ctx_(ectx) {}
+
+    bool consume(Iterator *iter) override {
+        auto val = condition_->eval(ctx_(iter));
+        if (!val.empty() && !val.isBool() && !val.isNull()) {
+            status_ = Status::Error("Internal Error: Wrong type result, "
+                                    "the type should be NULL,EMPTY or BOOL");
+            return false;
+        }
+        if (val.empty() || val.isNull() || !val.getBool()) {
+            return true;
+        }
+        ++numRows_;
+        return next_->consume(iter);
+    }
+
+private:
+    std::unique_ptr<Expression> condition_;
+    QueryExpressionContext ctx_;
+};
+
+class ProjectStage final : public ProduceStage {
+public:
+    ProjectStage(const Project *project, ExecutionContext *ectx)
+        : ProduceStage(project), columns_(project->columns()->clone()), ctx_(ectx) {}
+
+    bool consume(Iterator *iter) override {
+        auto cols = columns_->columns();
+        Row row;
+        row.values.reserve(cols.size());
+        for (auto &col : cols) {
+            row.values.emplace_back(col->expr()->eval(ctx_(iter)));
+        }
+        return emit(std::move(row));
+    }
+
+private:
+    std::unique_ptr<YieldColumns> columns_;
+    QueryExpressionContext ctx_;
+};
+
+class UnwindStage final : public ProduceStage {
+public:
+    UnwindStage(const Unwind *unwind, ExecutionContext *ectx)
+        : ProduceStage(unwind), columns_(unwind->columns()->columns()), ctx_(ectx) {
+        DCHECK_GT(columns_.size(), 0);
+    }
+
+    bool consume(Iterator *iter) override {
+        Value list = columns_[0]->expr()->eval(ctx_(iter));
+        auto vals = UnwindExecutor::extractList(list);
+        for (auto &v : vals) {
+            Row row;
+            row.values.emplace_back(std::move(v));
+            for (size_t i = 1; i < columns_.size(); ++i) {
+                row.values.emplace_back(columns_[i]->expr()->eval(ctx_(iter)));
+            }
+            if (!emit(std::move(row))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<YieldColumn *> columns_;
+    QueryExpressionContext ctx_;
+};
+
+class LimitStage final : public Stage {
+public:
+    explicit LimitStage(const Limit *limit)
+        : offset_(std::max<int64_t>(limit->offset(), 0)),
+          count_(std::max<int64_t>(limit->count(), 0)) {}
+
+    bool consume(Iterator *iter) override {
+        if (skipped_ < offset_) {
+            ++skipped_;
+            return true;
+        }
+        if (numRows_ >= count_) {
+            return false;
+        }
+        ++numRows_;
+        // Stop the upstream as soon as enough rows are taken
+        return next_->consume(iter) && numRows_ < count_;
+    }
+
+private:
+    uint64_t offset_;
+    uint64_t count_;
+    uint64_t skipped_{0};
+};
+
+class DedupStage final : public Stage {
+public:
+    bool consume(Iterator *iter) override {
+        // Keep a copy since the rows of upstream batches are released after consumed
+        if (!unique_.emplace(key(iter)).second) {
+            return true;
+        }
+        ++numRows_;
+        return next_->consume(iter);
+    }
+
+private:
+    // The row of a GetNeighbors iterator is the whole row of the current vertex which is shared
+    // by all its edges, so the logical row is keyed on the vertex and the current edge instead.
+    static Row key(const Iterator *iter) {
+        if (iter->isGetNeighborsIter()) {
+            return Row({iter->getVertex(), iter->getEdge()});
+        }
+        return copyRow(iter);
+    }
+
+    std::unordered_set<Row> unique_;
+};
+
+// Collect the output rows of the last executor
+class SinkStage final : public Stage {
+public:
+    explicit SinkStage(const PlanNode *node) {
+        ds_.colNames = node->colNames();
+    }
+
+    bool consume(Iterator *iter) override {
+        ds_.rows.emplace_back(copyRow(iter));
+        return true;
+    }
+
+    bool takesRows() const override {
+        return true;
+    }
+
+    bool consumeRow(Row &&row) override {
+        ds_.rows.emplace_back(std::move(row));
+        return true;
+    }
+
+    DataSet moveDataSet() {
+        return std::move(ds_);
+    }
+
+private:
+    DataSet ds_;
+};
+
+std::unique_ptr<Stage> makeStage(const Executor *executor, ExecutionContext *ectx) {
+    auto *node = executor->node();
+    switch (node->kind()) {
+        case PlanNode::Kind::kFilter:
+            return std::make_unique<FilterStage>(Executor::asNode<Filter>(node), ectx);
+        case PlanNode::Kind::kProject:
+            return std::make_unique<ProjectStage>(Executor::asNode<Project>(node), ectx);
+        case PlanNode::Kind::kUnwind:
+            return std::make_unique<UnwindStage>(Executor::asNode<Unwind>(node), ectx);
+        case PlanNode::Kind::kLimit:
+            return std::make_unique<LimitStage>(Executor::asNode<Limit>(node));
+        case PlanNode::Kind::kDedup:
+            return std::make_unique<DedupStage>();
+        default:
+            LOG(FATAL) << "Executor " << executor->name() << " could not be pipelined";
+            return nullptr;
+    }
+}
+
+}   // namespace
+
+struct Pipeline::Stages {
+    std::vector<std::unique_ptr<Stage>> stages;
+    SinkStage *sink{nullptr};
+    // No more rows are wanted, e.g. the limit is reached
+    bool stopped{false};
+    // The rows output by the streaming head
+    uint64_t numStreamedRows{0};
+};
+
+Pipeline::Pipeline(std::vector<Executor *> executors) : executors_(std::move(executors)) {}
+
+Pipeline::~Pipeline() = default;
+
+// static
+bool Pipeline::pipelinable(const Executor *executor) {
+    switch (executor->node()->kind()) {
+        case PlanNode::Kind::kFilter:
+        case PlanNode::Kind::kProject:
+        case PlanNode::Kind::kUnwind:
+        case PlanNode::Kind::kLimit:
+        case PlanNode::Kind::kDedup:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// static
+bool Pipeline::streams(const Executor *executor) {
+    return executor->node()->kind() == PlanNode::Kind::kGetNeighbors &&
+           GetNeighborsExecutor::streaming();
+}
+
+// static
+bool Pipeline::producesRows(const Executor *executor) {
+    auto kind = executor->node()->kind();
+    return kind == PlanNode::Kind::kProject || kind == PlanNode::Kind::kUnwind;
+}
+
+// static
+std::unique_ptr<Pipeline> Pipeline::make(Executor *sink) {
+    if (!pipelinable(sink)) {
+        return nullptr;
+    }
+
+    std::vector<Executor *> executors{sink};
+    auto *current = sink;
+    while (current->depends().size() == 1) {
+        auto *dep = *current->depends().begin();
+        bool source = streams(dep);
+        if ((!pipelinable(dep) && !source) || dep->successors().size() != 1) {
+            break;
+        }
+        auto *input = static_cast<const SingleInputNode *>(current->node());
+        auto *output = dep->node()->outputVarPtr();
+        if (input->inputVar() != output->name) {
+            break;
+        }
+        // The intermediate result is never stored, so only the default output variable of
+        // plan node is allowed, which is read by nothing else than the successor
+        auto defaultVar = folly::stringPrintf(
+            "__%s_%ld", PlanNode::toString(dep->node()->kind()), dep->node()->id());
+        if (output->name != defaultVar || output->readBy.size() > 1) {
+            break;
+        }
+        executors.emplace_back(dep);
+        if (source) {
+            // Nothing is before the rows streamed
+            break;
+        }
+        current = dep;
+    }
+
+    // The output of sink is built as a dataset, it's only the same as the original result
+    // when some executor of the chain creates new rows.
+    if (executors.size() < 2 ||
+        std::none_of(executors.begin(), executors.end(), &Pipeline::producesRows)) {
+        return nullptr;
+    }
+    std::reverse(executors.begin(), executors.end());
+    return std::unique_ptr<Pipeline>(new Pipeline(std::move(executors)));
+}
+
+folly::Future<Status> Pipeline::execute() {
+    for (auto *executor : executors_) {
+        auto status = executor->open();
+        if (!status.ok()) {
+            return sink()->error(std::move(status));
+        }
+    }
+    auto future = streams(head()) ? runStream()
+                                  : folly::via(sink()->runner(), [this]() { return run(); });
+    return std::move(future).then([this](Status s) {
+        NG_RETURN_IF_ERROR(s);
+        for (auto *executor : executors_) {
+            NG_RETURN_IF_ERROR(executor->close());
+        }
+        return Status::OK();
+    });
+}
+
+void Pipeline::prepare() {
+    auto *ectx = sink()->ectx_;
+    stages_ = std::make_unique<Stages>();
+    auto &stages = stages_->stages;
+    stages.reserve(executors_.size() + 1);
+    for (auto *executor : executors_) {
+        if (!streams(executor)) {
+            stages.emplace_back(makeStage(executor, ectx));
+        }
+    }
+    auto sinkStage = std::make_unique<SinkStage>(sink()->node());
+    stages_->sink = sinkStage.get();
+    stages.emplace_back(std::move(sinkStage));
+    for (size_t i = 0; i + 1 < stages.size(); ++i) {
+        stages[i]->setNext(stages[i + 1].get());
+    }
+}
+
+Status Pipeline::feed(Iterator *iter) {
+    auto *first = stages_->stages.front().get();
+    for (; !stages_->stopped && iter->valid(); iter->next()) {
+        if (!first->consume(iter)) {
+            stages_->stopped = true;
+        }
+    }
+    for (auto &stage : stages_->stages) {
+        NG_RETURN_IF_ERROR(stage->status());
+    }
+    return Status::OK();
+}
+
+Status Pipeline::complete() {
+    auto &stages = stages_->stages;
+    stages.front()->flush();
+    // The stages of the executors after the streaming head
+    size_t offset = streams(head()) ? 1 : 0;
+    for (size_t i = 0; i < executors_.size(); ++i) {
+        auto *executor = executors_[i];
+        if (i < offset) {
+            executor->numRows_ = stages_->numStreamedRows;
+        } else {
+            NG_RETURN_IF_ERROR(stages[i - offset]->status());
+            executor->numRows_ = stages[i - offset]->numRows();
+        }
+        if (executor != sink()) {
+            if (executor->otherStats_ == nullptr) {
+                executor->otherStats_ =
+                    std::make_unique<std::unordered_map<std::string, std::string>>();
+            }
+            executor->otherStats_->emplace("pipelined_into",
+                                           folly::to<std::string>(sink()->id()));
+        }
+    }
+    return sink()->finish(ResultBuilder().value(Value(stages_->sink->moveDataSet())).finish());
+}
+
+Status Pipeline::run() {
+    SCOPED_TIMER(&sink()->execTime_);
+    auto *ectx = sink()->ectx_;
+    auto *input = static_cast<const SingleInputNode *>(head()->node());
+    auto iter = ectx->getResult(input->inputVar()).iter();
+    if (iter == nullptr) {
+        return Status::Error("Internal Error: iterator is nullptr");
+    }
+    if (!producesRows(head()) && iter->isDefaultIter()) {
+        return Status::Error("Internal Error: iterator is DefaultIter");
+    }
+
+    prepare();
+    NG_RETURN_IF_ERROR(feed(iter.get()));
+    return complete();
+}
+
+folly::Future<Status> Pipeline::runStream() {
+    prepare();
+    auto *source = static_cast<GetNeighborsExecutor *>(head());
+    // The parts are handed over one at a time, so the stages are never run concurrently
+    return source
+        ->stream([this](std::shared_ptr<Value> part) -> StatusOr<bool> {
+            SCOPED_TIMER(&sink()->execTime_);
+            GetNeighborsIter iter(std::move(part));
+            stages_->numStreamedRows += iter.size();
+            NG_RETURN_IF_ERROR(feed(&iter));
+            // Don't fetch the rest once the limit is reached
+            return !stages_->stopped;
+        })
+        .then([this](Status s) {
+            NG_RETURN_IF_ERROR(s);
+            SCOPED_TIMER(&sink()->execTime_);
+            return complete();
+        });
+}
+
+}   // namespace graph
+}   // namespace nebula
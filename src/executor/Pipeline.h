@@ -0,0 +1,102 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef EXECUTOR_PIPELINE_H_
+#define EXECUTOR_PIPELINE_H_
+
+#include <memory>
+#include <vector>
+
+#include <folly/futures/Future.h>
+
+#include "common/base/Status.h"
+#include "common/cpp/helpers.h"
+
+namespace nebula {
+namespace graph {
+
+class Executor;
+class Iterator;
+
+/***************************************************************************
+ *
+ * A chain of non-blocking executors (Filter, Project, Limit, Dedup and Unwind)
+ * run as one task. The rows of the input of the first executor flow through
+ * all of them in batches, only the output of the last executor is stored in
+ * the execution context. So the intermediate results are never materialized
+ * and the chain stops reading the input as soon as a Limit is satisfied.
+ *
+ * When GetNeighbors streams its response, it could be the head of the chain,
+ * then the rows of each batch of the response flow through the chain as soon
+ * as the batch arrives.
+ *
+ * The executors of the chain are opened and closed as usual, so each of them
+ * still reports its rows in profiling.
+ *
+ * The rows keep the order of the input of the chain, or the order the parts
+ * of the streaming head arrive in. It may differ from the order of the same
+ * chain materialized, e.g. Filter and Dedup erase rows unstably. As without
+ * the pipeline, the order of rows is undefined unless they are sorted.
+ *
+ **************************************************************************/
+class Pipeline final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    // Collect the longest chain ending at `sink', return nullptr if it could
+    // not or is not worth to be pipelined
+    static std::unique_ptr<Pipeline> make(Executor *sink);
+
+    ~Pipeline();
+
+    Executor *head() const {
+        return executors_.front();
+    }
+
+    Executor *sink() const {
+        return executors_.back();
+    }
+
+    // From the head to the sink
+    const std::vector<Executor *> &executors() const {
+        return executors_;
+    }
+
+    folly::Future<Status> execute();
+
+private:
+    struct Stages;
+
+    explicit Pipeline(std::vector<Executor *> executors);
+
+    static bool pipelinable(const Executor *executor);
+
+    // Whether `executor' streams the parts of its response to the chain
+    static bool streams(const Executor *executor);
+
+    // Whether `executor' outputs new rows rather than passing through the input rows
+    static bool producesRows(const Executor *executor);
+
+    // Create the stages of the executors after the streaming head if any
+    void prepare();
+
+    // Push the rows of `iter' through the stages
+    Status feed(Iterator *iter);
+
+    // Flush the rows kept in stages, and store the output of sink
+    Status complete();
+
+    Status run();
+
+    // Run the chain on the parts of the response of the streaming head
+    folly::Future<Status> runStream();
+
+    std::vector<Executor *> executors_;
+    std::unique_ptr<Stages> stages_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // EXECUTOR_PIPELINE_H_
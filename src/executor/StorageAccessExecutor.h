@@ -7,8 +7,12 @@
 #ifndef EXECUTOR_STORAGEACCESSEXECUTOR_H_
 #define EXECUTOR_STORAGEACCESSEXECUTOR_H_
 
+#include <folly/json.h>
+
 #include "executor/Executor.h"
 #include "common/clients/storage/StorageClientBase.h"
+#include "context/QueryContext.h"
+#include "util/ToJson.h"
 
 namespace nebula {
 namespace graph {
@@ -116,6 +120,63 @@ protected:
                 folly::stringPrintf("%d(us)/%d(us)", std::get<1>(info), std::get<2>(info)));
         }
     }
+
+    // Drop the cached props and neighbors of the vertex written
+    void evictVertex(GraphSpaceID space, const Value &vid) const {
+        if (qctx_->vertexCache() != nullptr) {
+            qctx_->vertexCache()->evict(space, vid);
+        }
+        if (qctx_->neighborCache() != nullptr) {
+            qctx_->neighborCache()->evict(space, vid);
+        }
+    }
+
+    // Drop the cached props of the vertices deleted. Their edges are deleted along, which are
+    // also the neighbors of the other ends unknown here, so the whole space of neighbors is
+    // dropped.
+    void evictDeletedVertices(GraphSpaceID space, const std::vector<Value> &vids) const {
+        if (qctx_->vertexCache() != nullptr) {
+            for (auto &vid : vids) {
+                qctx_->vertexCache()->evict(space, vid);
+            }
+        }
+        if (qctx_->neighborCache() != nullptr) {
+            qctx_->neighborCache()->evictSpace(space);
+        }
+    }
+
+    // Drop the cached neighbors of both ends of the edge written
+    void evictEdge(GraphSpaceID space, const Value &src, const Value &dst) const {
+        if (qctx_->neighborCache() != nullptr) {
+            qctx_->neighborCache()->evict(space, src);
+            qctx_->neighborCache()->evict(space, dst);
+        }
+    }
+
+    bool hasCache() const {
+        return qctx_->vertexCache() != nullptr || qctx_->neighborCache() != nullptr;
+    }
+
+    // The vertices requested regardless of their order, as a part of the key to coalesce
+    // the identical requests. All the sorted vertices are kept rather than a hash of them,
+    // so the requests of different vertices never share a response by a collision.
+    static std::string vidsKey(const std::vector<Row> &rows) {
+        std::vector<const Value *> vids;
+        vids.reserve(rows.size());
+        for (auto &row : rows) {
+            vids.emplace_back(&row.values.front());
+        }
+        std::sort(vids.begin(), vids.end(), [](const Value *lhs, const Value *rhs) {
+            return *lhs < *rhs;
+        });
+        std::string key = folly::to<std::string>(vids.size());
+        for (auto *vid : vids) {
+            // Prefixed by the type and length, so the boundaries are never ambiguous
+            auto str = vid->toString();
+            folly::toAppend(':', static_cast<int>(vid->type()), ':', str.size(), ':', str, &key);
+        }
+        return key;
+    }
 };
 
 }   // namespace graph
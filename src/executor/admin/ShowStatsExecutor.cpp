@@ -26,6 +26,9 @@ folly::Future<Status> ShowStatsExecutor::execute() {
                 return resp.status();
             }
             auto statisItem = std::move(resp).value();
+            if (qctx()->statsCache() != nullptr) {
+                qctx()->statsCache()->put(spaceId, statisItem);
+            }
 
             DataSet dataSet({"Type", "Name", "Count"});
             std::vector<std::pair<std::string, int64_t>> tagCount;
@@ -20,7 +20,8 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
 
     DataSet ds;
     ds.colNames = node()->colNames();
-    std::multimap<Value, Value> interim;
+    // The vertices reached by this step are only visited after it
+    std::vector<VidIndex::Id> dsts;
 
     for (; iter->valid(); iter->next()) {
         auto edgeVal = iter->getEdge();
@@ -28,24 +29,22 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
             continue;
         }
         auto& edge = edgeVal.getEdge();
-        auto visited = visited_.find(edge.dst) != visited_.end();
-        if (visited) {
+        auto dst = vids_.insert(edge.dst);
+        if (visited(dst)) {
             continue;
         }
 
         // save the starts.
-        visited_.emplace(edge.src);
+        visit(vids_.insert(edge.src));
         VLOG(1) << "dst: " << edge.dst << " edge: " << edge;
-        interim.emplace(edge.dst, std::move(edgeVal));
-    }
-    for (auto& kv : interim) {
-        auto dst = std::move(kv.first);
-        auto edge = std::move(kv.second);
         Row row;
-        row.values.emplace_back(dst);
-        row.values.emplace_back(std::move(edge));
+        row.values.emplace_back(edge.dst);
+        row.values.emplace_back(std::move(edgeVal));
         ds.rows.emplace_back(std::move(row));
-        visited_.emplace(dst);
+        dsts.emplace_back(dst);
+    }
+    for (auto dst : dsts) {
+        visit(dst);
     }
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
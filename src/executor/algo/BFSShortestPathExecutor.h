@@ -8,6 +8,7 @@
 #define EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/PathTree.h"
 
 namespace nebula {
 namespace graph {
@@ -19,7 +20,20 @@ public:
     folly::Future<Status> execute() override;
 
 private:
-    std::unordered_set<Value>               visited_;
+    bool visited(VidIndex::Id id) const {
+        return id < visited_.size() && visited_[id];
+    }
+
+    void visit(VidIndex::Id id) {
+        if (id >= visited_.size()) {
+            visited_.resize(vids_.size(), false);
+        }
+        visited_[id] = true;
+    }
+
+    VidIndex                                vids_;
+    // Indexed by the ids of `vids_'
+    std::vector<bool>                       visited_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -17,8 +17,10 @@ folly::Future<Status> ConjunctPathExecutor::execute() {
             return bfsShortestPath();
         case ConjunctPath::PathKind::kAllPaths:
             return allPaths();
-        case ConjunctPath::PathKind::kFloyd:
-            return floydShortestPath();
+        case ConjunctPath::PathKind::kWeighted:
+            return weightedShortestPath();
+        case ConjunctPath::PathKind::kMultiBFS:
+            return multiBfsShortestPath();
         default:
             LOG(FATAL) << "Not implement.";
     }
@@ -26,89 +28,89 @@ folly::Future<Status> ConjunctPathExecutor::execute() {
 
 folly::Future<Status> ConjunctPathExecutor::bfsShortestPath() {
     auto* conjunct = asNode<ConjunctPath>(node());
-    auto lIter = ectx_->getResult(conjunct->leftInputVar()).iter();
+    const auto& lHist = ectx_->getHistory(conjunct->leftInputVar());
     const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
     VLOG(1) << "current: " << node()->outputVar();
     VLOG(1) << "left input: " << conjunct->leftInputVar()
             << " right input: " << conjunct->rightInputVar();
-    DCHECK(!!lIter);
+    DCHECK(!lHist.empty());
+    DCHECK(!rHist.empty());
 
     DataSet ds;
     ds.colNames = conjunct->colNames();
 
-    VLOG(1) << "forward, size: " << forward_.size();
-    VLOG(1) << "backward, size: " << backward_.size();
-    forward_.emplace_back();
-    for (; lIter->valid(); lIter->next()) {
-        auto& dst = lIter->getColumn(kVid);
-        auto& edge = lIter->getColumn("edge");
-        VLOG(1) << "dst: " << dst << " edge: " << edge;
-        if (!edge.isEdge()) {
-            forward_.back().emplace(Value(dst), nullptr);
-        } else {
-            forward_.back().emplace(Value(dst), &edge.getEdge());
-        }
+    // The first results of both sides are the starts
+    if (forward_.layers() == 0) {
+        forward_.newLayer();
+        addBfsLayer(lHist.front(), forward_);
+        backward_.newLayer();
+        addBfsLayer(rHist.front(), backward_);
     }
 
-    bool isLatest = false;
-    if (rHist.size() >= 2) {
-        auto previous = rHist[rHist.size() - 2].iter();
-        VLOG(1) << "Find odd length path.";
-        auto rows = findBfsShortestPath(previous.get(), isLatest, forward_.back());
+    VLOG(1) << "forward, size: " << forward_.layers();
+    VLOG(1) << "backward, size: " << backward_.layers();
+    // The sides are expanded one by one, each adds one to the length of the paths met, so
+    // the paths met first are the shortest
+    if (expandForward_) {
+        auto rows = findBfsShortestPath(lHist.back(), forward_, backward_, forwardDegree_);
         if (!rows.empty()) {
-            VLOG(1) << "Meet odd length path.";
+            VLOG(1) << "Meet by forward.";
             ds.rows = std::move(rows);
             return finish(ResultBuilder().value(Value(std::move(ds))).finish());
         }
     }
-
-    auto latest = rHist.back().iter();
-    isLatest = true;
-    backward_.emplace_back();
-    VLOG(1) << "Find even length path.";
-    auto rows = findBfsShortestPath(latest.get(), isLatest, forward_.back());
-    if (!rows.empty()) {
-        VLOG(1) << "Meet even length path.";
-        ds.rows = std::move(rows);
+    if (expandBackward_) {
+        auto rows = findBfsShortestPath(rHist.back(), backward_, forward_, backwardDegree_);
+        if (!rows.empty()) {
+            VLOG(1) << "Meet by backward.";
+            ds.rows = std::move(rows);
+            return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+        }
     }
+    chooseBfsSides(conjunct);
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-std::vector<Row> ConjunctPathExecutor::findBfsShortestPath(
-    Iterator* iter,
-    bool isLatest,
-    std::multimap<Value, const Edge*>& table) {
-    std::unordered_set<Value> meets;
+void ConjunctPathExecutor::addBfsLayer(const Result& result, PathTree& tree) {
+    auto iter = result.iter();
     for (; iter->valid(); iter->next()) {
         auto& dst = iter->getColumn(kVid);
-        if (isLatest) {
-            auto& edge = iter->getColumn("edge");
-            VLOG(1) << "dst: " << dst << " edge: " << edge;
-            if (!edge.isEdge()) {
-                backward_.back().emplace(dst, nullptr);
-            } else {
-                backward_.back().emplace(dst, &edge.getEdge());
-            }
-        }
-        if (table.find(dst) != table.end()) {
-            meets.emplace(dst);
+        auto& edge = iter->getColumn("edge");
+        VLOG(1) << "dst: " << dst << " edge: " << edge;
+        tree.add(dst, edge.isEdge() ? &edge.getEdge() : nullptr);
+    }
+}
+
+std::vector<Row> ConjunctPathExecutor::findBfsShortestPath(const Result& result,
+                                                           PathTree& tree,
+                                                           const PathTree& other,
+                                                           double& degree) {
+    auto expanded = tree.latestVids().size();
+    tree.newLayer();
+    addBfsLayer(result, tree);
+    degree = static_cast<double>(tree.latestEdges()) / std::max<size_t>(expanded, 1);
+
+    // The vertices met in the latest layers of both sides, in the order they're reached
+    std::vector<VidIndex::Id> meets;
+    for (auto id : tree.latestVids()) {
+        if (other.inLatestLayer(id)) {
+            meets.emplace_back(id);
         }
     }
 
+    // Only the paths found are built, from the ids of their edges
     std::vector<Row> rows;
-    if (!meets.empty()) {
-        VLOG(1) << "Build forward, size: " << forward_.size();
-        auto forwardPath = buildBfsInterimPath(meets, forward_);
-        VLOG(1) << "Build backward, size: " << backward_.size();
-        auto backwardPath = buildBfsInterimPath(meets, backward_);
-        for (auto& p : forwardPath) {
-            auto range = backwardPath.equal_range(p.first);
-            for (auto& i = range.first; i != range.second; ++i) {
-                Path result = p.second;
-                result.reverse();
-                VLOG(1) << "Forward path: " << result;
-                VLOG(1) << "Backward path: " << i->second;
-                result.append(i->second);
+    for (auto id : meets) {
+        VLOG(1) << "Meet at: " << vids_.vid(id);
+        auto forwardPaths = forward_.paths(id);
+        auto backwardPaths = backward_.paths(id);
+        for (auto& forwardPath : forwardPaths) {
+            for (auto& backwardPath : backwardPaths) {
+                Path result;
+                result.steps.reserve(forwardPath.size() + backwardPath.size());
+                forward_.forwardSteps(forwardPath, result);
+                backward_.backwardSteps(backwardPath, result);
+                VLOG(1) << "Found path: " << result;
                 Row row;
                 row.emplace_back(std::move(result));
                 rows.emplace_back(std::move(row));
@@ -118,285 +120,449 @@ std::vector<Row> ConjunctPathExecutor::findBfsShortestPath(
     return rows;
 }
 
-std::multimap<Value, Path> ConjunctPathExecutor::buildBfsInterimPath(
-    std::unordered_set<Value>& meets,
-    std::vector<std::multimap<Value, const Edge*>>& hists) {
-    std::multimap<Value, Path> results;
-    for (auto& v : meets) {
-        VLOG(1) << "Meet at: " << v;
-        Path start;
-        start.src = Vertex(v, {});
-        if (hists.empty()) {
-            // Happens at one step path situation when meet at starts
-            VLOG(1) << "Start: " << start;
-            results.emplace(v, std::move(start));
-            continue;
+void ConjunctPathExecutor::chooseBfsSides(const ConjunctPath* conjunct) {
+    const auto& leftVar = conjunct->leftStartVidsVar();
+    const auto& rightVar = conjunct->rightStartVidsVar();
+    if (leftVar.empty() || rightVar.empty()) {
+        // Both sides are always expanded
+        return;
+    }
+    const auto& forwardVids = forward_.latestVids();
+    const auto& backwardVids = backward_.latestVids();
+    auto length = forward_.layers() + backward_.layers() - 2;
+    if (forwardVids.empty() || backwardVids.empty() || length >= conjunct->steps()) {
+        // No path within the steps, stop both sides
+        expandForward_ = false;
+        expandBackward_ = false;
+    } else {
+        // Expand the side of fewer edges to fetch, or both if they're close, so the
+        // vertices of high degree are expanded as late as possible
+        auto forwardCost = forwardVids.size() * forwardDegree_;
+        auto backwardCost = backwardVids.size() * backwardDegree_;
+        expandForward_ = forwardCost <= backwardCost * kBfsBalance;
+        expandBackward_ = backwardCost <= forwardCost * kBfsBalance;
+        if (expandForward_ && expandBackward_ && length + 2 > conjunct->steps()) {
+            expandForward_ = forwardCost <= backwardCost;
+            expandBackward_ = !expandForward_;
         }
-        std::vector<Path> interimPaths = {std::move(start)};
-        for (auto hist = hists.rbegin(); hist < hists.rend(); ++hist) {
-            std::vector<Path> tmp;
-            for (auto& interimPath : interimPaths) {
-                Value id;
-                if (interimPath.steps.empty()) {
-                    id = interimPath.src.vid;
-                } else {
-                    id = interimPath.steps.back().dst.vid;
-                }
-                auto edges = hist->equal_range(id);
-                for (auto i = edges.first; i != edges.second; ++i) {
-                    Path p = interimPath;
-                    if (i->second != nullptr) {
-                        auto& edge = *(i->second);
-                        VLOG(1) << "Edge: " << edge;
-                        VLOG(1) << "Interim path: " << interimPath;
-                        p.steps.emplace_back(
-                            Step(Vertex(edge.src, {}), -edge.type, edge.name, edge.ranking, {}));
-                        VLOG(1) << "New semi path: " << p;
-                    }
-                    if (hist == (hists.rend() - 1)) {
-                        VLOG(1) << "emplace result: " << p.src.vid;
-                        results.emplace(p.src.vid, std::move(p));
-                    } else {
-                        tmp.emplace_back(std::move(p));
-                    }
-                }   // `edge'
-            }       // `interimPath'
-            if (hist != (hists.rend() - 1)) {
-                interimPaths = std::move(tmp);
-            }
-        }   // `hist'
-    }       // `v'
-    return results;
+    }
+    VLOG(1) << "Expand forward: " << expandForward_ << " backward: " << expandBackward_;
+    setBfsStartVids(leftVar, expandForward_ ? forwardVids : std::vector<VidIndex::Id>());
+    setBfsStartVids(rightVar, expandBackward_ ? backwardVids : std::vector<VidIndex::Id>());
 }
 
+void ConjunctPathExecutor::setBfsStartVids(const std::string& var,
+                                           const std::vector<VidIndex::Id>& ids) {
+    DataSet ds;
+    ds.colNames.emplace_back(kVid);
+    ds.rows.reserve(ids.size());
+    for (auto id : ids) {
+        Row row;
+        row.values.emplace_back(vids_.vid(id));
+        ds.rows.emplace_back(std::move(row));
+    }
+    ectx_->setResult(var, ResultBuilder().value(Value(std::move(ds))).finish());
+}
 
-folly::Future<Status> ConjunctPathExecutor::floydShortestPath() {
+folly::Future<Status> ConjunctPathExecutor::weightedShortestPath() {
     auto* conjunct = asNode<ConjunctPath>(node());
-    conditionalVar_ = conjunct->conditionalVar();
-    auto lIter = ectx_->getResult(conjunct->leftInputVar()).iter();
+    const auto& lHist = ectx_->getHistory(conjunct->leftInputVar());
     const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
-    VLOG(1) << "current: " << node()->outputVar();
-    VLOG(1) << "left input: " << conjunct->leftInputVar()
-            << " right input: " << conjunct->rightInputVar();
-    DCHECK(!!lIter);
+    DCHECK(!lHist.empty());
+    DCHECK(!rHist.empty());
     auto steps = conjunct->steps();
-    count_++;
 
-    DataSet ds;
-    ds.colNames = conjunct->colNames();
-
-    CostPathsValMap forwardCostPathMap;
-    for (; lIter->valid(); lIter->next()) {
-        auto& dst = lIter->getColumn(kDst);
-        auto& src = lIter->getColumn(kSrc);
-        auto cost = lIter->getColumn("cost");
-
-        auto& pathList = lIter->getColumn("paths");
-        if (!pathList.isList()) {
-            continue;
-        }
-        auto& srcPaths = forwardCostPathMap[dst];
-        srcPaths.emplace(src, CostPaths(cost, pathList.getList()));
+    // The start vids are set before the first round
+    if (count_ == 0) {
+        addWeightedStarts(conjunct->leftStartVidsVar(), forwardReached_, sources_);
+        addWeightedStarts(conjunct->rightStartVidsVar(), backwardReached_, targets_);
     }
+    count_++;
 
-    if (rHist.size() >= 2) {
-        auto previous = rHist[rHist.size() - 2].iter();
-        VLOG(1) << "Find odd length path.";
-        findPath(previous.get(), forwardCostPathMap, ds);
+    std::vector<VidIndex::Id> forwardFrontier;
+    std::vector<VidIndex::Id> backwardFrontier;
+    const auto& weightProp = conjunct->weightProp();
+    NG_RETURN_IF_ERROR(
+        addWeightedArcs(lHist.back(), weightProp, false, forwardReached_, forwardFrontier));
+    NG_RETURN_IF_ERROR(
+        addWeightedArcs(rHist.back(), weightProp, true, backwardReached_, backwardFrontier));
+    VLOG(1) << "Arcs: " << graph_.arcs() << " forward: " << forwardFrontier.size()
+            << " backward: " << backwardFrontier.size();
+
+    // Each edge of a path within the steps is fetched from a vertex within ceil(steps/2) - 1
+    // steps of the starts, or into one within floor(steps/2) - 1 steps of the ends
+    if (count_ >= steps - steps / 2) {
+        forwardFrontier.clear();
     }
-
-    if (count_ * 2 < steps) {
-        VLOG(1) << "Find even length path.";
-        auto latest = rHist.back().iter();
-        findPath(latest.get(), forwardCostPathMap, ds);
+    if (count_ >= steps / 2) {
+        backwardFrontier.clear();
     }
+    setBfsStartVids(conjunct->leftStartVidsVar(), forwardFrontier);
+    setBfsStartVids(conjunct->rightStartVidsVar(), backwardFrontier);
 
+    DataSet ds;
+    ds.colNames = conjunct->colNames();
+    if (forwardFrontier.empty() && backwardFrontier.empty()) {
+        // All the edges are fetched, find the lightest paths of each pair
+        for (auto src : sources_) {
+            for (auto& path : graph_.shortestPaths(src, targets_, steps)) {
+                VLOG(1) << "Found path: " << path.first << " weight: " << path.second;
+                Row row;
+                row.values.emplace_back(std::move(path.first));
+                row.values.emplace_back(path.second);
+                ds.rows.emplace_back(std::move(row));
+            }
+        }
+    }
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-Status ConjunctPathExecutor::conjunctPath(const List& forwardPaths,
-                                          const List& backwardPaths,
-                                          Value& cost,
-                                          DataSet& ds) {
-    for (auto& i : forwardPaths.values) {
-        if (!i.isPath()) {
-            return Status::Error("Forward Path Type Error");
+void ConjunctPathExecutor::addWeightedStarts(const std::string& var,
+                                             std::vector<bool>& reached,
+                                             std::vector<VidIndex::Id>& ids) {
+    auto iter = ectx_->getResult(var).iter();
+    for (; iter->valid(); iter->next()) {
+        auto id = vids_.insert(iter->getColumn(kVid));
+        if (reached.size() < vids_.size()) {
+            reached.resize(vids_.size(), false);
         }
-        for (auto& j : backwardPaths.values) {
-            if (!j.isPath()) {
-                return Status::Error("Forward Path Type Error");
-            }
-            Row row;
-            auto forward = i.getPath();
-            auto backward = j.getPath();
-            VLOG(1) << "Forward path:" << forward;
-            VLOG(1) << "Backward path:" << backward;
-            backward.reverse();
-            VLOG(1) << "Backward reverse path:" << backward;
-            forward.append(std::move(backward));
-            VLOG(1) << "Found path: " << forward;
-            row.values.emplace_back(std::move(forward));
-            row.values.emplace_back(cost);
-            ds.rows.emplace_back(std::move(row));
+        if (!reached[id]) {
+            reached[id] = true;
+            ids.emplace_back(id);
         }
     }
-    return Status::OK();
 }
 
-bool ConjunctPathExecutor::findPath(Iterator* backwardPathIter,
-                                    CostPathsValMap& forwardPathTable,
-                                    DataSet& ds) {
-    bool found = false;
-    for (; backwardPathIter->valid(); backwardPathIter->next()) {
-        auto& dst = backwardPathIter->getColumn(kDst);
-        auto& endVid = backwardPathIter->getColumn(kSrc);
-        auto cost = backwardPathIter->getColumn("cost");
-        VLOG(1) << "Backward dst: " << dst;
-        auto& pathList = backwardPathIter->getColumn("paths");
-        if (!pathList.isList()) {
+Status ConjunctPathExecutor::addWeightedArcs(const Result& result,
+                                             const std::string& weightProp,
+                                             bool reverse,
+                                             std::vector<bool>& reached,
+                                             std::vector<VidIndex::Id>& frontier) {
+    auto iter = result.iter();
+    if (!iter->isGetNeighborsIter()) {
+        return Status::Error("Only accept GetNeighbotsIter.");
+    }
+    for (; iter->valid(); iter->next()) {
+        auto edgeVal = iter->getEdge();
+        if (!edgeVal.isEdge()) {
             continue;
         }
-        auto forwardPaths = forwardPathTable.find(dst);
-        if (forwardPaths == forwardPathTable.end()) {
-            continue;
+        auto& edge = edgeVal.getEdge();
+        auto found = edge.props.find(weightProp);
+        if (found == edge.props.end() || !found->second.isNumeric()) {
+            return Status::Error("The weight `%s' of edge `%s' should be numeric",
+                                 weightProp.c_str(),
+                                 edge.name.c_str());
         }
-        for (auto& srcPaths : forwardPaths->second) {
-            auto& startVid = srcPaths.first;
-            if (startVid == endVid) {
-                delPathFromConditionalVar(startVid, endVid);
-                continue;
-            }
-            auto totalCost = cost + srcPaths.second.cost_;
-            if (historyCostMap_.find(startVid) != historyCostMap_.end() &&
-                historyCostMap_[startVid].find(endVid) != historyCostMap_[startVid].end() &&
-                historyCostMap_[startVid][endVid] < totalCost) {
-                continue;
-            }
-            // update history cost
-            auto& hist = historyCostMap_[startVid];
-            hist[endVid] = totalCost;
-            delPathFromConditionalVar(startVid, endVid);
-            conjunctPath(srcPaths.second.paths_, pathList.getList(), totalCost, ds);
-            found = true;
+        auto weight = found->second.isInt() ? static_cast<double>(found->second.getInt())
+                                            : found->second.getFloat();
+        if (!(weight >= 0.0)) {
+            return Status::Error("The weight `%s' of edge `%s' should not be negative",
+                                 weightProp.c_str(),
+                                 edge.name.c_str());
+        }
+        auto src = vids_.insert(edge.src);
+        auto dst = vids_.insert(edge.dst);
+        if (reverse) {
+            // The edge fetched backward is stepped over from its dst
+            graph_.addArc(dst, src, -edge.type, edge.ranking, edge.name, weight);
+        } else {
+            graph_.addArc(src, dst, edge.type, edge.ranking, edge.name, weight);
+        }
+        if (reached.size() < vids_.size()) {
+            reached.resize(vids_.size(), false);
+        }
+        if (!reached[dst]) {
+            reached[dst] = true;
+            frontier.emplace_back(dst);
         }
     }
-    return found;
+    return Status::OK();
 }
 
-void ConjunctPathExecutor::delPathFromConditionalVar(const Value& start, const Value& end) {
-    auto iter = qctx_->ectx()->getResult(conditionalVar_).iter();
+folly::Future<Status> ConjunctPathExecutor::multiBfsShortestPath() {
+    auto* conjunct = asNode<ConjunctPath>(node());
+    const auto& lHist = ectx_->getHistory(conjunct->leftInputVar());
+    const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
+    DCHECK(!lHist.empty());
+    DCHECK(!rHist.empty());
+    auto steps = conjunct->steps();
 
-    while (iter->valid()) {
-        auto startVid = iter->getColumn(0);
-        auto endVid = iter->getColumn(1);
-        if (startVid == endVid || (startVid == start && endVid == end)) {
-            iter->unstableErase();
-        } else {
-            iter->next();
+    // The start vids are set before the first round
+    if (count_ == 0) {
+        setMultiBfsStarts(conjunct->leftStartVidsVar(), forwardBfs_);
+        setMultiBfsStarts(conjunct->rightStartVidsVar(), backwardBfs_);
+        auto& sources = forwardBfs_.starts();
+        auto& targets = backwardBfs_.starts();
+        foundPairs_.resize(targets.size() * forwardBfs_.words(), 0);
+        pairsLeft_ = sources.size() * targets.size();
+        // No path from a vertex to itself
+        for (size_t j = 0; j < targets.size(); ++j) {
+            auto* source = forwardBfs_.mask(0, targets[j]);
+            if (source != nullptr) {
+                for (size_t w = 0; w < forwardBfs_.words(); ++w) {
+                    foundPairs_[j * forwardBfs_.words() + w] |= source[w];
+                }
+                --pairsLeft_;
+            }
         }
     }
+    NG_RETURN_IF_ERROR(addMultiBfsArcs(lHist.back(), forwardBfs_));
+    NG_RETURN_IF_ERROR(addMultiBfsArcs(rHist.back(), backwardBfs_));
 
     DataSet ds;
-    if (iter->size() == 0) {
-        Row row;
-        row.values.emplace_back("all path are found");
-        ds.rows.emplace_back(std::move(row));
+    ds.colNames = conjunct->colNames();
+    std::vector<VidIndex::Id> forwardFrontier;
+    std::vector<VidIndex::Id> backwardFrontier;
+    // Both sides reach the layer `count_' in each round, and the paths of the lengths
+    // 2 * count_ - 1 and 2 * count_ met in it are the shortest ones of the pairs not met yet.
+    // The vertices reached again by more starts are walked by the arcs fetched already, so the
+    // rounds fetching nothing are done here at once.
+    do {
+        count_++;
+        forwardFrontier = forwardBfs_.expand();
+        if (count_ <= steps / 2) {
+            backwardFrontier = backwardBfs_.expand();
+        }
+        meetMultiBfs(2 * count_ - 1, ds);
+        if (count_ <= steps / 2) {
+            meetMultiBfs(2 * count_, ds);
+        }
+        VLOG(1) << "Round: " << count_ << " pairs left: " << pairsLeft_
+                << " forward: " << forwardFrontier.size()
+                << " backward: " << backwardFrontier.size();
+
+        auto latestEmpty = [](const MultiSourceBfs& bfs) {
+            return bfs.vids(bfs.layers() - 1).empty();
+        };
+        if (pairsLeft_ == 0 || count_ >= steps - steps / 2 || latestEmpty(forwardBfs_) ||
+            latestEmpty(backwardBfs_)) {
+            forwardFrontier.clear();
+            backwardFrontier.clear();
+            break;
+        }
+        if (count_ >= steps / 2) {
+            backwardFrontier.clear();
+        }
+    } while (forwardFrontier.empty() && backwardFrontier.empty());
+    setBfsStartVids(conjunct->leftStartVidsVar(), forwardFrontier);
+    setBfsStartVids(conjunct->rightStartVidsVar(), backwardFrontier);
+
+    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+}
+
+void ConjunctPathExecutor::setMultiBfsStarts(const std::string& var, MultiSourceBfs& bfs) {
+    std::vector<VidIndex::Id> ids;
+    auto iter = ectx_->getResult(var).iter();
+    for (; iter->valid(); iter->next()) {
+        ids.emplace_back(vids_.insert(iter->getColumn(kVid)));
+    }
+    bfs.setStarts(ids);
+}
+
+Status ConjunctPathExecutor::addMultiBfsArcs(const Result& result, MultiSourceBfs& bfs) {
+    auto iter = result.iter();
+    if (!iter->isGetNeighborsIter()) {
+        return Status::Error("Only accept GetNeighbotsIter.");
+    }
+    for (; iter->valid(); iter->next()) {
+        auto edgeVal = iter->getEdge();
+        if (!edgeVal.isEdge()) {
+            continue;
+        }
+        auto& edge = edgeVal.getEdge();
+        auto src = vids_.insert(edge.src);
+        auto dst = vids_.insert(edge.dst);
+        bfs.addArc(src, dst, edge.type, edge.ranking, edge.name);
+    }
+    return Status::OK();
+}
+
+void ConjunctPathExecutor::meetMultiBfs(size_t length, DataSet& ds) {
+    auto forwardLayer = length - length / 2;
+    auto backwardLayer = length / 2;
+    auto words = forwardBfs_.words();
+    auto targetWords = backwardBfs_.words();
+    // The sources meeting each target first in this length, `words' each
+    std::vector<uint64_t> found(foundPairs_.size(), 0);
+    std::vector<std::vector<uint32_t>> forwardPaths;
+    std::vector<std::vector<uint32_t>> backwardPaths;
+    for (auto vid : forwardBfs_.vids(forwardLayer)) {
+        auto* backward = backwardBfs_.mask(backwardLayer, vid);
+        if (backward == nullptr) {
+            continue;
+        }
+        auto* forward = forwardBfs_.mask(forwardLayer, vid);
+        for (size_t tw = 0; tw < targetWords; ++tw) {
+            for (auto targets = backward[tw]; targets != 0; targets &= targets - 1) {
+                auto target = tw * 64 + __builtin_ctzll(targets);
+                auto* foundSources = &foundPairs_[target * words];
+                for (size_t w = 0; w < words; ++w) {
+                    auto sources = forward[w] & ~foundSources[w];
+                    found[target * words + w] |= sources;
+                    for (; sources != 0; sources &= sources - 1) {
+                        auto source = w * 64 + __builtin_ctzll(sources);
+                        // Only the paths of the pairs met are built
+                        forwardPaths.clear();
+                        backwardPaths.clear();
+                        forwardBfs_.paths(source, forwardLayer, vid, forwardPaths);
+                        backwardBfs_.paths(target, backwardLayer, vid, backwardPaths);
+                        for (auto& f : forwardPaths) {
+                            for (auto& b : backwardPaths) {
+                                Path path;
+                                forwardBfs_.forwardSteps(f, path);
+                                backwardBfs_.backwardSteps(b, path);
+                                VLOG(1) << "Found path: " << path;
+                                Row row;
+                                row.values.emplace_back(std::move(path));
+                                ds.rows.emplace_back(std::move(row));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (size_t i = 0; i < found.size(); ++i) {
+        foundPairs_[i] |= found[i];
+        pairsLeft_ -= __builtin_popcountll(found[i]);
     }
-    qctx_->ectx()->setResult(
-        conditionalVar_,
-        ResultBuilder().value(Value(std::move(ds))).iter(std::move(iter)).finish());
 }
 
 folly::Future<Status> ConjunctPathExecutor::allPaths() {
     auto* conjunct = asNode<ConjunctPath>(node());
     noLoop_ = conjunct->noLoop();
-    auto lIter = ectx_->getResult(conjunct->leftInputVar()).iter();
+    const auto& lHist = ectx_->getHistory(conjunct->leftInputVar());
     const auto& rHist = ectx_->getHistory(conjunct->rightInputVar());
     VLOG(1) << "current: " << node()->outputVar();
     VLOG(1) << "left input: " << conjunct->leftInputVar()
             << " right input: " << conjunct->rightInputVar();
     VLOG(1) << "right hist size: " << rHist.size();
-    DCHECK(!!lIter);
+    DCHECK(!lHist.empty());
+    DCHECK(!rHist.empty());
     auto steps = conjunct->steps();
     count_++;
 
     DataSet ds;
     ds.colNames = conjunct->colNames();
 
-    std::unordered_map<Value, const List&> table;
-    for (; lIter->valid(); lIter->next()) {
-        auto& dst = lIter->getColumn(kVid);
-        auto& path = lIter->getColumn("path");
-        if (path.isList()) {
-            VLOG(1) << "Forward dst: " << dst;
-            table.emplace(dst, path.getList());
-        }
-    }
+    auto lSize = forwardDropped_ + lHist.size();
+    auto rSize = backwardDropped_ + rHist.size();
+    addAllPathsLayers(lHist, forwardDropped_, lSize, forwardTrie_, forwardTips_);
 
-    if (rHist.size() >= 2) {
+    if (rSize >= 2) {
         VLOG(1) << "Find odd length path.";
-        auto previous = rHist[rHist.size() - 2].iter();
-        findAllPaths(previous.get(), table, ds);
+        addAllPathsLayers(rHist, backwardDropped_, rSize - 1, backwardTrie_, backwardTips_);
+        conjunctAllPaths(forwardTips_.back(), backwardTips_[rSize - 2], ds);
     }
 
     if (count_ * 2 <= steps) {
         VLOG(1) << "Find even length path.";
-        auto latest = rHist.back().iter();
-        findAllPaths(latest.get(), table, ds);
+        addAllPathsLayers(rHist, backwardDropped_, rSize, backwardTrie_, backwardTips_);
+        conjunctAllPaths(forwardTips_.back(), backwardTips_.back(), ds);
     }
 
+    truncAllPathsHistory(conjunct->leftInputVar(), forwardTips_, forwardDropped_);
+    truncAllPathsHistory(conjunct->rightInputVar(), backwardTips_, backwardDropped_);
+
     return finish(ResultBuilder().value(Value(std::move(ds))).finish());
 }
 
-bool ConjunctPathExecutor::findAllPaths(Iterator* backwardPathsIter,
-                                        std::unordered_map<Value, const List&>& forwardPathsTable,
-                                        DataSet& ds) {
-    bool found = false;
-    for (; backwardPathsIter->valid(); backwardPathsIter->next()) {
-        auto& dst = backwardPathsIter->getColumn(kVid);
-        VLOG(1) << "Backward dst: " << dst;
-        auto& pathList = backwardPathsIter->getColumn("path");
-        if (!pathList.isList()) {
-            continue;
-        }
-        for (const auto& path : pathList.getList().values) {
-            if (!path.isPath()) {
+void ConjunctPathExecutor::addAllPathsLayers(const std::vector<Result>& hist,
+                                             size_t dropped,
+                                             size_t end,
+                                             PathTrie& trie,
+                                             TipLayers& layers) {
+    DCHECK_LE(dropped, layers.size());
+    for (auto i = layers.size(); i < end; ++i) {
+        layers.emplace_back();
+        auto& layer = layers.back();
+        for (auto iter = hist[i - dropped].iter(); iter->valid(); iter->next()) {
+            auto& edgeVal = iter->getColumn("edge");
+            if (!edgeVal.isEdge()) {
+                // The start itself
+                layer.emplace_back(Tip{vids_.insert(iter->getColumn(kVid)), PathTrie::kRoot});
                 continue;
             }
-            auto forwardPaths = forwardPathsTable.find(dst);
-            if (forwardPaths == forwardPathsTable.end()) {
-                continue;
+            auto& edge = edgeVal.getEdge();
+            auto& parentVal = iter->getColumn("parent");
+            auto parent = PathTrie::kRoot;
+            if (parentVal.isInt() && parentVal.getInt() >= 0) {
+                parent = static_cast<uint32_t>(parentVal.getInt());
+                DCHECK_LT(parent, trie.size());
             }
+            auto src = vids_.insert(edge.src);
+            auto dst = vids_.insert(edge.dst);
+            // The history is dropped once added, so the edge is kept by the executor
+            edges_.emplace_back(edge);
+            auto node = trie.add(parent, src, dst, edge.type, edge.ranking, &edges_.back());
+            layer.emplace_back(Tip{dst, node});
+        }
+    }
+}
 
-            for (const auto& i : forwardPaths->second.values) {
-                if (!i.isPath()) {
-                    continue;
-                }
-                Row row;
-                auto forward = i.getPath();
-                Path backward = path.getPath();
-                if (forward.src == backward.src) {
-                    continue;
-                }
-                VLOG(1) << "Forward path:" << forward;
-                VLOG(1) << "Backward path:" << backward;
-                backward.reverse();
-                VLOG(1) << "Backward reverse path:" << backward;
-                forward.append(std::move(backward));
-                if (forward.hasDuplicateEdges()) {
-                    continue;
-                }
-                if (noLoop_ && forward.hasDuplicateVertices()) {
-                    continue;
+void ConjunctPathExecutor::truncAllPathsHistory(const std::string& var,
+                                                const TipLayers& layers,
+                                                size_t& dropped) {
+    // The latest result is still read as the input of the next step
+    auto size = ectx_->getHistory(var).size();
+    DCHECK_LE(layers.size(), dropped + size);
+    auto keep = std::max(dropped + size - layers.size(), size_t{1});
+    if (keep >= size) {
+        return;
+    }
+    ectx_->truncHistory(var, keep);
+    dropped += size - keep;
+}
+
+void ConjunctPathExecutor::conjunctAllPaths(const std::vector<Tip>& forward,
+                                            const std::vector<Tip>& backward,
+                                            DataSet& ds) const {
+    // Chain the forward tips of each vertex, in the order they're found
+    std::vector<uint32_t> head(vids_.size(), VidIndex::kNone);
+    std::vector<uint32_t> next(forward.size(), VidIndex::kNone);
+    for (auto i = forward.size(); i > 0; --i) {
+        auto tip = static_cast<uint32_t>(i - 1);
+        next[tip] = head[forward[tip].vid];
+        head[forward[tip].vid] = tip;
+    }
+
+    auto start = [](const PathTrie& trie, const Tip& tip) {
+        return tip.node == PathTrie::kRoot ? tip.vid : trie.node(tip.node).start;
+    };
+    for (auto& b : backward) {
+        for (auto i = head[b.vid]; i != VidIndex::kNone; i = next[i]) {
+            auto& f = forward[i];
+            if (start(forwardTrie_, f) == start(backwardTrie_, b)) {
+                continue;
+            }
+            bool conjunctable = true;
+            if (f.node != PathTrie::kRoot) {
+                // Each edge of the backward path must not be in the forward one, nor each vertex
+                // but the one they meet at if no loop
+                for (auto n = b.node; n != PathTrie::kRoot; n = backwardTrie_.node(n).parent) {
+                    auto& edge = backwardTrie_.node(n);
+                    if (forwardTrie_.hasEdge(f.node, edge.src, edge.vid, edge.type, edge.ranking)
+                        || (noLoop_ && forwardTrie_.hasVertex(f.node, edge.src))) {
+                        conjunctable = false;
+                        break;
+                    }
                 }
-                VLOG(1) << "Found path: " << forward;
-                row.values.emplace_back(std::move(forward));
-                ds.rows.emplace_back(std::move(row));
-            }  // `i'
-            found = true;
-        }  // `path'
-    }  // `backwardPathsIter'
-    return found;
+            }
+            if (!conjunctable) {
+                continue;
+            }
+            Path path;
+            if (f.node == PathTrie::kRoot) {
+                path.src = Vertex(vids_.vid(f.vid), {});
+            } else {
+                forwardTrie_.forwardSteps(f.node, path);
+            }
+            backwardTrie_.backwardSteps(b.node, path);
+            VLOG(1) << "Found path: " << path;
+            ds.rows.emplace_back(Row({std::move(path)}));
+        }
+    }
 }
 
 }  // namespace graph
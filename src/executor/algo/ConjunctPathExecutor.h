@@ -8,9 +8,15 @@
 #define EXECUTOR_ALGO_CONJUNCTPATHEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/MultiSourceBfs.h"
+#include "util/PathTree.h"
+#include "util/PathTrie.h"
+#include "util/WeightedGraph.h"
 
 namespace nebula {
 namespace graph {
+class ConjunctPath;
+
 class ConjunctPathExecutor final : public Executor {
 public:
     ConjunctPathExecutor(const PlanNode* node, QueryContext* qctx)
@@ -18,48 +24,110 @@ public:
 
     folly::Future<Status> execute() override;
 
-    struct CostPaths {
-        CostPaths(Value& cost, const List& paths) : cost_(cost), paths_(paths) {}
-        Value cost_;
-        const List& paths_;
-    };
-
 private:
-    using CostPathsValMap = std::unordered_map<Value, std::unordered_map<Value, CostPaths>>;
-
     folly::Future<Status> bfsShortestPath();
 
     folly::Future<Status> allPaths();
 
-    std::vector<Row> findBfsShortestPath(Iterator* iter,
-                                         bool isLatest,
-                                         std::multimap<Value, const Edge*>& table);
+    void addBfsLayer(const Result& result, PathTree& tree);
+
+    // Add the next layer of `tree' from `result', and conjunct the paths
+    // met with the latest layer of `other'
+    std::vector<Row> findBfsShortestPath(const Result& result,
+                                         PathTree& tree,
+                                         const PathTree& other,
+                                         double& degree);
+
+    // Choose the sides to expand in the next round
+    void chooseBfsSides(const ConjunctPath* conjunct);
+
+    void setBfsStartVids(const std::string& var, const std::vector<VidIndex::Id>& ids);
 
-    std::multimap<Value, Path> buildBfsInterimPath(
-        std::unordered_set<Value>& meets,
-        std::vector<std::multimap<Value, const Edge*>>& hist);
+    folly::Future<Status> weightedShortestPath();
 
-    folly::Future<Status> floydShortestPath();
+    // Add the vids of the latest result of `var' to `ids', and mark them reached
+    void addWeightedStarts(const std::string& var,
+                           std::vector<bool>& reached,
+                           std::vector<VidIndex::Id>& ids);
+
+    // Add the edges fetched by one side to `graph_' as the arcs of the forward direction,
+    // and the vertices reached first by them to `frontier'
+    Status addWeightedArcs(const Result& result,
+                           const std::string& weightProp,
+                           bool reverse,
+                           std::vector<bool>& reached,
+                           std::vector<VidIndex::Id>& frontier);
+
+    folly::Future<Status> multiBfsShortestPath();
+
+    // Set the vids of the latest result of `var' as the starts of `bfs'
+    void setMultiBfsStarts(const std::string& var, MultiSourceBfs& bfs);
+
+    // Add the edges fetched by one side to `bfs' as they're fetched
+    Status addMultiBfsArcs(const Result& result, MultiSourceBfs& bfs);
+
+    // Conjunct the paths of `length' of the pairs met first, which are met in the latest
+    // forward layer
+    void meetMultiBfs(size_t length, DataSet& ds);
+
+    // The end of a path found by one side, `node' is kRoot for the start itself
+    struct Tip {
+        VidIndex::Id    vid;
+        uint32_t        node;
+    };
+    using TipLayers = std::vector<std::vector<Tip>>;
 
-    bool findPath(Iterator* backwardPathIter, CostPathsValMap& forwardPathtable, DataSet& ds);
+    // Add the paths of the results in `hist' to `trie', from the first one not added yet
+    // up to `end', each as a layer of tips. The first `dropped' results are out of `hist'.
+    void addAllPathsLayers(const std::vector<Result>& hist,
+                           size_t dropped,
+                           size_t end,
+                           PathTrie& trie,
+                           TipLayers& layers);
 
-    Status conjunctPath(const List& forwardPaths,
-                        const List& backwardPaths,
-                        Value& cost,
-                        DataSet& ds);
+    // Drop the results of `var' added to `layers' already, but the latest one
+    void truncAllPathsHistory(const std::string& var, const TipLayers& layers, size_t& dropped);
 
-    bool findAllPaths(Iterator* backwardPathsIter,
-                      std::unordered_map<Value, const List&>& forwardPathsTable,
-                      DataSet& ds);
-    void delPathFromConditionalVar(const Value& start, const Value& end);
+    // Conjunct the paths ending at the same vertices
+    void conjunctAllPaths(const std::vector<Tip>& forward,
+                          const std::vector<Tip>& backward,
+                          DataSet& ds) const;
 
 private:
-    std::vector<std::multimap<Value, const Edge*>> forward_;
-    std::vector<std::multimap<Value, const Edge*>> backward_;
+    // The vertices reached from both sides share the ids
+    VidIndex vids_;
+    PathTree forward_{&vids_};
+    PathTree backward_{&vids_};
+    // Expand a side alone only if it fetches fewer edges by this factor
+    static constexpr double kBfsBalance = 2.0;
+    bool expandForward_{true};
+    bool expandBackward_{true};
+    // The edges fetched per vertex by the last step of each side
+    double forwardDegree_{1.0};
+    double backwardDegree_{1.0};
+    // The paths found by both sides for all paths, the vertices share the ids above
+    PathTrie forwardTrie_{&vids_};
+    PathTrie backwardTrie_{&vids_};
+    TipLayers forwardTips_;
+    TipLayers backwardTips_;
+    // The results of each side dropped from the history once added to the tries, so the
+    // edges of the tries are kept here
+    size_t forwardDropped_{0};
+    size_t backwardDropped_{0};
+    std::deque<Edge> edges_;
+    // The edges fetched by both sides for weighted paths, and the vertices reached by each side
+    WeightedGraph graph_{&vids_};
+    std::vector<VidIndex::Id> sources_;
+    std::vector<VidIndex::Id> targets_;
+    std::vector<bool> forwardReached_;
+    std::vector<bool> backwardReached_;
+    // The BFS of both sides for multiple pairs, each from all of its starts at once, and
+    // the sources met by each target so far, `forwardBfs_.words()' each
+    MultiSourceBfs forwardBfs_{&vids_};
+    MultiSourceBfs backwardBfs_{&vids_};
+    std::vector<uint64_t> foundPairs_;
+    size_t pairsLeft_{0};
     size_t count_{0};
-    // startVid : {endVid, cost}
-    std::unordered_map<Value, std::unordered_map<Value, Value>> historyCostMap_;
-    std::string conditionalVar_;
     bool noLoop_;
 };
 }  // namespace graph
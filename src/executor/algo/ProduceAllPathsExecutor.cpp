@@ -18,74 +18,61 @@ folly::Future<Status> ProduceAllPathsExecutor::execute() {
 
     DataSet ds;
     ds.colNames = node()->colNames();
-    Interims interims;
 
     if (!iter->isGetNeighborsIter()) {
         return Status::Error("Only accept GetNeighbotsIter.");
     }
     VLOG(1) << "Edge size: " << iter->size();
+    std::vector<uint32_t> tips;
     for (; iter->valid(); iter->next()) {
         auto edgeVal = iter->getEdge();
         if (!edgeVal.isEdge()) {
             continue;
         }
         auto& edge = edgeVal.getEdge();
-        auto histPaths = historyPaths_.find(edge.src);
-        if (histPaths == historyPaths_.end()) {
-            createPaths(edge, interims);
-        } else {
-            buildPaths(histPaths->second, edge, interims);
-        }
-    }
-
-    for (auto& interim : interims) {
-        Row row;
-        auto& dst = interim.first;
-        auto& paths = interim.second;
-        row.values.emplace_back(std::move(dst));
-        row.values.emplace_back(List(std::move(paths)));
-        ds.rows.emplace_back(std::move(row));
-
-        const auto& dstInDs = ds.rows.back().values.front();
-        for (auto& path : ds.rows.back().values.back().getList().values) {
-            historyPaths_[dstInDs].emplace_back(&path.getPath());
+        auto src = vids_.insert(edge.src);
+        auto dst = vids_.insert(edge.dst);
+        if (count_ == 0) {
+            if (noLoop_ && src == dst) {
+                continue;
+            }
+            tips.emplace_back(trie_.add(PathTrie::kRoot, src, dst, edge.type, edge.ranking));
+            ds.rows.emplace_back(Row({edge.dst, edgeVal, -1}));
+            continue;
         }
-    }
-    count_++;
-    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
-}
-
-void ProduceAllPathsExecutor::createPaths(const Edge& edge, Interims& interims) {
-    Path path;
-    path.src = Vertex(edge.src, {});
-    path.steps.emplace_back(Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
-    if (noLoop_ && path.hasDuplicateVertices()) {
-        return;
-    }
-    VLOG(1) << "Create path: " << path;
-    interims[edge.dst].emplace_back(std::move(path));
-}
-
-void ProduceAllPathsExecutor::buildPaths(const std::vector<const Path*>& history,
-                                         const Edge& edge,
-                                         Interims& interims) {
-    for (auto* histPath : history) {
-        if (histPath->steps.size() < count_) {
+        if (src >= tipHead_.size()) {
             continue;
-        } else {
-            Path path = *histPath;
-            path.steps.emplace_back(
-                Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
-            if (path.hasDuplicateEdges()) {
+        }
+        for (auto tip = tipHead_[src]; tip != VidIndex::kNone; tip = tipNext_[tip]) {
+            auto parent = tips_[tip];
+            if (trie_.hasEdge(parent, src, dst, edge.type, edge.ranking)) {
                 continue;
             }
-            if (noLoop_ && path.hasDuplicateVertices()) {
+            if (noLoop_ && trie_.hasVertex(parent, dst)) {
                 continue;
             }
-            VLOG(1) << "Build path: " << path;
-            interims[edge.dst].emplace_back(std::move(path));
+            tips.emplace_back(trie_.add(parent, src, dst, edge.type, edge.ranking));
+            ds.rows.emplace_back(Row({edge.dst, edgeVal, static_cast<int64_t>(parent)}));
         }
     }
+    VLOG(1) << "Path size: " << tips.size();
+
+    tips_ = std::move(tips);
+    indexTips();
+    count_++;
+    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+}
+
+void ProduceAllPathsExecutor::indexTips() {
+    tipHead_.assign(vids_.size(), VidIndex::kNone);
+    tipNext_.assign(tips_.size(), VidIndex::kNone);
+    // Chain backward so the tips of each end are in the order they're found
+    for (auto i = tips_.size(); i > 0; --i) {
+        auto tip = static_cast<uint32_t>(i - 1);
+        auto end = trie_.node(tips_[tip]).vid;
+        tipNext_[tip] = tipHead_[end];
+        tipHead_[end] = tip;
+    }
 }
 
 }  // namespace graph
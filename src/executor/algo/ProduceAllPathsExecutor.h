@@ -8,9 +8,15 @@
 #define EXECUTOR_ALGO_PRODUCEALLPATHSEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/PathTrie.h"
 
 namespace nebula {
 namespace graph {
+/**
+ * Each step outputs a row for each path found, of its end, its last edge and the row of the
+ * path it extends, -1 if it's the edge alone. The rows are numbered in the order they're output
+ * across the steps, so the paths are only built by whom they're asked for, e.g. ConjunctPath.
+ */
 class ProduceAllPathsExecutor final : public Executor {
 public:
     ProduceAllPathsExecutor(const PlanNode* node, QueryContext* qctx)
@@ -19,18 +25,18 @@ public:
     folly::Future<Status> execute() override;
 
 private:
-    // k: dst, v: paths to dst
-    using HistoryPaths = std::unordered_map<Value, std::vector<const Path*>>;
-
-    // k: dst, v: paths to dst
-    using Interims = std::unordered_map<Value, std::vector<Value>>;
-
-    void createPaths(const Edge& edge, Interims& interims);
-
-    void buildPaths(const std::vector<const Path*>& history, const Edge& edge, Interims& interims);
+    // Index the paths found by the last step by their ends
+    void indexTips();
 
     size_t count_{0};
-    HistoryPaths historyPaths_;
+    VidIndex vids_;
+    // The paths found, a node for each row output
+    PathTrie trie_{&vids_};
+    // The paths found by the last step
+    std::vector<uint32_t> tips_;
+    // The first and next tips of each end, indexed by its id
+    std::vector<uint32_t> tipHead_;
+    std::vector<uint32_t> tipNext_;
     bool noLoop_{false};
 };
 }  // namespace graph
@@ -59,14 +59,20 @@ folly::Future<Status> DeleteVerticesExecutor::deleteVertices() {
         return Status::OK();
     }
     auto spaceId = spaceInfo.id;
+    std::vector<Value> cached;
+    if (hasCache()) {
+        cached = vertices;
+    }
     time::Duration deleteVertTime;
     return qctx()->getStorageClient()->deleteVertices(spaceId, std::move(vertices))
         .via(runner())
         .ensure([deleteVertTime]() {
             VLOG(1) << "Delete vertices time: " << deleteVertTime.elapsedInUSec() << "us";
         })
-        .then([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
+        .then([this, spaceId, cached = std::move(cached)](
+                  storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
             SCOPED_TIMER(&execTime_);
+            evictDeletedVertices(spaceId, cached);
             NG_RETURN_IF_ERROR(handleCompleteness(resp, true));
             return Status::OK();
         });
@@ -153,14 +159,26 @@ folly::Future<Status> DeleteEdgesExecutor::deleteEdges() {
     }
 
     auto spaceId = spaceInfo.id;
+    // Both the out and in edges are deleted, so their sources are all the ends
+    std::vector<Value> cached;
+    if (qctx()->neighborCache() != nullptr) {
+        cached.reserve(edgeKeys.size());
+        for (auto &edgeKey : edgeKeys) {
+            cached.emplace_back(edgeKey.get_src());
+        }
+    }
     time::Duration deleteEdgeTime;
     return qctx()->getStorageClient()->deleteEdges(spaceId, std::move(edgeKeys))
             .via(runner())
             .ensure([deleteEdgeTime]() {
                 VLOG(1) << "Delete edge time: " << deleteEdgeTime.elapsedInUSec() << "us";
             })
-            .then([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
+            .then([this, spaceId, cached = std::move(cached)](
+                      storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
                 SCOPED_TIMER(&execTime_);
+                for (auto &vid : cached) {
+                    qctx()->neighborCache()->evict(spaceId, vid);
+                }
                 NG_RETURN_IF_ERROR(handleCompleteness(resp, true));
                 return Status::OK();
             });
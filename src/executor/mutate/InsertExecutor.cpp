@@ -22,18 +22,34 @@ folly::Future<Status> InsertVerticesExecutor::insertVertices() {
 
     auto *ivNode = asNode<InsertVertices>(node());
     time::Duration addVertTime;
-    return qctx()->getStorageClient()->addVertices(ivNode->getSpace(),
-                                                   ivNode->getVertices(),
-                                                   ivNode->getPropNames(),
-                                                   ivNode->getOverwritable())
-        .via(runner())
+    auto sender = [this, ivNode](std::vector<storage::cpp2::NewVertex> vertices) {
+        // The vertices are moved into the request, keep their ids to evict
+        std::vector<Value> vids;
+        if (hasCache()) {
+            vids.reserve(vertices.size());
+            for (auto &vertex : vertices) {
+                vids.emplace_back(vertex.get_id());
+            }
+        }
+        return qctx()->getStorageClient()->addVertices(ivNode->getSpace(),
+                                                       std::move(vertices),
+                                                       ivNode->getPropNames(),
+                                                       ivNode->getOverwritable())
+            .via(runner())
+            .then([this, ivNode, vids = std::move(vids)](
+                      storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
+                SCOPED_TIMER(&execTime_);
+                // The vertices may be written even if some parts failed
+                for (auto &vid : vids) {
+                    evictVertex(ivNode->getSpace(), vid);
+                }
+                NG_RETURN_IF_ERROR(handleCompleteness(resp, true));
+                return Status::OK();
+            });
+    };
+    return sendInBatches<storage::cpp2::NewVertex>(ivNode->getVertices(), std::move(sender))
         .ensure([addVertTime]() {
             VLOG(1) << "Add vertices time: " << addVertTime.elapsedInUSec() << "us";
-        })
-        .then([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
-            SCOPED_TIMER(&execTime_);
-            NG_RETURN_IF_ERROR(handleCompleteness(resp, true));
-            return Status::OK();
         });
 }
 
@@ -46,21 +62,37 @@ folly::Future<Status> InsertEdgesExecutor::insertEdges() {
 
     auto *ieNode = asNode<InsertEdges>(node());
     time::Duration addEdgeTime;
-    return qctx()->getStorageClient()->addEdges(ieNode->getSpace(),
-                                                ieNode->getEdges(),
-                                                ieNode->getPropNames(),
-                                                ieNode->getOverwritable(),
-                                                nullptr,
-                                                ieNode->useChainInsert())
+    auto sender = [this, ieNode](std::vector<storage::cpp2::NewEdge> edges) {
+        // The edges are moved into the request, keep their ends to evict
+        std::vector<std::pair<Value, Value>> ends;
+        if (hasCache()) {
+            ends.reserve(edges.size());
+            for (auto &edge : edges) {
+                auto &key = edge.get_key();
+                ends.emplace_back(key.get_src(), key.get_dst());
+            }
+        }
+        return qctx()->getStorageClient()->addEdges(ieNode->getSpace(),
+                                                    std::move(edges),
+                                                    ieNode->getPropNames(),
+                                                    ieNode->getOverwritable(),
+                                                    nullptr,
+                                                    ieNode->useChainInsert())
             .via(runner())
-            .ensure([addEdgeTime]() {
-                VLOG(1) << "Add edge time: " << addEdgeTime.elapsedInUSec() << "us";
-            })
-            .then([this](storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
+            .then([this, ieNode, ends = std::move(ends)](
+                      storage::StorageRpcResponse<storage::cpp2::ExecResponse> resp) {
                 SCOPED_TIMER(&execTime_);
+                for (auto &end : ends) {
+                    evictEdge(ieNode->getSpace(), end.first, end.second);
+                }
                 NG_RETURN_IF_ERROR(handleCompleteness(resp, true));
                 return Status::OK();
             });
+    };
+    return sendInBatches<storage::cpp2::NewEdge>(ieNode->getEdges(), std::move(sender))
+        .ensure([addEdgeTime]() {
+            VLOG(1) << "Add edge time: " << addEdgeTime.elapsedInUSec() << "us";
+        });
 }
 }   // namespace graph
 }   // namespace nebula
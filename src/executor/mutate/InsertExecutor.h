@@ -8,14 +8,111 @@
 #define EXECUTOR_MUTATE_INSERTVERTICESEXECUTOR_H_
 
 #include "executor/StorageAccessExecutor.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
 
-class InsertVerticesExecutor final : public StorageAccessExecutor {
+// Send the rows inserted in bounded batches, so a large insert neither copies all
+// of its rows into one request, nor waits for the whole of it to be written at once.
+class InsertExecutor : public StorageAccessExecutor {
+protected:
+    InsertExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
+        : StorageAccessExecutor(name, node, qctx) {}
+
+    // Send and handle a batch of rows
+    template <typename T>
+    using BatchSender = std::function<folly::Future<Status>(std::vector<T>)>;
+
+    // Send `rows' in batches of at most `insert_batch_size' by `sender', with at most
+    // `insert_concurrency' of them in flight. Each in-flight slot sends its next batch
+    // once the previous one is handled, and no more batches are sent after one failed.
+    template <typename T>
+    folly::Future<Status> sendInBatches(const std::vector<T> &rows, BatchSender<T> sender);
+
+private:
+    template <typename T>
+    struct Batches {
+        const std::vector<T>   *rows;
+        BatchSender<T>          sender;
+        size_t                  batchSize;
+        // Guard `next' and `status'
+        std::mutex              lock;
+        size_t                  next{0};
+        Status                  status;
+    };
+
+    template <typename T>
+    folly::Future<Status> sendBatches(std::shared_ptr<Batches<T>> batches);
+};
+
+template <typename T>
+folly::Future<Status> InsertExecutor::sendInBatches(const std::vector<T> &rows,
+                                                    BatchSender<T> sender) {
+    auto batches = std::make_shared<Batches<T>>();
+    batches->rows = &rows;
+    batches->sender = std::move(sender);
+    size_t batchSize = FLAGS_insert_batch_size;
+    batches->batchSize = batchSize == 0 ? std::max<size_t>(rows.size(), 1) : batchSize;
+    auto numBatches = std::max<size_t>((rows.size() + batches->batchSize - 1) /
+                                       batches->batchSize, 1);
+    otherStats_ = std::make_unique<std::unordered_map<std::string, std::string>>();
+    otherStats_->emplace("batches", folly::to<std::string>(numBatches));
+
+    size_t window = FLAGS_insert_concurrency;
+    window = window == 0 ? numBatches : std::min<size_t>(window, numBatches);
+    std::vector<folly::Future<Status>> futures;
+    futures.reserve(window);
+    for (size_t i = 0; i < window; ++i) {
+        futures.emplace_back(sendBatches(batches));
+    }
+    // Wait for all the slots even if some of them failed, since they refer to this executor
+    return folly::collectAll(futures).via(runner()).then(
+        [batches](std::vector<folly::Try<Status>> &&results) {
+            std::lock_guard<std::mutex> lock(batches->lock);
+            NG_RETURN_IF_ERROR(batches->status);
+            for (auto &result : results) {
+                if (result.hasException()) {
+                    return Status::Error("Insert failed: %s",
+                                         result.exception().what().c_str());
+                }
+            }
+            return Status::OK();
+        });
+}
+
+template <typename T>
+folly::Future<Status> InsertExecutor::sendBatches(std::shared_ptr<Batches<T>> batches) {
+    std::vector<T> batch;
+    {
+        std::lock_guard<std::mutex> lock(batches->lock);
+        auto &rows = *batches->rows;
+        // An empty insert is still sent once, as it was before batching
+        if (!batches->status.ok() || (batches->next >= rows.size() && batches->next > 0)) {
+            return folly::makeFuture(Status::OK());
+        }
+        auto begin = batches->next;
+        auto end = std::min(begin + batches->batchSize, rows.size());
+        batches->next = std::max<size_t>(end, 1);
+        // Only the batches in flight are copied into the requests
+        batch.assign(rows.begin() + begin, rows.begin() + end);
+    }
+    return batches->sender(std::move(batch)).via(runner()).then([this, batches](Status status) {
+        if (!status.ok()) {
+            std::lock_guard<std::mutex> lock(batches->lock);
+            if (batches->status.ok()) {
+                batches->status = std::move(status);
+            }
+            return folly::makeFuture(Status::OK());
+        }
+        return sendBatches(batches);
+    });
+}
+
+class InsertVerticesExecutor final : public InsertExecutor {
 public:
     InsertVerticesExecutor(const PlanNode *node, QueryContext *qctx)
-        : StorageAccessExecutor("InsertVerticesExecutor", node, qctx) {}
+        : InsertExecutor("InsertVerticesExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
 
@@ -23,10 +120,10 @@ private:
     folly::Future<Status> insertVertices();
 };
 
-class InsertEdgesExecutor final : public StorageAccessExecutor {
+class InsertEdgesExecutor final : public InsertExecutor {
 public:
     InsertEdgesExecutor(const PlanNode *node, QueryContext *qctx)
-        : StorageAccessExecutor("InsertEdgesExecutor", node, qctx) {}
+        : InsertExecutor("InsertEdgesExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
 
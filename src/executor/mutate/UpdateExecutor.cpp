@@ -56,8 +56,9 @@ folly::Future<Status> UpdateVertexExecutor::execute() {
         .ensure([updateVertTime]() {
             VLOG(1) << "Update vertice time: " << updateVertTime.elapsedInUSec() << "us";
         })
-        .then([this](StatusOr<storage::cpp2::UpdateResponse> resp) {
+        .then([this, uvNode](StatusOr<storage::cpp2::UpdateResponse> resp) {
             SCOPED_TIMER(&execTime_);
+            evictVertex(uvNode->getSpaceId(), uvNode->getVId());
             if (!resp.ok()) {
                 LOG(ERROR) << resp.status();
                 return resp.status();
@@ -101,8 +102,9 @@ folly::Future<Status> UpdateEdgeExecutor::execute() {
             .ensure([updateEdgeTime]() {
                 VLOG(1) << "Update edge time: " << updateEdgeTime.elapsedInUSec() << "us";
             })
-            .then([this](StatusOr<storage::cpp2::UpdateResponse> resp) {
+            .then([this, ueNode](StatusOr<storage::cpp2::UpdateResponse> resp) {
                 SCOPED_TIMER(&execTime_);
+                evictEdge(ueNode->getSpaceId(), ueNode->getSrcId(), ueNode->getDstId());
                 if (!resp.ok()) {
                     LOG(ERROR) << "Update edge failed: " << resp.status();
                     return resp.status();
@@ -6,12 +6,19 @@
 
 #include "executor/query/AggregateExecutor.h"
 
+#include <deque>
+#include <limits>
+
 #include "common/datatypes/List.h"
 #include "common/expression/AggregateExpression.h"
+#include "context/ColumnBatch.h"
 #include "context/QueryExpressionContext.h"
 #include "context/Result.h"
 #include "planner/PlanNode.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
+#include "util/CompiledExpr.h"
+#include "util/MemoryUtil.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -20,52 +27,519 @@ namespace graph {
 folly::Future<Status> AggregateExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* agg = asNode<Aggregate>(node());
-    auto groupKeys = agg->groupKeys();
-    auto groupItems = agg->groupItems();
-    auto iter = ectx_->getResult(agg->inputVar()).iter();
-    DCHECK(!!iter);
-    QueryExpressionContext ctx(ectx_);
+    iter_ = ectx_->getResult(agg->inputVar()).iter();
+    DCHECK(!!iter_);
+
+    // Each job aggregates its morsel into partial groups first, which are radix partitioned
+    // by the hash of group key, so one group only lives in one partition and the partial
+    // groups of each partition could be merged independently.
+    auto totalSize = iter_->size();
+    mergeable_ = makeMerges();
+    auto batchSize = mergeable_ ? getBatchSize(totalSize) : std::max<size_t>(totalSize, 1);
+    numJobs_ = std::max<size_t>((totalSize + batchSize - 1) / batchSize, 1);
+    // Under a memory budget the partial groups may be spilled, so make more partitions than
+    // jobs to merge only a part of the groups in memory at one time.
+    size_t numParts =
+        FLAGS_query_memory_budget_bytes > 0 && mergeable_ ? numJobs_ * kSpillFanout : numJobs_;
 
-    std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
-    for (; iter->valid(); iter->next()) {
-        List list;
-        for (auto* key : groupKeys) {
-            list.values.emplace_back(key->eval(ctx(iter.get())));
+    auto scatter = [this, numParts](size_t begin, size_t end, Iterator* tmpIter) {
+        return preAggregateJob(begin, end, tmpIter, numParts);
+    };
+    auto gather = [this, numParts](std::vector<StatusOr<std::vector<Partition>>> results) {
+        parts_.resize(numParts);
+        size_t bytes = 0;
+        for (auto& result : results) {
+            if (!result.ok()) {
+                return folly::makeFuture(result.status());
+            }
+            auto& jobParts = result.value();
+            for (size_t i = 0; i < numParts; ++i) {
+                bytes += jobParts[i].bytes;
+                parts_[i].emplace_back(std::move(jobParts[i]));
+            }
+        }
+        // Account the partial groups kept in memory as the working set until merged
+        auto reserved = reserveMemory(static_cast<int64_t>(bytes));
+        if (!reserved.ok()) {
+            return folly::makeFuture(reserved.status());
         }
+        partsMemory_ = std::move(reserved).value();
+        result_.colNames = asNode<Aggregate>(node())->colNames();
+        return aggregate(0);
+    };
+    return runMultiJobs(std::move(scatter), std::move(gather), iter_.get(), batchSize);
+}
 
-        auto it = result.find(list);
-        if (it == result.end()) {
-           std::vector<std::unique_ptr<AggData>> cols;
-           for (size_t i = 0; i < groupItems.size(); ++i) {
-               cols.emplace_back(new AggData());
-           }
-           result.emplace(std::make_pair(list, std::move(cols)));
-        } else {
-            DCHECK_EQ(it->second.size(), groupItems.size());
+Status AggregateExecutor::close() {
+    iter_.reset();
+    parts_.clear();
+    partsMemory_.reset();
+    result_ = DataSet();
+    return Executor::close();
+}
+
+bool AggregateExecutor::makeMerges() {
+    auto& groupItems = asNode<Aggregate>(node())->groupItems();
+    // Each item is aggregated as is by the only job unless all of them could be merged
+    auto unmergeable = [this, &groupItems]() {
+        merges_.assign(groupItems.size(), Merge::kAny);
+        numPartials_ = groupItems.size();
+        return false;
+    };
+    merges_.clear();
+    numPartials_ = 0;
+    for (auto* item : groupItems) {
+        if (item->kind() != Expression::Kind::kAggregate) {
+            merges_.emplace_back(Merge::kAny);
+            numPartials_++;
+            continue;
+        }
+        auto* aggExpr = static_cast<AggregateExpression*>(item);
+        auto* name = aggExpr->name();
+        if (name == nullptr || name->empty()) {
+            merges_.emplace_back(Merge::kAny);
+            numPartials_++;
+            continue;
+        }
+        auto found = AggregateExpression::NAME_ID_MAP.find(name->c_str());
+        if (found == AggregateExpression::NAME_ID_MAP.end()) {
+            return unmergeable();
+        }
+        // Only the functions not changed by the duplicate values merge the distinct results
+        auto distinct = aggExpr->distinct();
+        switch (found->second) {
+            case AggregateExpression::Function::kCount:
+            case AggregateExpression::Function::kSum:
+                if (distinct) {
+                    return unmergeable();
+                }
+                merges_.emplace_back(Merge::kAdd);
+                break;
+            case AggregateExpression::Function::kAvg:
+                if (distinct) {
+                    return unmergeable();
+                }
+                merges_.emplace_back(Merge::kAvg);
+                numPartials_++;
+                break;
+            case AggregateExpression::Function::kMax:
+                merges_.emplace_back(Merge::kMax);
+                break;
+            case AggregateExpression::Function::kMin:
+                merges_.emplace_back(Merge::kMin);
+                break;
+            case AggregateExpression::Function::kBitAnd:
+                merges_.emplace_back(Merge::kBitAnd);
+                break;
+            case AggregateExpression::Function::kBitOr:
+                merges_.emplace_back(Merge::kBitOr);
+                break;
+            case AggregateExpression::Function::kBitXor:
+                if (distinct) {
+                    return unmergeable();
+                }
+                merges_.emplace_back(Merge::kBitXor);
+                break;
+            case AggregateExpression::Function::kCollect:
+                if (distinct) {
+                    return unmergeable();
+                }
+                merges_.emplace_back(Merge::kConcat);
+                break;
+            case AggregateExpression::Function::kCollectSet:
+                merges_.emplace_back(Merge::kUnion);
+                break;
+            default:
+                // e.g. STD, whose partial results couldn't be merged exactly
+                return unmergeable();
+        }
+        numPartials_++;
+    }
+    return true;
+}
+
+std::vector<std::unique_ptr<Expression>> AggregateExecutor::makePartialItems() const {
+    auto& groupItems = asNode<Aggregate>(node())->groupItems();
+    std::vector<std::unique_ptr<Expression>> items;
+    items.reserve(numPartials_);
+    for (size_t i = 0; i < groupItems.size(); ++i) {
+        auto* item = groupItems[i];
+        if (merges_[i] == Merge::kAvg) {
+            // AVG is merged by the SUM and COUNT of its argument
+            auto* arg = static_cast<AggregateExpression*>(item)->arg();
+            items.emplace_back(
+                new AggregateExpression(new std::string("SUM"), arg->clone().release(), false));
+            items.emplace_back(
+                new AggregateExpression(new std::string("COUNT"), arg->clone().release(), false));
+            continue;
+        }
+        // Expression keeps the evaluation result in itself, so each job evaluates its own copy
+        items.emplace_back(item->clone());
+    }
+    return items;
+}
+
+folly::Future<Status> AggregateExecutor::aggregate(size_t first) {
+    if (first >= parts_.size()) {
+        partsMemory_.reset();
+        return finish(ResultBuilder().value(Value(std::move(result_))).finish());
+    }
+
+    // Merge at most `numJobs_' partitions concurrently
+    auto last = std::min(first + numJobs_, parts_.size());
+    std::vector<folly::Future<StatusOr<std::vector<Row>>>> futures;
+    futures.reserve(last - first);
+    for (auto i = first; i < last; ++i) {
+        futures.emplace_back(folly::via(runner(), [this, i]() { return mergeJob(parts_[i]); }));
+    }
+    return folly::collect(futures).via(runner()).then(
+        [this, first, last](std::vector<StatusOr<std::vector<Row>>> results) {
+            SCOPED_TIMER(&execTime_);
+            for (auto i = first; i < last; ++i) {
+                // Release the partial groups and spill files of the merged partitions
+                parts_[i].clear();
+            }
+            for (auto& result : results) {
+                if (!result.ok()) {
+                    return folly::makeFuture(result.status());
+                }
+                auto& rows = result.value();
+                result_.rows.insert(result_.rows.end(),
+                                    std::make_move_iterator(rows.begin()),
+                                    std::make_move_iterator(rows.end()));
+            }
+            return aggregate(last);
+        });
+}
+
+StatusOr<std::vector<AggregateExecutor::Partition>> AggregateExecutor::preAggregateJob(
+    size_t begin,
+    size_t end,
+    Iterator* iter,
+    size_t numParts) {
+    auto* agg = asNode<Aggregate>(node());
+    // Expression keeps the evaluation result in itself, so each job evaluates its own copy
+    std::vector<std::unique_ptr<Expression>> groupKeys;
+    groupKeys.reserve(agg->groupKeys().size());
+    for (auto* key : agg->groupKeys()) {
+        groupKeys.emplace_back(key->clone());
+    }
+    auto items = makePartialItems();
+    auto numItems = items.size();
+
+    // Each job could hold its share of the memory budget. The groups are only spilled if
+    // their partial results could be merged, otherwise all of them are held by one job.
+    size_t budget = FLAGS_query_memory_budget_bytes > 0 && mergeable_
+                        ? FLAGS_query_memory_budget_bytes / numJobs_
+                        : std::numeric_limits<size_t>::max();
+    size_t memBytes = 0;
+    // All the partitions of a job spill to one file, so the open files don't grow with the
+    // partitions
+    std::shared_ptr<SpillFile> file;
+    std::vector<Partition> parts(numParts);
+
+    // The groups aggregated since the last flush. The AggData of all groups are allocated
+    // from the arena, and group N owns the range [N * numItems, (N + 1) * numItems).
+    std::deque<PartialGroup> groups;
+    std::unordered_map<const PartialGroup*, size_t, GroupHash, GroupEqual> index;
+    std::deque<AggData> arena;
+
+    // Move the groups to their partitions with the partial results aggregated so far
+    auto flush = [&]() {
+        for (size_t group = 0; group < groups.size(); ++group) {
+            auto& partial = groups[group];
+            partial.partials.reserve(numItems);
+            auto bytes = sizeof(PartialGroup) + MemoryUtil::estimateSize(partial.key);
+            for (size_t i = 0; i < numItems; ++i) {
+                partial.partials.emplace_back(arena[group * numItems + i].result());
+                bytes += MemoryUtil::estimateSize(partial.partials.back());
+            }
+            auto& part = parts[partial.hash % numParts];
+            part.bytes += bytes;
+            part.groups.emplace_back(std::move(partial));
         }
+        index.clear();
+        groups.clear();
+        arena.clear();
+    };
 
-        for (size_t i = 0; i < groupItems.size(); ++i) {
-            auto* item = groupItems[i];
+    QueryExpressionContext ctx(ectx_);
+    auto aggregateRow = [&](List&& key, Iterator* row) -> Status {
+        PartialGroup probe;
+        probe.hash = std::hash<List>()(key);
+        probe.key = std::move(key);
+        size_t group = 0;
+        auto found = index.find(&probe);
+        if (found != index.end()) {
+            group = found->second;
+        } else {
+            group = groups.size();
+            memBytes += sizeof(PartialGroup) + MemoryUtil::estimateSize(probe.key) +
+                        numItems * sizeof(AggData);
+            groups.emplace_back(std::move(probe));
+            index.emplace(&groups.back(), group);
+            for (size_t i = 0; i < numItems; ++i) {
+                arena.emplace_back();
+            }
+        }
+        for (size_t i = 0; i < numItems; ++i) {
+            auto* item = items[i].get();
+            auto* aggData = &arena[group * numItems + i];
             if (item->kind() == Expression::Kind::kAggregate) {
-                static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
-                item->eval(ctx(iter.get()));
+                static_cast<AggregateExpression*>(item)->setAggData(aggData);
+                item->eval(ctx(row));
             } else {
-                result[list][i]->setResult(item->eval(ctx(iter.get())));
+                aggData->setResult(item->eval(ctx(row)));
+            }
+        }
+        if (memBytes > budget) {
+            VLOG(1) << node()->outputVar() << " spills partial groups of rows from " << begin;
+            flush();
+            NG_RETURN_IF_ERROR(spill(parts, file));
+            memBytes = 0;
+        }
+        return Status::OK();
+    };
+
+    auto vectorized = makeVectorizedKeys(groupKeys, iter);
+    if (!vectorized.empty()) {
+        for (size_t i = begin; i < end; i += VectorizedExpr::kBatchSize) {
+            ColumnBatch batch(iter, i, std::min(i + VectorizedExpr::kBatchSize, end));
+            // The keys without vectorized expression are evaluated row by row
+            std::vector<Column> columns;
+            columns.reserve(groupKeys.size());
+            for (auto& v : vectorized) {
+                if (v != nullptr) {
+                    columns.emplace_back(v->eval(&batch, ctx));
+                } else {
+                    columns.emplace_back(Column::Type::kValue, 0);
+                }
+            }
+            for (size_t j = 0; j < batch.size(); ++j) {
+                auto* row = batch.rowAt(j);
+                List key;
+                key.values.reserve(groupKeys.size());
+                for (size_t k = 0; k < groupKeys.size(); ++k) {
+                    if (vectorized[k] != nullptr) {
+                        key.values.emplace_back(columns[k].value(j));
+                    } else {
+                        key.values.emplace_back(groupKeys[k]->eval(ctx(row)));
+                    }
+                }
+                NG_RETURN_IF_ERROR(aggregateRow(std::move(key), row));
+            }
+        }
+    } else {
+        // Resolve the properties for the input once instead of looking up them for each row
+        std::vector<std::unique_ptr<CompiledExpr>> compiled;
+        if (FLAGS_enable_compiled_expr) {
+            for (auto& key : groupKeys) {
+                compiled.emplace_back(CompiledExpr::compile(key.get(), iter));
+            }
+        }
+
+        for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
+            List key;
+            key.values.reserve(groupKeys.size());
+            for (size_t k = 0; k < groupKeys.size(); ++k) {
+                if (!compiled.empty() && compiled[k] != nullptr) {
+                    key.values.emplace_back(compiled[k]->eval(iter, ctx));
+                } else {
+                    key.values.emplace_back(groupKeys[k]->eval(ctx(iter)));
+                }
+            }
+            NG_RETURN_IF_ERROR(aggregateRow(std::move(key), iter));
+        }
+    }
+    flush();
+    if (file != nullptr) {
+        NG_RETURN_IF_ERROR(file->flush());
+    }
+    return parts;
+}
+
+std::vector<std::unique_ptr<VectorizedExpr>> AggregateExecutor::makeVectorizedKeys(
+    const std::vector<std::unique_ptr<Expression>>& groupKeys,
+    Iterator* iter) const {
+    std::vector<std::unique_ptr<VectorizedExpr>> vectorized;
+    if (!FLAGS_enable_vectorized || !iter->isSequentialIter()) {
+        return vectorized;
+    }
+    auto& colIndices = static_cast<SequentialIter*>(iter)->getColIndices();
+    bool any = false;
+    for (auto& key : groupKeys) {
+        vectorized.emplace_back(VectorizedExpr::make(key.get(), colIndices));
+        any = any || vectorized.back() != nullptr;
+    }
+    if (!any) {
+        vectorized.clear();
+    }
+    return vectorized;
+}
+
+Status AggregateExecutor::spill(std::vector<Partition>& parts,
+                                std::shared_ptr<SpillFile>& file) const {
+    if (file == nullptr) {
+        auto ret = SpillFile::create(FLAGS_spill_dir);
+        NG_RETURN_IF_ERROR(ret);
+        file = std::move(ret).value();
+    }
+    Row row;
+    for (auto& part : parts) {
+        if (part.groups.empty()) {
+            continue;
+        }
+        auto offset = file->bytes();
+        for (auto& group : part.groups) {
+            // | hash | key1 | key2 | ... | partial1 | partial2 | ...
+            row.values.clear();
+            row.values.reserve(group.key.values.size() + group.partials.size() + 1);
+            row.values.emplace_back(static_cast<int64_t>(group.hash));
+            row.values.insert(row.values.end(),
+                              std::make_move_iterator(group.key.values.begin()),
+                              std::make_move_iterator(group.key.values.end()));
+            row.values.insert(row.values.end(),
+                              std::make_move_iterator(group.partials.begin()),
+                              std::make_move_iterator(group.partials.end()));
+            NG_RETURN_IF_ERROR(file->write(row));
+        }
+        part.file = file;
+        part.segments.emplace_back(offset, file->bytes());
+        part.groups.clear();
+        part.groups.shrink_to_fit();
+        part.bytes = 0;
+    }
+    return Status::OK();
+}
+
+StatusOr<std::vector<Row>> AggregateExecutor::mergeJob(std::vector<Partition>& parts) const {
+    auto numKeys = asNode<Aggregate>(node())->groupKeys().size();
+    std::deque<PartialGroup> merged;
+    std::unordered_map<const PartialGroup*, size_t, GroupHash, GroupEqual> index;
+    // Merge the partial groups of each job in the input order, so e.g. COLLECT keeps the
+    // order of rows
+    auto mergeGroup = [&](PartialGroup&& group) {
+        auto found = index.find(&group);
+        if (found == index.end()) {
+            merged.emplace_back(std::move(group));
+            index.emplace(&merged.back(), merged.size() - 1);
+            return;
+        }
+        auto& into = merged[found->second].partials;
+        for (size_t i = 0, item = 0; item < merges_.size(); ++item) {
+            auto kind = merges_[item] == Merge::kAvg ? Merge::kAdd : merges_[item];
+            merge(kind, into[i], std::move(group.partials[i]));
+            i++;
+            if (merges_[item] == Merge::kAvg) {
+                merge(kind, into[i], std::move(group.partials[i]));
+                i++;
+            }
+        }
+    };
+
+    for (auto& part : parts) {
+        for (auto& segment : part.segments) {
+            SpillFile::Reader reader(part.file.get(), segment.first, segment.second);
+            Row row;
+            while (true) {
+                auto hasNext = reader.read(&row);
+                NG_RETURN_IF_ERROR(hasNext);
+                if (!hasNext.value()) {
+                    break;
+                }
+                PartialGroup group;
+                group.hash = static_cast<size_t>(row.values[0].getInt());
+                auto keyEnd = row.values.begin() + 1 + numKeys;
+                group.key.values.assign(std::make_move_iterator(row.values.begin() + 1),
+                                        std::make_move_iterator(keyEnd));
+                group.partials.assign(std::make_move_iterator(keyEnd),
+                                      std::make_move_iterator(row.values.end()));
+                mergeGroup(std::move(group));
             }
         }
+        for (auto& group : part.groups) {
+            mergeGroup(std::move(group));
+        }
     }
 
-    DataSet ds;
-    ds.colNames = agg->colNames();
-    ds.rows.reserve(result.size());
-    for (auto& kv : result) {
-        Row row;
-        for (auto& v : kv.second) {
-            row.values.emplace_back(v->result());
+    std::vector<Row> rows;
+    rows.reserve(merged.size());
+    for (auto& group : merged) {
+        rows.emplace_back(finalRow(std::move(group.partials)));
+    }
+    return rows;
+}
+
+void AggregateExecutor::merge(Merge kind, Value& into, Value&& from) {
+    // The functions skip NULL, so it's left by a job whose rows of the group are all NULL
+    if (from.isNull() || from.isEmpty()) {
+        return;
+    }
+    if (into.isNull() || into.isEmpty()) {
+        into = std::move(from);
+        return;
+    }
+    switch (kind) {
+        case Merge::kAny:
+            break;
+        case Merge::kAdd:
+        case Merge::kAvg:
+            into = into + from;
+            break;
+        case Merge::kMax:
+            if (into < from) {
+                into = std::move(from);
+            }
+            break;
+        case Merge::kMin:
+            if (from < into) {
+                into = std::move(from);
+            }
+            break;
+        case Merge::kBitAnd:
+            into = into & from;
+            break;
+        case Merge::kBitOr:
+            into = into | from;
+            break;
+        case Merge::kBitXor:
+            into = into ^ from;
+            break;
+        case Merge::kConcat: {
+            auto& values = from.mutableList().values;
+            into.mutableList().values.insert(into.mutableList().values.end(),
+                                             std::make_move_iterator(values.begin()),
+                                             std::make_move_iterator(values.end()));
+            break;
+        }
+        case Merge::kUnion: {
+            auto& values = from.getSet().values;
+            into.mutableSet().values.insert(values.begin(), values.end());
+            break;
+        }
+    }
+}
+
+Row AggregateExecutor::finalRow(std::vector<Value>&& partials) const {
+    Row row;
+    row.values.reserve(merges_.size());
+    for (size_t i = 0, item = 0; item < merges_.size(); ++item) {
+        if (merges_[item] != Merge::kAvg) {
+            row.values.emplace_back(std::move(partials[i++]));
+            continue;
+        }
+        auto& sum = partials[i++];
+        auto& count = partials[i++];
+        if (!count.isInt() || count.getInt() == 0) {
+            row.values.emplace_back(Value::kNullValue);
+        } else if (!sum.isNumeric()) {
+            row.values.emplace_back(std::move(sum));
+        } else {
+            auto total = sum.isInt() ? static_cast<double>(sum.getInt()) : sum.getFloat();
+            row.values.emplace_back(total / count.getInt());
         }
-        ds.rows.emplace_back(std::move(row));
     }
-    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+    return row;
 }
 
 }   // namespace graph
@@ -7,7 +7,10 @@
 #ifndef EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 #define EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 
+#include "common/datatypes/List.h"
 #include "executor/Executor.h"
+#include "util/SpillFile.h"
+#include "util/VectorizedExpr.h"
 
 namespace nebula {
 namespace graph {
@@ -18,6 +21,107 @@ public:
         : Executor("AggregateExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+    Status close() override;
+
+private:
+    // How the partial results of a group item aggregated by each job are merged
+    enum class Merge : uint8_t {
+        // Not an aggregate, e.g. a group key, so the results of all jobs are the same
+        kAny,
+        kAdd,
+        kMax,
+        kMin,
+        kBitAnd,
+        kBitOr,
+        kBitXor,
+        kConcat,
+        kUnion,
+        // Aggregated as SUM and COUNT, whose partial results are added
+        kAvg,
+    };
+
+    // The partial results of one group aggregated by one job, the hash of key is computed once
+    struct PartialGroup {
+        size_t hash;
+        List key;
+        std::vector<Value> partials;
+    };
+
+    struct GroupHash {
+        size_t operator()(const PartialGroup *group) const {
+            return group->hash;
+        }
+    };
+
+    struct GroupEqual {
+        bool operator()(const PartialGroup *lhs, const PartialGroup *rhs) const {
+            return lhs->hash == rhs->hash && lhs->key == rhs->key;
+        }
+    };
+
+    // Partial groups of one partition produced by one job. Each time the job exceeds its
+    // memory budget, the groups held by then are spilled to the file of the job as a segment
+    // of each partition, and the segments hold the groups aggregated before the ones in memory.
+    struct Partition {
+        std::vector<PartialGroup> groups;
+        // The estimated bytes of `groups'
+        size_t bytes{0};
+        std::shared_ptr<SpillFile> file;
+        // The [begin, end) offsets of each spilled segment in `file'
+        std::vector<std::pair<size_t, size_t>> segments;
+    };
+
+    // Number of partitions of each job when the memory budget is enabled
+    static constexpr size_t kSpillFanout = 16;
+
+    // Decide how the partial results of each group item are merged. Return false if any of
+    // them couldn't be merged, then all rows are aggregated by one job.
+    bool makeMerges();
+
+    // The expressions aggregating the partial results of the group items, cloned for each job
+    std::vector<std::unique_ptr<Expression>> makePartialItems() const;
+
+    // Aggregate rows [begin, end) into partial groups and partition them by the key hash
+    StatusOr<std::vector<Partition>> preAggregateJob(size_t begin,
+                                                     size_t end,
+                                                     Iterator *iter,
+                                                     size_t numParts);
+
+    // The vectorized expressions of group keys, nullptr for the key evaluated row by row.
+    // Empty if none of the keys could be vectorized.
+    std::vector<std::unique_ptr<VectorizedExpr>> makeVectorizedKeys(
+        const std::vector<std::unique_ptr<Expression>> &groupKeys,
+        Iterator *iter) const;
+
+    // Spill the groups of `parts' to `file', which is created at the first time
+    Status spill(std::vector<Partition> &parts, std::shared_ptr<SpillFile> &file) const;
+
+    // Aggregate the partitions from `first', and the following ones after them
+    folly::Future<Status> aggregate(size_t first);
+
+    // Merge the partial groups of one partition, which are collected from each job
+    StatusOr<std::vector<Row>> mergeJob(std::vector<Partition> &parts) const;
+
+    // Merge the partial result `from' of a later job into `into'
+    static void merge(Merge kind, Value &into, Value &&from);
+
+    // The result of each group item from the merged partial results of a group
+    Row finalRow(std::vector<Value> &&partials) const;
+
+    size_t                                  numJobs_{1};
+    std::unique_ptr<Iterator>               iter_;
+    // Whether the partial results of all group items could be merged, so the rows are
+    // aggregated by multiple jobs and the partial groups could be spilled
+    bool                                    mergeable_{true};
+    // The merge of each group item, and the number of partial results of all of them
+    std::vector<Merge>                      merges_;
+    size_t                                  numPartials_{0};
+    // Partition -> the parts of each job
+    std::vector<std::vector<Partition>>     parts_;
+    // The partial groups held in memory by `parts_'
+    MemoryReservation                       partsMemory_;
+    DataSet                                 result_;
 };
 
 }   // namespace graph
@@ -31,7 +31,6 @@ private:
 
     Status collectAllPaths(const std::vector<std::string>& vars);
 
-    Status collectMultiplePairShortestPath(const std::vector<std::string>& vars);
 
     std::vector<std::string>    colNames_;
     Value                       result_;
@@ -9,6 +9,7 @@
 #include "planner/Query.h"
 #include "context/QueryExpressionContext.h"
 #include "context/Iterator.h"
+#include "util/MemoryUtil.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -19,6 +20,12 @@ folly::Future<Status> DataJoinExecutor::execute() {
 
 Status DataJoinExecutor::close() {
     exchange_ = false;
+    hashTable_.reset();
+    hashTableMemory_.reset();
+    buildIter_.reset();
+    probeIter_.reset();
+    buildRows_.clear();
+    resultIter_.reset();
     return Executor::close();
 }
 
@@ -53,59 +60,170 @@ folly::Future<Status> DataJoinExecutor::doInnerJoin() {
         return error(Status::Error(ss.str()));
     }
 
-    auto resultIter = std::make_unique<JoinIter>(std::move(colNames));
-    resultIter->joinIndex(lhsIter.get(), rhsIter.get());
-    auto bucketSize =
-        lhsIter->size() > rhsIter->size() ? rhsIter->size() : lhsIter->size();
-    hashTable_ = std::make_unique<HashTable>(bucketSize);
-
-    if (!(lhsIter->empty() || rhsIter->empty())) {
-        if (lhsIter->size() < rhsIter->size()) {
-            buildHashTable(dataJoin->hashKeys(), lhsIter.get());
-            probe(dataJoin->probeKeys(), rhsIter.get(), resultIter.get());
-        } else {
-            exchange_ = true;
-            buildHashTable(dataJoin->probeKeys(), rhsIter.get());
-            probe(dataJoin->hashKeys(), lhsIter.get(), resultIter.get());
-        }
+    resultIter_ = std::make_unique<JoinIter>(std::move(colNames));
+    resultIter_->joinIndex(lhsIter.get(), rhsIter.get());
+
+    if (lhsIter->empty() || rhsIter->empty()) {
+        return finish(ResultBuilder().iter(std::move(resultIter_)).finish());
     }
-    return finish(ResultBuilder().iter(std::move(resultIter)).finish());
+
+    std::vector<Expression*> probeKeys;
+    folly::Future<Status> built = folly::makeFuture(Status::OK());
+    if (lhsIter->size() < rhsIter->size()) {
+        buildIter_ = std::move(lhsIter);
+        probeIter_ = std::move(rhsIter);
+        probeKeys = dataJoin->probeKeys();
+        built = buildHashTable(dataJoin->hashKeys(), buildIter_.get());
+    } else {
+        exchange_ = true;
+        buildIter_ = std::move(rhsIter);
+        probeIter_ = std::move(lhsIter);
+        probeKeys = dataJoin->hashKeys();
+        built = buildHashTable(dataJoin->probeKeys(), buildIter_.get());
+    }
+    return std::move(built).then([this, probeKeys = std::move(probeKeys)](Status status) {
+        if (!status.ok()) {
+            return folly::makeFuture(std::move(status));
+        }
+        return probe(probeKeys, probeIter_.get());
+    });
 }
 
-void DataJoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
-                                      Iterator* iter) {
-    QueryExpressionContext ctx(ectx_);
+folly::Future<Status> DataJoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
+                                                       Iterator* iter) {
+    // The hash table refers to the logical rows of `iter' rather than the ones of the
+    // iterator copies in jobs, which are released once the job finishes.
+    buildRows_.reserve(iter->size());
     for (; iter->valid(); iter->next()) {
-        List list;
-        list.values.reserve(hashKeys.size());
-        for (auto& col : hashKeys) {
-            Value val = col->eval(ctx(iter));
-            list.values.emplace_back(std::move(val));
+        buildRows_.emplace_back(iter->row());
+    }
+    iter->reset();
+
+    auto totalSize = iter->size();
+    auto batchSize = getBatchSize(totalSize);
+    size_t numParts = std::max<size_t>((totalSize + batchSize - 1) / batchSize, 1);
+    hashTable_ = std::make_unique<HashTable>(numParts);
+
+    auto scatter = [this, hashKeys](size_t begin, size_t end, Iterator* tmpIter) {
+        // Expression keeps the evaluation result in itself, so each job evaluates its own copy
+        std::vector<std::unique_ptr<Expression>> keys;
+        keys.reserve(hashKeys.size());
+        for (auto* key : hashKeys) {
+            keys.emplace_back(key->clone());
         }
 
-        VLOG(1) << "key: " << list;
-        hashTable_->add(std::move(list), iter->row());
-    }
+        QueryExpressionContext ctx(ectx_);
+        std::vector<HashTable::Entries> parts(hashTable_->numParts());
+        for (size_t i = begin; i < end && tmpIter->valid(); ++i, tmpIter->next()) {
+            List list;
+            list.values.reserve(keys.size());
+            for (auto& key : keys) {
+                Value val = key->eval(ctx(tmpIter));
+                list.values.emplace_back(std::move(val));
+            }
+
+            VLOG(1) << "key: " << list;
+            auto hash = std::hash<List>()(list);
+            parts[hashTable_->partOf(hash)].emplace_back(hash, std::move(list), buildRows_[i]);
+        }
+        return parts;
+    };
+    auto gather = [this](std::vector<std::vector<HashTable::Entries>> results) {
+        // Account the hash table as the working set until the join finishes
+        size_t bytes = 0;
+        if (trackMemory_) {
+            bytes += buildRows_.size() * sizeof(const LogicalRow*);
+            for (auto& jobParts : results) {
+                for (auto& entries : jobParts) {
+                    for (auto& entry : entries) {
+                        // Along with its bucket head and chain
+                        bytes += sizeof(entry) + 2 * sizeof(int64_t) +
+                                 MemoryUtil::estimateSize(entry.key);
+                    }
+                }
+            }
+        }
+        auto reserved = reserveMemory(static_cast<int64_t>(bytes));
+        if (!reserved.ok()) {
+            return folly::makeFuture(reserved.status());
+        }
+        hashTableMemory_ = std::move(reserved).value();
+
+        std::vector<folly::Future<Status>> futures;
+        futures.reserve(hashTable_->numParts());
+        for (size_t part = 0; part < hashTable_->numParts(); ++part) {
+            HashTable::Entries entries;
+            for (auto& jobParts : results) {
+                entries.insert(entries.end(),
+                               std::make_move_iterator(jobParts[part].begin()),
+                               std::make_move_iterator(jobParts[part].end()));
+            }
+            futures.emplace_back(
+                folly::via(runner(), [this, part, entries = std::move(entries)]() mutable {
+                    hashTable_->build(part, std::move(entries));
+                    return Status::OK();
+                }));
+        }
+        return folly::collect(futures).via(runner()).then([](std::vector<Status> stats) {
+            for (auto& s : stats) {
+                if (!s.ok()) return s;
+            }
+            return Status::OK();
+        });
+    };
+    return runMultiJobs(std::move(scatter), std::move(gather), iter);
+}
+
+folly::Future<Status> DataJoinExecutor::probe(const std::vector<Expression*>& probeKeys,
+                                              Iterator* probeIter) {
+    auto scatter = [this, probeKeys](size_t begin, size_t end, Iterator* tmpIter) {
+        return probeJob(begin, end, tmpIter, probeKeys);
+    };
+    auto gather = [this](std::vector<std::vector<JoinIter::JoinLogicalRow>> results) {
+        SCOPED_TIMER(&execTime_);
+        size_t total = 0;
+        for (auto& rows : results) {
+            total += rows.size();
+        }
+        // Joined rows are moved into the result buffer which is allocated only once
+        resultIter_->reserve(total);
+        for (auto& rows : results) {
+            resultIter_->addRows(std::move(rows));
+        }
+        return finish(ResultBuilder().iter(std::move(resultIter_)).finish());
+    };
+    return runMultiJobs(std::move(scatter), std::move(gather), probeIter);
 }
 
-void DataJoinExecutor::probe(const std::vector<Expression*>& probeKeys,
-                             Iterator* probeIter, JoinIter* resultIter) {
+std::vector<JoinIter::JoinLogicalRow> DataJoinExecutor::probeJob(
+    size_t begin,
+    size_t end,
+    Iterator* probeIter,
+    const std::vector<Expression*>& probeKeys) {
+    std::vector<std::unique_ptr<Expression>> keys;
+    keys.reserve(probeKeys.size());
+    for (auto* key : probeKeys) {
+        keys.emplace_back(key->clone());
+    }
+
     QueryExpressionContext ctx(ectx_);
-    for (; probeIter->valid(); probeIter->next()) {
+    std::vector<JoinIter::JoinLogicalRow> joinedRows;
+    for (size_t i = begin; i < end && probeIter->valid(); ++i, probeIter->next()) {
         List list;
-        list.values.reserve(probeKeys.size());
-        for (auto& col : probeKeys) {
-            Value val = col->eval(ctx(probeIter));
+        list.values.reserve(keys.size());
+        for (auto& key : keys) {
+            Value val = key->eval(ctx(probeIter));
             list.values.emplace_back(std::move(val));
         }
 
         VLOG(1) << "probe: " << list;
-        auto range = hashTable_->get(list);
-        for (auto i = range.first; i != range.second; ++i) {
-            auto row = i->second;
+        auto* probeRow = probeIter->row();
+        auto hash = std::hash<List>()(list);
+        hashTable_->forEachMatch(hash, list, [&](const LogicalRow* row) {
             std::vector<const Row*> values;
             auto& lSegs = row->segments();
-            auto& rSegs = probeIter->row()->segments();
+            auto& rSegs = probeRow->segments();
+            values.reserve(lSegs.size() + rSegs.size());
             if (exchange_) {
                 values.insert(values.end(), rSegs.begin(), rSegs.end());
                 values.insert(values.end(), lSegs.begin(), lSegs.end());
@@ -113,13 +231,30 @@ void DataJoinExecutor::probe(const std::vector<Expression*>& probeKeys,
                 values.insert(values.end(), lSegs.begin(), lSegs.end());
                 values.insert(values.end(), rSegs.begin(), rSegs.end());
             }
-            size_t size = row->size() + probeIter->row()->size();
-            JoinIter::JoinLogicalRow newRow(std::move(values), size,
-                                        &resultIter->getColIdxIndices());
-            VLOG(1) << node()->outputVar() << " : " << newRow;
-            resultIter->addRow(std::move(newRow));
-        }
+            size_t size = row->size() + probeRow->size();
+            joinedRows.emplace_back(std::move(values), size, &resultIter_->getColIdxIndices());
+            VLOG(1) << node()->outputVar() << " : " << joinedRows.back();
+        });
+    }
+    return joinedRows;
+}
+
+void DataJoinExecutor::HashTable::build(size_t part, Entries&& entries) {
+    auto& partition = parts_[part];
+    partition.entries = std::move(entries);
+    size_t numBuckets = 1;
+    while (numBuckets < partition.entries.size()) {
+        numBuckets <<= 1;
+    }
+    partition.heads.assign(numBuckets, -1);
+    partition.next.assign(partition.entries.size(), -1);
+    // Insert reversely to keep the entries of each chain in the insertion order
+    for (auto i = static_cast<int64_t>(partition.entries.size()) - 1; i >= 0; --i) {
+        auto bucket = bucketOf(partition.entries[i].hash, partition);
+        partition.next[i] = partition.heads[bucket];
+        partition.heads[bucket] = i;
     }
 }
+
 }  // namespace graph
 }  // namespace nebula
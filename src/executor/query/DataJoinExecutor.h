@@ -14,35 +14,68 @@ namespace graph {
 
 class DataJoinExecutor final : public Executor {
 public:
+    // The hash table is radix partitioned by the hash of key, so each partition could be
+    // built and probed independently. The key hash is stored inline with each entry to
+    // skip comparing the keys which are known to mismatch.
     class HashTable final {
     public:
-        using Table = std::vector<std::multimap<List, const LogicalRow*>>;
+        struct Entry {
+            Entry(size_t h, List k, const LogicalRow* r) : hash(h), key(std::move(k)), row(r) {}
 
-        explicit HashTable(size_t bucketSize) : bucketSize_(bucketSize) {
-            table_ =
-                std::vector<std::multimap<List, const LogicalRow*>>(bucketSize);
+            size_t              hash;
+            List                key;
+            const LogicalRow*   row;
+        };
+
+        using Entries = std::vector<Entry>;
+
+        explicit HashTable(size_t numParts) : parts_(numParts) {}
+
+        size_t numParts() const {
+            return parts_.size();
         }
 
-        void add(List key, const LogicalRow* row) {
-            auto hash = std::hash<List>()(key);
-            auto bucket = hash % bucketSize_;
-            table_[bucket].emplace(std::move(key), row);
+        size_t partOf(size_t hash) const {
+            return hash % parts_.size();
         }
 
-        auto get(List& key) const {
-            auto hash = std::hash<List>()(key);
-            auto bucket = hash % bucketSize_;
-            return table_[bucket].equal_range(key);
+        // Build the partition `part' from its entries, different partitions could be built
+        // concurrently.
+        void build(size_t part, Entries&& entries);
+
+        // Call `f' on each row matching the key, in the insertion order
+        template <typename F>
+        void forEachMatch(size_t hash, const List& key, F&& f) const {
+            auto& part = parts_[partOf(hash)];
+            if (part.heads.empty()) {
+                return;
+            }
+            for (auto idx = part.heads[bucketOf(hash, part)]; idx >= 0; idx = part.next[idx]) {
+                auto& entry = part.entries[idx];
+                if (entry.hash == hash && entry.key == key) {
+                    f(entry.row);
+                }
+            }
         }
 
         void clear() {
-            bucketSize_ = 0;
-            table_.clear();
+            parts_.clear();
         }
 
     private:
-        size_t  bucketSize_{0};
-        Table   table_;
+        // Entries of the same bucket are chained by `next', -1 for the end of chain
+        struct Partition {
+            Entries                 entries;
+            std::vector<int64_t>    heads;
+            std::vector<int64_t>    next;
+        };
+
+        size_t bucketOf(size_t hash, const Partition& part) const {
+            // The low bits of hash are consumed by partitioning
+            return (hash / parts_.size()) & (part.heads.size() - 1);
+        }
+
+        std::vector<Partition>  parts_;
     };
 
     DataJoinExecutor(const PlanNode *node, QueryContext *qctx)
@@ -55,14 +88,25 @@ public:
 private:
     folly::Future<Status> doInnerJoin();
 
-    void buildHashTable(const std::vector<Expression*>& hashKeys, Iterator* iter);
+    folly::Future<Status> buildHashTable(const std::vector<Expression*>& hashKeys,
+                                         Iterator* iter);
+
+    folly::Future<Status> probe(const std::vector<Expression*>& probeKeys, Iterator* probeIter);
 
-    void probe(const std::vector<Expression*>& probeKeys, Iterator* probeiter,
-               JoinIter* resultIter);
+    std::vector<JoinIter::JoinLogicalRow> probeJob(size_t begin,
+                                                   size_t end,
+                                                   Iterator* probeIter,
+                                                   const std::vector<Expression*>& probeKeys);
 
 private:
-    bool                         exchange_{false};
-    std::unique_ptr<HashTable>   hashTable_;
+    bool                                exchange_{false};
+    std::unique_ptr<HashTable>          hashTable_;
+    MemoryReservation                   hashTableMemory_;
+    // Both sides are kept until the join finishes since the result refers to their rows
+    std::unique_ptr<Iterator>           buildIter_;
+    std::unique_ptr<Iterator>           probeIter_;
+    std::vector<const LogicalRow*>      buildRows_;
+    std::unique_ptr<JoinIter>           resultIter_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -6,10 +6,16 @@
 
 #include "executor/query/FilterExecutor.h"
 
+#include <numeric>
+
 #include "planner/Query.h"
 
+#include "context/ColumnBatch.h"
 #include "context/QueryExpressionContext.h"
+#include "service/GraphFlags.h"
+#include "util/CompiledExpr.h"
 #include "util/ScopedTimer.h"
+#include "util/VectorizedExpr.h"
 
 namespace nebula {
 namespace graph {
@@ -27,26 +33,91 @@ folly::Future<Status> FilterExecutor::execute() {
             << ", iterator type: " << static_cast<int16_t>(iter->kind())
             << ", input data size: " << iter->size();
 
-    ResultBuilder builder;
-    builder.value(iter->valuePtr());
+    auto* input = iter.get();
+    auto scatter = [this](size_t begin, size_t end, Iterator* tmpIter) {
+        return handleJob(begin, end, tmpIter);
+    };
+    auto gather = [this, iter = std::move(iter)](
+                      std::vector<StatusOr<std::vector<bool>>> results) mutable -> Status {
+        SCOPED_TIMER(&execTime_);
+        std::vector<bool> hits;
+        hits.reserve(iter->size());
+        for (auto& result : results) {
+            NG_RETURN_IF_ERROR(result);
+            auto& jobHits = result.value();
+            hits.insert(hits.end(), jobHits.begin(), jobHits.end());
+        }
+        DCHECK_EQ(hits.size(), iter->size());
+
+        // Erase rows in the same order as evaluating them one by one, `rowIdx' maps the
+        // current position of iterator to the original row index.
+        std::vector<size_t> rowIdx(iter->size());
+        std::iota(rowIdx.begin(), rowIdx.end(), 0);
+        size_t pos = 0;
+        iter->reset();
+        while (iter->valid()) {
+            if (hits[rowIdx[pos]]) {
+                iter->next();
+                ++pos;
+            } else {
+                iter->unstableErase();
+                rowIdx[pos] = rowIdx.back();
+                rowIdx.pop_back();
+            }
+        }
+
+        iter->reset();
+        ResultBuilder builder;
+        builder.value(iter->valuePtr());
+        builder.iter(std::move(iter));
+        return finish(builder.finish());
+    };
+    return runMultiJobs(std::move(scatter), std::move(gather), input);
+}
+
+StatusOr<std::vector<bool>> FilterExecutor::handleJob(size_t begin, size_t end, Iterator* iter) {
+    auto* filter = asNode<Filter>(node());
+    // Expression keeps the evaluation result in itself, so each job evaluates its own copy
+    auto condition = filter->condition()->clone();
     QueryExpressionContext ctx(ectx_);
-    auto condition = filter->condition();
-    while (iter->valid()) {
-        auto val = condition->eval(ctx(iter.get()));
+    std::vector<bool> hits;
+    hits.reserve(end - begin);
+    auto check = [&hits](const Value& val) -> Status {
         if (!val.empty() && !val.isBool() && !val.isNull()) {
             return Status::Error("Internal Error: Wrong type result, "
                                  "the type should be NULL,EMPTY or BOOL");
         }
-        if (val.empty() || val.isNull() || !val.getBool()) {
-            iter->unstableErase();
-        } else {
-            iter->next();
+        hits.push_back(!val.empty() && !val.isNull() && val.getBool());
+        return Status::OK();
+    };
+
+    if (FLAGS_enable_vectorized && iter->isSequentialIter()) {
+        auto& colIndices = static_cast<SequentialIter*>(iter)->getColIndices();
+        auto vectorized = VectorizedExpr::make(condition.get(), colIndices);
+        if (vectorized != nullptr) {
+            for (size_t i = begin; i < end; i += VectorizedExpr::kBatchSize) {
+                ColumnBatch batch(iter, i, std::min(i + VectorizedExpr::kBatchSize, end));
+                auto result = vectorized->eval(&batch, ctx);
+                for (size_t j = 0; j < result.size(); ++j) {
+                    if (result.type() == Column::Type::kBool && !result.isNull(j)) {
+                        hits.push_back(result.getBool(j));
+                    } else {
+                        NG_RETURN_IF_ERROR(check(result.value(j)));
+                    }
+                }
+            }
+            return hits;
         }
     }
 
-    iter->reset();
-    builder.iter(std::move(iter));
-    return finish(builder.finish());
+    // Resolve the properties for the input once instead of looking up them for each row
+    auto compiled =
+        FLAGS_enable_compiled_expr ? CompiledExpr::compile(condition.get(), iter) : nullptr;
+    for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
+        NG_RETURN_IF_ERROR(check(compiled != nullptr ? compiled->eval(iter, ctx)
+                                                     : condition->eval(ctx(iter))));
+    }
+    return hits;
 }
 
 }   // namespace graph
@@ -18,6 +18,10 @@ public:
         : Executor("FilterExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    // Evaluate the condition on rows [begin, end) and mark which of them are kept
+    StatusOr<std::vector<bool>> handleJob(size_t begin, size_t end, Iterator *iter);
 };
 
 }   // namespace graph
@@ -8,12 +8,16 @@
 
 #include <sstream>
 
+#include <folly/json.h>
+
 #include "common/clients/storage/GraphStorageClient.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Vertex.h"
 #include "context/QueryContext.h"
+#include "service/GraphFlags.h"
 #include "util/SchemaUtil.h"
 #include "util/ScopedTimer.h"
+#include "util/ToJson.h"
 
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetNeighborsResponse;
@@ -22,18 +26,28 @@ using nebula::storage::GraphStorageClient;
 namespace nebula {
 namespace graph {
 
+// static
+bool GetNeighborsExecutor::streaming() {
+    return FLAGS_get_neighbors_parts > 1 || FLAGS_get_neighbors_batch_size > 0;
+}
+
 folly::Future<Status> GetNeighborsExecutor::execute() {
+    if (streaming()) {
+        return collectParts();
+    }
     otherStats_ = std::make_unique<std::unordered_map<std::string, std::string>>();
     auto status = buildRequestDataSet();
     if (!status.ok()) {
         return error(std::move(status));
     }
+    lookupCache();
     return getNeighbors();
 }
 
 Status GetNeighborsExecutor::close() {
     // clear the members
     reqDs_.rows.clear();
+    hits_.values.clear();
     return Executor::close();
 }
 
@@ -67,33 +81,118 @@ Status GetNeighborsExecutor::buildRequestDataSet() {
     return Status::OK();
 }
 
+// static
+bool GetNeighborsExecutor::cacheable(const GetNeighbors* gn) {
+    // The edges of a vertex are cached as a whole, so none of them is left out by storage
+    return gn->filter().empty() && gn->orderBy().empty() && !gn->random() &&
+           gn->limit() == std::numeric_limits<int64_t>::max();
+}
+
+// static
+std::string GetNeighborsExecutor::signature(const GetNeighbors* gn) {
+    std::string sig = folly::toJson(util::toJson(gn->edgeTypes()));
+    sig.append(storage::cpp2::_EdgeDirection_VALUES_TO_NAMES.at(gn->edgeDirection()));
+    auto append = [&sig](const auto* props) {
+        sig.append(";");
+        if (props != nullptr) {
+            sig.append(folly::toJson(util::toJson(*props)));
+        }
+    };
+    append(gn->vertexProps());
+    append(gn->edgeProps());
+    append(gn->statProps());
+    append(gn->exprs());
+    sig.append(gn->dedup() ? ";dedup" : ";");
+    return sig;
+}
+
+void GetNeighborsExecutor::lookupCache() {
+    hits_.values.clear();
+    cache_ = cacheable(gn_) ? qctx()->neighborCache() : nullptr;
+    if (cache_ == nullptr) {
+        return;
+    }
+    SCOPED_TIMER(&execTime_);
+    sig_ = signature(gn_);
+    // Taken before fetching, the neighbors of the vertices written since then are not cached
+    generation_ = cache_->generation();
+    std::vector<Row> misses;
+    std::vector<RowCache::ColNames> layouts;
+    size_t numHits = 0;
+    for (auto& row : reqDs_.rows) {
+        RowCache::ColNames colNames;
+        auto cached = cache_->get(gn_->space(), row.values[0], sig_, &colNames);
+        if (cached == nullptr || colNames == nullptr) {
+            misses.emplace_back(std::move(row));
+            continue;
+        }
+        // The rows of the same columns are put into one dataset
+        size_t i = 0;
+        while (i < layouts.size() && *layouts[i] != *colNames) {
+            ++i;
+        }
+        if (i == layouts.size()) {
+            layouts.emplace_back(colNames);
+            hits_.values.emplace_back(DataSet(*colNames));
+        }
+        hits_.values[i].mutableDataSet().rows.emplace_back(*cached);
+        ++numHits;
+    }
+    if (otherStats_ != nullptr) {
+        otherStats_->emplace("cache_hits", folly::to<std::string>(numHits));
+    }
+    reqDs_.rows = std::move(misses);
+}
+
+void GetNeighborsExecutor::fillCache(const DataSet& ds) const {
+    // The rows are keyed by the vertex id in the first column
+    if (cache_ == nullptr || ds.colNames.empty() || ds.colNames.front() != kVid) {
+        return;
+    }
+    auto colNames = std::make_shared<const std::vector<std::string>>(ds.colNames);
+    for (auto& row : ds.rows) {
+        cache_->put(gn_->space(), row.values.front(), sig_, generation_, row, colNames);
+    }
+}
+
 folly::Future<Status> GetNeighborsExecutor::getNeighbors() {
     if (reqDs_.rows.empty()) {
         VLOG(1) << "Empty input.";
-        List emptyResult;
         return finish(ResultBuilder()
-                          .value(Value(std::move(emptyResult)))
+                          .value(Value(std::move(hits_)))
                           .iter(Iterator::Kind::kGetNeighbors)
                           .finish());
     }
 
+    // The random neighbors are expected to differ among the requests
+    auto* flight = gn_->random() ? nullptr : qctx()->storageFlight();
+    bool joined = false;
+    auto fetched = flight == nullptr
+                       ? fetchNeighbors().semi()
+                       : flight->call(requestKey(), [this]() { return fetchNeighbors(); }, &joined);
+    if (joined && otherStats_ != nullptr) {
+        otherStats_->emplace("coalesced", "true");
+    }
+    return std::move(fetched).via(runner()).then([this](StorageResult&& result) {
+        NG_RETURN_IF_ERROR(result);
+        SCOPED_TIMER(&execTime_);
+        auto state = result.value().first;
+        auto list = result.value().second.moveList();
+        list.values.insert(list.values.end(),
+                           std::make_move_iterator(hits_.values.begin()),
+                           std::make_move_iterator(hits_.values.end()));
+        hits_.values.clear();
+        return finish(ResultBuilder()
+                          .state(state)
+                          .value(Value(std::move(list)))
+                          .iter(Iterator::Kind::kGetNeighbors)
+                          .finish());
+    });
+}
+
+folly::Future<StorageResult> GetNeighborsExecutor::fetchNeighbors() {
     time::Duration getNbrTime;
-    GraphStorageClient* storageClient = qctx_->getStorageClient();
-    return storageClient
-        ->getNeighbors(gn_->space(),
-                       std::move(reqDs_.colNames),
-                       std::move(reqDs_.rows),
-                       gn_->edgeTypes(),
-                       gn_->edgeDirection(),
-                       gn_->statProps(),
-                       gn_->vertexProps(),
-                       gn_->edgeProps(),
-                       gn_->exprs(),
-                       gn_->dedup(),
-                       gn_->random(),
-                       gn_->orderBy(),
-                       gn_->limit(),
-                       gn_->filter())
+    return sendRequest(std::move(reqDs_.rows))
         .via(runner())
         .ensure([this, getNbrTime]() {
             if (otherStats_ != nullptr) {
@@ -111,11 +210,234 @@ folly::Future<Status> GetNeighborsExecutor::getNeighbors() {
         });
 }
 
-Status GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
+std::string GetNeighborsExecutor::requestKey() const {
+    std::string key = folly::stringPrintf("GetNeighbors:%d:", gn_->space());
+    key.append(signature(gn_));
+    key.append(";");
+    key.append(gn_->filter());
+    key.append(";");
+    key.append(folly::toJson(util::toJson(gn_->orderBy())));
+    key.append(";");
+    key.append(folly::to<std::string>(gn_->limit()));
+    key.append(";");
+    key.append(vidsKey(reqDs_.rows));
+    return key;
+}
+
+folly::SemiFuture<GetNeighborsExecutor::RpcResponse> GetNeighborsExecutor::sendRequest(
+    std::vector<Row> rows) {
+    GraphStorageClient* storageClient = qctx_->getStorageClient();
+    return storageClient->getNeighbors(gn_->space(),
+                                       reqDs_.colNames,
+                                       std::move(rows),
+                                       gn_->edgeTypes(),
+                                       gn_->edgeDirection(),
+                                       gn_->statProps(),
+                                       gn_->vertexProps(),
+                                       gn_->edgeProps(),
+                                       gn_->exprs(),
+                                       gn_->dedup(),
+                                       gn_->random(),
+                                       gn_->orderBy(),
+                                       gn_->limit(),
+                                       gn_->filter());
+}
+
+folly::Future<Status> GetNeighborsExecutor::collectParts() {
+    auto list = std::make_shared<List>();
+    return stream([list](std::shared_ptr<Value> part) -> StatusOr<bool> {
+               auto datasets = part->moveList();
+               list->values.insert(list->values.end(),
+                                   std::make_move_iterator(datasets.values.begin()),
+                                   std::make_move_iterator(datasets.values.end()));
+               return true;
+           })
+        .then([this, list](Status status) {
+            NG_RETURN_IF_ERROR(status);
+            ResultBuilder builder;
+            builder.state(partsState_);
+            builder.value(Value(std::move(*list)));
+            return finish(builder.iter(Iterator::Kind::kGetNeighbors).finish());
+        });
+}
+
+folly::Future<Status> GetNeighborsExecutor::stream(PartHandler handler) {
+    otherStats_ = std::make_unique<std::unordered_map<std::string, std::string>>();
+    partsStatus_ = Status::OK();
+    partsError_ = Status::OK();
+    numFailedParts_ = 0;
+    partsState_ = Result::State::kSuccess;
+    auto status = buildRequestDataSet();
+    if (!status.ok()) {
+        return error(std::move(status));
+    }
+    lookupCache();
+    if (!hits_.values.empty()) {
+        // The cached neighbors are handed at first, as a part of their own
+        auto more = handler(std::make_shared<Value>(std::move(hits_)));
+        hits_.values.clear();
+        if (!more.ok()) {
+            return error(more.status());
+        }
+        if (!more.value()) {
+            reqDs_.rows.clear();
+        }
+    }
+    if (reqDs_.rows.empty()) {
+        VLOG(1) << "Empty input.";
+        return start();
+    }
+
+    auto batches = std::make_shared<Batches>();
+    batches->rows = splitRequest();
+    batches->handler = std::move(handler);
+    auto numBatches = batches->rows.size();
+    otherStats_->emplace("batches", folly::to<std::string>(numBatches));
+    // Keep at most `get_neighbors_concurrency' requests in flight, each of them sends the
+    // next batch once its response is handled
+    size_t window = FLAGS_get_neighbors_concurrency;
+    window = window == 0 ? numBatches : std::min<size_t>(window, numBatches);
+    std::vector<folly::Future<Status>> futures;
+    futures.reserve(window);
+    time::Duration getNbrTime;
+    for (size_t i = 0; i < window; ++i) {
+        futures.emplace_back(sendBatches(batches));
+    }
+    // Wait for all the chains even if some of them failed, since they refer to this executor
+    return folly::collectAll(futures).via(runner()).then(
+        [this, numBatches, getNbrTime](std::vector<folly::Try<Status>>&& results) {
+            std::lock_guard<std::mutex> lock(partsLock_);
+            otherStats_->emplace("total_rpc_time",
+                                 folly::stringPrintf("%lu(us)", getNbrTime.elapsedInUSec()));
+            NG_RETURN_IF_ERROR(partsStatus_);
+            for (auto& result : results) {
+                if (result.hasException()) {
+                    return Status::Error("Get neighbors failed: %s",
+                                         result.exception().what().c_str());
+                }
+                NG_RETURN_IF_ERROR(result.value());
+            }
+            // Fail only if none of the batches succeeded, as a single request does
+            if (numFailedParts_ == numBatches) {
+                return partsError_;
+            }
+            return Status::OK();
+        });
+}
+
+folly::Future<Status> GetNeighborsExecutor::sendBatches(std::shared_ptr<Batches> batches) {
+    std::vector<Row> rows;
+    {
+        std::lock_guard<std::mutex> lock(partsLock_);
+        if (!partsStatus_.ok() || batches->stopped || batches->next == batches->rows.size()) {
+            return folly::makeFuture(Status::OK());
+        }
+        rows = std::move(batches->rows[batches->next++]);
+    }
+    return sendRequest(std::move(rows))
+        .via(runner())
+        .then([this, batches](RpcResponse&& resp) {
+            auto status = handlePart(resp, batches.get());
+            if (!status.ok()) {
+                return folly::makeFuture(std::move(status));
+            }
+            return sendBatches(batches);
+        });
+}
+
+std::vector<std::vector<Row>> GetNeighborsExecutor::splitRequest() {
+    auto numParts = std::min<size_t>(FLAGS_get_neighbors_parts, reqDs_.rows.size());
+    numParts = std::max<size_t>(numParts, 1);
+    std::vector<std::vector<Row>> parts(numParts);
+    std::hash<Value> hash;
+    for (auto& row : reqDs_.rows) {
+        auto& part = parts[hash(row.values[0]) % numParts];
+        part.emplace_back(std::move(row));
+    }
+    reqDs_.rows.clear();
+    parts.erase(std::remove_if(parts.begin(),
+                               parts.end(),
+                               [](const std::vector<Row>& part) { return part.empty(); }),
+                parts.end());
+
+    // Bound the vertices of each request, so a large frontier is sent in several batches
+    // while a small one is still sent at once
+    size_t batchSize = FLAGS_get_neighbors_batch_size;
+    if (batchSize == 0) {
+        return parts;
+    }
+    std::vector<std::vector<Row>> batches;
+    for (auto& part : parts) {
+        if (part.size() <= batchSize) {
+            batches.emplace_back(std::move(part));
+            continue;
+        }
+        for (size_t begin = 0; begin < part.size(); begin += batchSize) {
+            auto end = std::min(begin + batchSize, part.size());
+            batches.emplace_back(std::make_move_iterator(part.begin() + begin),
+                                 std::make_move_iterator(part.begin() + end));
+        }
+    }
+    return batches;
+}
+
+Status GetNeighborsExecutor::handlePart(RpcResponse& resp, Batches* batches) {
+    {
+        std::lock_guard<std::mutex> lock(partsLock_);
+        if (!partsStatus_.ok() || batches->stopped) {
+            return partsStatus_;
+        }
+        SCOPED_TIMER(&execTime_);
+        addStats(resp, *otherStats_);
+        auto result = handleCompleteness(resp, false);
+        if (!result.ok()) {
+            // The other batches may still succeed
+            if (numFailedParts_++ == 0) {
+                partsError_ = result.status();
+            }
+            partsState_ = Result::State::kPartialSuccess;
+            return Status::OK();
+        }
+        if (result.value() == Result::State::kPartialSuccess) {
+            partsState_ = Result::State::kPartialSuccess;
+        }
+    }
+
+    auto& responses = resp.responses();
+    List list;
+    list.values.reserve(responses.size());
+    for (auto& r : responses) {
+        auto dataset = r.get_vertices();
+        if (dataset == nullptr) {
+            LOG(INFO) << "Empty dataset in response";
+            continue;
+        }
+        fillCache(*dataset);
+        list.values.emplace_back(std::move(*dataset));
+    }
+
+    // The responses of batches arrive concurrently, hand them over one at a time. The state
+    // is not locked meanwhile, so the other responses are still checked and copied.
+    std::lock_guard<std::mutex> handlerLock(handlerLock_);
+    {
+        std::lock_guard<std::mutex> lock(partsLock_);
+        if (!partsStatus_.ok() || batches->stopped) {
+            return partsStatus_;
+        }
+    }
+    auto more = batches->handler(std::make_shared<Value>(std::move(list)));
+    std::lock_guard<std::mutex> lock(partsLock_);
+    if (!more.ok()) {
+        partsStatus_ = more.status();
+    } else if (!more.value()) {
+        batches->stopped = true;
+    }
+    return partsStatus_;
+}
+
+StorageResult GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
     auto result = handleCompleteness(resps, false);
     NG_RETURN_IF_ERROR(result);
-    ResultBuilder builder;
-    builder.state(result.value());
 
     auto& responses = resps.responses();
     VLOG(1) << "Resp size: " << responses.size();
@@ -128,10 +450,10 @@ Status GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
         }
 
         VLOG(1) << "Resp row size: " << dataset->rows.size() << "Resp : " << *dataset;
+        fillCache(*dataset);
         list.values.emplace_back(std::move(*dataset));
     }
-    builder.value(Value(std::move(list)));
-    return finish(builder.iter(Iterator::Kind::kGetNeighbors).finish());
+    return std::make_pair(result.value(), Value(std::move(list)));
 }
 
 }   // namespace graph
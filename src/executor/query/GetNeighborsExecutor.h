@@ -7,6 +7,7 @@
 #ifndef EXECUTOR_QUERY_GETNEIGHBORSEXECUTOR_H_
 #define EXECUTOR_QUERY_GETNEIGHBORSEXECUTOR_H_
 
+#include <mutex>
 #include <vector>
 
 #include "common/base/StatusOr.h"
@@ -17,11 +18,16 @@
 
 #include "executor/StorageAccessExecutor.h"
 #include "planner/Query.h"
+#include "util/RowCache.h"
 
 namespace nebula {
 namespace graph {
 class GetNeighborsExecutor final : public StorageAccessExecutor {
 public:
+    // Take the datasets of a part of the response and return whether more parts are
+    // wanted, see `stream'
+    using PartHandler = std::function<StatusOr<bool>(std::shared_ptr<Value>)>;
+
     GetNeighborsExecutor(const PlanNode *node, QueryContext *qctx)
         : StorageAccessExecutor("GetNeighborsExecutor", node, qctx) {
         gn_ = asNode<GetNeighbors>(node);
@@ -31,18 +37,91 @@ public:
 
     Status close() override;
 
+    // Whether the request is sent in batches and the responses are streamed, see
+    // FLAGS_get_neighbors_parts and FLAGS_get_neighbors_batch_size
+    static bool streaming();
+
+    // Send the request in batches, and hand the datasets of each batch to `handler' as
+    // soon as its response arrives. The batches are handled one at a time, in the order
+    // they arrive. The batches not sent yet are dropped once `handler' wants no more parts.
+    // Nothing is stored as the result of this executor.
+    folly::Future<Status> stream(PartHandler handler);
+
 private:
     friend class GetNeighborsTest_BuildRequestDataSet_Test;
+    friend class GetNeighborsTest_SplitRequest_Test;
+    friend class GetNeighborsTest_LookupCache_Test;
+    friend class GetNeighborsTest_VidsKey_Test;
     Status buildRequestDataSet();
 
+    // Whether the neighbors fetched by `gn' could be served by the neighbor cache
+    static bool cacheable(const GetNeighbors* gn);
+
+    // The edges, direction and props fetched by `gn'
+    static std::string signature(const GetNeighbors* gn);
+
+    // Move the cached rows of the request vertices to `hits_', and leave the others
+    // to be sent
+    void lookupCache();
+
+    // Cache the rows of a dataset in the response
+    void fillCache(const DataSet& ds) const;
+
     folly::Future<Status> getNeighbors();
 
+    // Send the request and collect the datasets of response
+    folly::Future<StorageResult> fetchNeighbors();
+
+    // The request and its vertices, to coalesce the identical requests in flight
+    std::string requestKey() const;
+
+    // Assemble the result from the parts of the response as they arrive
+    folly::Future<Status> collectParts();
+
+    // Split the request rows into parts by the hash of vertex id, and the large parts into
+    // the batches of at most FLAGS_get_neighbors_batch_size rows
+    std::vector<std::vector<Row>> splitRequest();
+
     using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
-    Status handleResponse(RpcResponse& resps);
+    folly::SemiFuture<RpcResponse> sendRequest(std::vector<Row> rows);
+
+    struct Batches {
+        std::vector<std::vector<Row>> rows;
+        // The next batch to send, guarded by `partsLock_'
+        size_t next{0};
+        // No more parts are wanted by `handler', guarded by `partsLock_'
+        bool stopped{false};
+        PartHandler handler;
+    };
+
+    // Send the remaining batches one after another
+    folly::Future<Status> sendBatches(std::shared_ptr<Batches> batches);
+
+    StorageResult handleResponse(RpcResponse& resps);
+
+    Status handlePart(RpcResponse& resp, Batches* batches);
 
 private:
     DataSet                 reqDs_;
     const GetNeighbors*     gn_;
+
+    // nullptr if the neighbors of this request are not cached
+    RowCache*               cache_{nullptr};
+    std::string             sig_;
+    // The generation of `cache_' taken before fetching
+    uint64_t                generation_{0};
+    // The datasets of cached rows, one for each layout of columns
+    List                    hits_;
+
+    // The parts are handed to the handler one at a time, always locked before `partsLock_'
+    std::mutex              handlerLock_;
+    // The state of streaming, guarded by `partsLock_'
+    std::mutex              partsLock_;
+    Status                  partsStatus_;
+    // The first error of the batches failed in storage
+    Status                  partsError_;
+    size_t                  numFailedParts_{0};
+    Result::State           partsState_{Result::State::kSuccess};
 };
 
 }   // namespace graph
@@ -20,14 +20,23 @@ protected:
 
     Status handleResp(storage::StorageRpcResponse<storage::cpp2::GetPropResponse> &&rpcResp,
                       const std::vector<std::string> &colNames) {
+        nebula::DataSet v;
+        auto result = mergeResp(std::move(rpcResp), &v);
+        NG_RETURN_IF_ERROR(result);
+        return finishResp(std::move(v), result.value(), colNames);
+    }
+
+    // Merge the datasets of responses into `v'
+    StatusOr<Result::State> mergeResp(
+        storage::StorageRpcResponse<storage::cpp2::GetPropResponse> &&rpcResp,
+        nebula::DataSet *v) {
         auto result = handleCompleteness(rpcResp, false);
         NG_RETURN_IF_ERROR(result);
         auto state = std::move(result).value();
         // Ok, merge DataSets to one
-        nebula::DataSet v;
         for (auto &resp : rpcResp.responses()) {
             if (resp.__isset.props) {
-                if (UNLIKELY(!v.append(std::move(*resp.get_props())))) {
+                if (UNLIKELY(!v->append(std::move(*resp.get_props())))) {
                     // it's impossible according to the interface
                     LOG(WARNING) << "Heterogeneous props dataset";
                     state = Result::State::kPartialSuccess;
@@ -36,6 +45,12 @@ protected:
                 state = Result::State::kPartialSuccess;
             }
         }
+        return state;
+    }
+
+    Status finishResp(nebula::DataSet &&v,
+                      Result::State state,
+                      const std::vector<std::string> &colNames) {
         if (!colNames.empty()) {
             DCHECK_EQ(colNames.size(), v.colSize());
             v.colNames = colNames;
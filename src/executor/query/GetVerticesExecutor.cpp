@@ -9,8 +9,8 @@
 #include "context/QueryContext.h"
 #include "util/SchemaUtil.h"
 #include "util/ScopedTimer.h"
+#include "util/ToJson.h"
 
-using nebula::storage::GraphStorageClient;
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetPropResponse;
 
@@ -27,7 +27,6 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
 
     auto *gv = asNode<GetVertices>(node());
 
-    GraphStorageClient *storageClient = qctx()->getStorageClient();
     nebula::DataSet vertices({kVid});
     const auto& spaceInfo = qctx()->rctx()->session()->space();
     if (gv->src() != nullptr) {
@@ -54,8 +53,62 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
                           .finish());
     }
 
+    // Only fetch the vertices not cached
+    auto *cache = cacheable(gv) ? qctx()->vertexCache() : nullptr;
+    std::string sig;
+    uint64_t generation = 0;
+    DataSet hits;
+    if (cache != nullptr) {
+        sig = signature(gv);
+        // Taken before fetching, the rows of the vertices written since then are not cached
+        generation = cache->generation();
+        lookupCache(cache, sig, &vertices, &hits);
+        otherStats_->emplace("cache_hits", folly::to<std::string>(hits.rows.size()));
+        if (vertices.rows.empty()) {
+            hits.colNames = gv->colNames();
+            return finish(ResultBuilder()
+                              .value(Value(std::move(hits)))
+                              .iter(Iterator::Kind::kProp)
+                              .finish());
+        }
+    }
+
+    auto *flight = qctx()->storageFlight();
+    bool joined = false;
+    auto fetch = [this, &vertices, cache, &sig, generation]() {
+        return fetchVertices(std::move(vertices), cache, std::move(sig), generation);
+    };
+    auto fetched = flight == nullptr
+                       ? fetch().semi()
+                       : flight->call(requestKey(gv, vertices.rows), fetch, &joined);
+    if (joined) {
+        otherStats_->emplace("coalesced", "true");
+    }
+    return std::move(fetched).via(runner()).then(
+        [this, gv, hits = std::move(hits)](StorageResult &&result) mutable {
+            NG_RETURN_IF_ERROR(result);
+            SCOPED_TIMER(&execTime_);
+            auto state = result.value().first;
+            auto v = result.value().second.moveDataSet();
+            if (!hits.rows.empty()) {
+                if (v.colNames.empty()) {
+                    v.colNames = gv->colNames();
+                }
+                v.rows.insert(v.rows.end(),
+                              std::make_move_iterator(hits.rows.begin()),
+                              std::make_move_iterator(hits.rows.end()));
+            }
+            return finishResp(std::move(v), state, gv->colNamesRef());
+        });
+}
+
+folly::Future<StorageResult> GetVerticesExecutor::fetchVertices(DataSet vertices,
+                                                                RowCache *cache,
+                                                                std::string sig,
+                                                                uint64_t generation) {
+    auto *gv = asNode<GetVertices>(node());
     time::Duration getPropsTime;
-    return DCHECK_NOTNULL(storageClient)
+    return DCHECK_NOTNULL(qctx()->getStorageClient())
         ->getProps(gv->space(),
                    std::move(vertices),
                    &gv->props(),
@@ -73,14 +126,97 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
             }
             VLOG(1) << "Get props time: " << getPropsTime.elapsedInUSec() << "us";
         })
-        .then([this, gv](StorageRpcResponse<GetPropResponse> &&rpcResp) {
+        .then([this, cache, sig = std::move(sig), generation](
+                  StorageRpcResponse<GetPropResponse> &&rpcResp) -> StorageResult {
             if (otherStats_ != nullptr) {
                 addStats(rpcResp, *otherStats_);
             }
             SCOPED_TIMER(&execTime_);
-            return handleResp(std::move(rpcResp), gv->colNamesRef());
+            DataSet v;
+            auto result = mergeResp(std::move(rpcResp), &v);
+            NG_RETURN_IF_ERROR(result);
+            if (cache != nullptr) {
+                fillCache(cache, sig, generation, v);
+            }
+            return std::make_pair(result.value(), Value(std::move(v)));
         });
 }
 
+// static
+std::string GetVerticesExecutor::requestKey(const GetVertices *gv,
+                                            const std::vector<Row> &vertices) {
+    std::string key = folly::stringPrintf("GetVertices:%d:", gv->space());
+    key.append(signature(gv));
+    key.append(";");
+    key.append(folly::toJson(util::toJson(gv->exprs())));
+    key.append(";");
+    key.append(gv->filter());
+    key.append(";");
+    key.append(folly::toJson(util::toJson(gv->orderBy())));
+    key.append(";");
+    key.append(folly::to<std::string>(gv->limit()));
+    key.append(gv->dedup() ? ";dedup;" : ";;");
+    key.append(vidsKey(vertices));
+    return key;
+}
+
+// static
+bool GetVerticesExecutor::cacheable(const GetVertices *gv) {
+    // The rows are cached as they are returned by storage, so nothing is computed from them
+    return gv->exprs().empty() && gv->filter().empty() && gv->orderBy().empty() &&
+           gv->limit() == std::numeric_limits<int64_t>::max() && !gv->colNames().empty();
+}
+
+// static
+std::string GetVerticesExecutor::signature(const GetVertices *gv) {
+    std::string sig;
+    for (auto &prop : gv->props()) {
+        sig.append(folly::to<std::string>(prop.get_tag()));
+        sig.append(":");
+        for (auto &name : prop.get_props()) {
+            sig.append(name);
+            sig.append(",");
+        }
+        sig.append(";");
+    }
+    return sig;
+}
+
+void GetVerticesExecutor::lookupCache(RowCache *cache,
+                                      const std::string &sig,
+                                      DataSet *vertices,
+                                      DataSet *hits) const {
+    auto *gv = asNode<GetVertices>(node());
+    std::unordered_set<Value> unique;
+    std::vector<Row> misses;
+    for (auto &row : vertices->rows) {
+        auto &vid = row.values[0];
+        if (gv->dedup() && !unique.emplace(vid).second) {
+            continue;
+        }
+        auto cached = cache->get(gv->space(), vid, sig);
+        if (cached != nullptr) {
+            hits->rows.emplace_back(*cached);
+        } else {
+            misses.emplace_back(std::move(row));
+        }
+    }
+    vertices->rows = std::move(misses);
+}
+
+void GetVerticesExecutor::fillCache(RowCache *cache,
+                                    const std::string &sig,
+                                    uint64_t generation,
+                                    const DataSet &v) const {
+    // The rows are keyed by the vertex id in the first column
+    if (v.colNames.empty() || v.colNames.front() != kVid) {
+        return;
+    }
+    auto space = asNode<GetVertices>(node())->space();
+    for (auto &row : v.rows) {
+        cache->put(space, row.values.front(), sig, generation, row);
+    }
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -8,6 +8,8 @@
 #define EXECUTOR_QUERY_GETVERTICESEXECUTOR_H_
 
 #include "executor/query/GetPropExecutor.h"
+#include "planner/Query.h"
+#include "util/RowCache.h"
 
 namespace nebula {
 namespace graph {
@@ -20,7 +22,36 @@ public:
     folly::Future<Status> execute() override;
 
 private:
+    friend class GetVerticesTest_Cache_Test;
+
     folly::Future<Status> getVertices();
+
+    // Send the request of `vertices' and merge the datasets of response, which are
+    // cached if `cache' is not nullptr and no vertex is evicted since `generation'
+    folly::Future<StorageResult> fetchVertices(DataSet vertices,
+                                               RowCache *cache,
+                                               std::string sig,
+                                               uint64_t generation);
+
+    // The request and its vertices, to coalesce the identical requests in flight
+    static std::string requestKey(const GetVertices *gv, const std::vector<Row> &vertices);
+
+    // Whether the rows of `gv' could be served by the vertex cache
+    static bool cacheable(const GetVertices *gv);
+
+    // The tags and props fetched by `gv'
+    static std::string signature(const GetVertices *gv);
+
+    // Move the cached rows of `vertices' to `hits', and leave the others in `vertices'
+    void lookupCache(RowCache *cache,
+                     const std::string &sig,
+                     DataSet *vertices,
+                     DataSet *hits) const;
+
+    void fillCache(RowCache *cache,
+                   const std::string &sig,
+                   uint64_t generation,
+                   const DataSet &v) const;
 };
 
 }   // namespace graph
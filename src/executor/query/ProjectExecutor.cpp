@@ -6,9 +6,14 @@
 
 #include "executor/query/ProjectExecutor.h"
 
+#include <algorithm>
+
+#include "context/ColumnBatch.h"
 #include "context/QueryExpressionContext.h"
 #include "parser/Clauses.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
+#include "util/CompiledExpr.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -17,25 +22,102 @@ namespace graph {
 folly::Future<Status> ProjectExecutor::execute() {
     SCOPED_TIMER(&execTime_);
     auto* project = asNode<Project>(node());
-    auto columns = project->columns()->columns();
     auto iter = ectx_->getResult(project->inputVar()).iter();
     DCHECK(!!iter);
-    QueryExpressionContext ctx(ectx_);
 
     VLOG(1) << "input: " << project->inputVar();
-    DataSet ds;
-    ds.colNames = project->colNames();
-    ds.rows.reserve(iter->size());
-    for (; iter->valid(); iter->next()) {
+    auto scatter = [this](size_t begin, size_t end, Iterator* tmpIter) {
+        return handleJob(begin, end, tmpIter);
+    };
+    auto gather = [this, total = iter->size()](std::vector<std::vector<Row>> results) -> Status {
+        SCOPED_TIMER(&execTime_);
+        auto* project = asNode<Project>(node());
+        DataSet ds;
+        ds.colNames = project->colNames();
+        ds.rows.reserve(total);
+        for (auto& rows : results) {
+            ds.rows.insert(ds.rows.end(),
+                           std::make_move_iterator(rows.begin()),
+                           std::make_move_iterator(rows.end()));
+        }
+        VLOG(1) << node()->outputVar() << ":" << ds;
+        return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+    };
+    return runMultiJobs(std::move(scatter), std::move(gather), iter.get());
+}
+
+std::vector<Row> ProjectExecutor::handleJob(size_t begin, size_t end, Iterator* iter) {
+    auto* project = asNode<Project>(node());
+    // Expression keeps the evaluation result in itself, so each job evaluates its own copy
+    auto columns = project->columns()->clone();
+    auto cols = columns->columns();
+    QueryExpressionContext ctx(ectx_);
+    if (FLAGS_enable_vectorized && iter->isSequentialIter()) {
+        auto& colIndices = static_cast<SequentialIter*>(iter)->getColIndices();
+        std::vector<std::unique_ptr<VectorizedExpr>> vectorized;
+        vectorized.reserve(cols.size());
+        for (auto& col : cols) {
+            vectorized.emplace_back(VectorizedExpr::make(col->expr(), colIndices));
+        }
+        if (std::any_of(vectorized.begin(), vectorized.end(), [](auto& v) { return !!v; })) {
+            return handleJobVectorized(begin, end, iter, cols, vectorized);
+        }
+    }
+
+    // Resolve the properties for the input once instead of looking up them for each row
+    std::vector<std::unique_ptr<CompiledExpr>> compiled;
+    if (FLAGS_enable_compiled_expr) {
+        for (auto& col : cols) {
+            compiled.emplace_back(CompiledExpr::compile(col->expr(), iter));
+        }
+    }
+
+    std::vector<Row> rows;
+    rows.reserve(end - begin);
+    for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
         Row row;
-        for (auto& col : columns) {
-            Value val = col->expr()->eval(ctx(iter.get()));
-            row.values.emplace_back(std::move(val));
+        row.values.reserve(cols.size());
+        for (size_t c = 0; c < cols.size(); ++c) {
+            if (!compiled.empty() && compiled[c] != nullptr) {
+                row.values.emplace_back(compiled[c]->eval(iter, ctx));
+            } else {
+                row.values.emplace_back(cols[c]->expr()->eval(ctx(iter)));
+            }
+        }
+        rows.emplace_back(std::move(row));
+    }
+    return rows;
+}
+
+std::vector<Row> ProjectExecutor::handleJobVectorized(
+    size_t begin,
+    size_t end,
+    Iterator* iter,
+    const std::vector<YieldColumn*>& cols,
+    const std::vector<std::unique_ptr<VectorizedExpr>>& vectorized) {
+    QueryExpressionContext ctx(ectx_);
+    std::vector<Row> rows(end - begin);
+    for (auto& row : rows) {
+        row.values.resize(cols.size());
+    }
+    for (size_t i = begin; i < end; i += VectorizedExpr::kBatchSize) {
+        ColumnBatch batch(iter, i, std::min(i + VectorizedExpr::kBatchSize, end));
+        auto* batchRows = &rows[i - begin];
+        for (size_t c = 0; c < cols.size(); ++c) {
+            if (vectorized[c] != nullptr) {
+                auto column = vectorized[c]->eval(&batch, ctx);
+                for (size_t j = 0; j < batch.size(); ++j) {
+                    batchRows[j].values[c] = column.value(j);
+                }
+            } else {
+                // Evaluate the column without kernel row by row
+                for (size_t j = 0; j < batch.size(); ++j) {
+                    batchRows[j].values[c] = cols[c]->expr()->eval(ctx(batch.rowAt(j)));
+                }
+            }
         }
-        ds.rows.emplace_back(std::move(row));
     }
-    VLOG(1) << node()->outputVar() << ":" << ds;
-    return finish(ResultBuilder().value(Value(std::move(ds))).finish());
+    return rows;
 }
 
 }   // namespace graph
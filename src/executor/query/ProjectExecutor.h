@@ -8,8 +8,12 @@
 #define EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/VectorizedExpr.h"
 
 namespace nebula {
+
+class YieldColumn;
+
 namespace graph {
 
 class ProjectExecutor final : public Executor {
@@ -18,6 +22,19 @@ public:
         : Executor("ProjectExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    // Evaluate the yield columns on rows [begin, end)
+    std::vector<Row> handleJob(size_t begin, size_t end, Iterator *iter);
+
+    // Evaluate the columns in batches, the ones without vectorized expression are
+    // evaluated row by row
+    std::vector<Row> handleJobVectorized(
+        size_t begin,
+        size_t end,
+        Iterator *iter,
+        const std::vector<YieldColumn *> &cols,
+        const std::vector<std::unique_ptr<VectorizedExpr>> &vectorized);
 };
 
 }   // namespace graph
@@ -5,7 +5,11 @@
  */
 
 #include "executor/query/SortExecutor.h"
+
+#include <numeric>
+
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
 #include "util/ScopedTimer.h"
 
 namespace nebula {
@@ -30,36 +34,334 @@ folly::Future<Status> SortExecutor::execute() {
         return Status::Error(errMsg);
     }
 
-    auto &factors = sort->factors();
-    auto comparator = [&factors] (const LogicalRow &lhs, const LogicalRow &rhs) {
-        for (auto &item : factors) {
-            auto index = item.first;
-            auto orderType = item.second;
-            if (lhs[index] == rhs[index]) {
-                continue;
-            }
+    // The sort keys and row indices take about this many bytes per row. If they don't fit
+    // in the memory budget, each job sorts its rows by runs within its share of the budget
+    // and spills them, then the runs are merged from the files. The rows of a dataset only
+    // read by this sort are spilled along with their keys, so the input is released once
+    // spilled and the sorted rows are read back from the files. Otherwise the input rows
+    // are sorted in place by the order of their indices merged from the files.
+    auto* input = iter.get();
+    auto totalSize = iter->size();
+    auto rowBytes = sort->factors().size() * sizeof(const Value*) + sizeof(size_t);
+    if (FLAGS_query_memory_budget_bytes <= 0 ||
+        totalSize * rowBytes <= static_cast<size_t>(FLAGS_query_memory_budget_bytes)) {
+        // Account the keys and the order of the rows as the working set until sorted
+        auto bytes = totalSize * (rowBytes + sizeof(size_t));
+        auto reserved = reserveMemory(static_cast<int64_t>(bytes));
+        if (!reserved.ok()) {
+            return reserved.status();
+        }
+        auto scatter = [this](size_t begin, size_t end, Iterator* tmpIter) {
+            return sortJob(begin, end, tmpIter);
+        };
+        auto gather = [this, iter = std::move(iter), memory = std::move(reserved).value()](
+                          std::vector<SortChunk> chunks) mutable {
+            SCOPED_TIMER(&execTime_);
+            return finishSorted(std::move(iter), mergeChunks(chunks));
+        };
+        return runMultiJobs(std::move(scatter), std::move(gather), input);
+    }
 
-            if (orderType == OrderFactor::OrderType::ASCEND) {
-                return lhs[index] < rhs[index];
-            } else if (orderType == OrderFactor::OrderType::DESCEND) {
-                return lhs[index] > rhs[index];
-            }
+    auto batchSize = getBatchSize(totalSize);
+    auto numJobs = std::max<size_t>((totalSize + batchSize - 1) / batchSize, 1);
+    auto runSize = std::max<size_t>(FLAGS_query_memory_budget_bytes / numJobs / rowBytes, 1);
+    auto withRows = spillsRows(input);
+    // Account the keys of the runs being sorted, and the final order of the rows if they're
+    // sorted in place
+    auto runBytes = std::min(numJobs * runSize, totalSize) * rowBytes;
+    auto orderBytes = withRows ? 0 : totalSize * sizeof(size_t);
+    auto reserved = reserveMemory(static_cast<int64_t>(runBytes + orderBytes));
+    if (!reserved.ok()) {
+        return reserved.status();
+    }
+    auto scatter = [this, runSize, withRows](size_t begin, size_t end, Iterator* tmpIter) {
+        return spillJob(begin, end, tmpIter, runSize, withRows);
+    };
+    auto gather = [this, withRows, iter = std::move(iter), memory = std::move(reserved).value()](
+                      std::vector<StatusOr<SpilledRuns>> results) mutable -> Status {
+        SCOPED_TIMER(&execTime_);
+        std::vector<SpilledRuns> jobs;
+        jobs.reserve(results.size());
+        for (auto& result : results) {
+            NG_RETURN_IF_ERROR(result);
+            jobs.emplace_back(std::move(result).value());
         }
-        return false;
+        if (!withRows) {
+            std::vector<size_t> order;
+            order.reserve(iter->size());
+            NG_RETURN_IF_ERROR(mergeRuns(std::move(jobs), [&order](Row&& record) {
+                order.emplace_back(static_cast<size_t>(record.values[0].getInt()));
+                return Status::OK();
+            }));
+            return finishSorted(std::move(iter), order);
+        }
+
+        // All the rows are in the files, so release the input before reading them back
+        auto* sortNode = asNode<Sort>(node());
+        DataSet ds;
+        ds.colNames = iter->valuePtr()->getDataSet().colNames;
+        ds.rows.reserve(iter->size());
+        iter.reset();
+        ectx_->truncHistory(sortNode->inputVar(), 0);
+        auto rowBegin = sortNode->factors().size() + 1;
+        NG_RETURN_IF_ERROR(mergeRuns(std::move(jobs), [&ds, rowBegin](Row&& record) {
+            Row row;
+            row.values.assign(std::make_move_iterator(record.values.begin() + rowBegin),
+                              std::make_move_iterator(record.values.end()));
+            ds.rows.emplace_back(std::move(row));
+            return Status::OK();
+        }));
+        return finish(ResultBuilder().value(Value(std::move(ds))).finish());
     };
+    return runMultiJobs(std::move(scatter), std::move(gather), input, batchSize);
+}
 
+bool SortExecutor::spillsRows(const Iterator* iter) const {
+    if (!iter->isSequentialIter()) {
+        return false;
+    }
+    auto* var = qctx_->symTable()->getVar(asNode<Sort>(node())->inputVar());
+    return var != nullptr && var->readBy.size() == 1;
+}
+
+Status SortExecutor::finishSorted(std::unique_ptr<Iterator> iter,
+                                  const std::vector<size_t>& order) {
     if (iter->isSequentialIter()) {
-        auto seqIter = static_cast<SequentialIter*>(iter.get());
-        std::sort(seqIter->begin(), seqIter->end(), comparator);
+        reorder<SequentialIter::SeqLogicalRow, SequentialIter>(iter.get(), order);
     } else if (iter->isJoinIter()) {
-        auto joinIter = static_cast<JoinIter*>(iter.get());
-        std::sort(joinIter->begin(), joinIter->end(), comparator);
+        reorder<JoinIter::JoinLogicalRow, JoinIter>(iter.get(), order);
     } else if (iter->isPropIter()) {
-        auto propIter = static_cast<PropIter*>(iter.get());
-        std::sort(propIter->begin(), propIter->end(), comparator);
+        reorder<PropIter::PropLogicalRow, PropIter>(iter.get(), order);
     }
     return finish(ResultBuilder().value(iter->valuePtr()).iter(std::move(iter)).finish());
 }
 
+SortExecutor::SortChunk SortExecutor::sortJob(size_t begin, size_t end, Iterator* iter) const {
+    auto& factors = asNode<Sort>(node())->factors();
+    auto numFactors = factors.size();
+    SortChunk chunk;
+    chunk.begin = begin;
+    chunk.keys.reserve((end - begin) * numFactors);
+    // The sort keys point to the values in the input dataset, which outlive the iterator
+    for (size_t i = begin; i < end && iter->valid(); ++i, iter->next()) {
+        auto* row = iter->row();
+        for (auto& factor : factors) {
+            chunk.keys.emplace_back(&(*row)[factor.first]);
+        }
+    }
+
+    chunk.order.resize(numFactors == 0 ? 0 : chunk.keys.size() / numFactors);
+    std::iota(chunk.order.begin(), chunk.order.end(), 0);
+    std::sort(chunk.order.begin(), chunk.order.end(), [&chunk, numFactors, this](auto l, auto r) {
+        auto cmp = compareKeys(&chunk.keys[l * numFactors], &chunk.keys[r * numFactors]);
+        // Rows with equal keys keep the input order, so the result doesn't depend on
+        // how the input is split into chunks
+        return cmp < 0 || (cmp == 0 && l < r);
+    });
+    return chunk;
+}
+
+StatusOr<SortExecutor::SpilledRuns> SortExecutor::spillJob(size_t begin,
+                                                           size_t end,
+                                                           Iterator* iter,
+                                                           size_t runSize,
+                                                           bool withRows) const {
+    auto numFactors = asNode<Sort>(node())->factors().size();
+    auto file = SpillFile::create(FLAGS_spill_dir);
+    NG_RETURN_IF_ERROR(file);
+    // All the runs of a job go to one file, so the open files don't grow with the runs
+    SpilledRuns spilled;
+    spilled.file = std::move(file).value();
+    // The rows are looked up in the sorted order by another iterator, so `iter' keeps going
+    // through the runs
+    auto rowIter = withRows ? iter->copy() : nullptr;
+    for (auto runBegin = begin; runBegin < end; runBegin += runSize) {
+        // Only the keys of one run are held at a time
+        auto chunk = sortJob(runBegin, std::min(runBegin + runSize, end), iter);
+        auto offset = spilled.file->bytes();
+        for (auto idx : chunk.order) {
+            Row record;
+            record.values.reserve(numFactors + 1);
+            record.values.emplace_back(static_cast<int64_t>(runBegin + idx));
+            for (size_t i = 0; i < numFactors; ++i) {
+                record.values.emplace_back(*chunk.keys[idx * numFactors + i]);
+            }
+            if (withRows) {
+                rowIter->reset(runBegin + idx);
+                auto& values = rowIter->row()->values;
+                record.values.insert(record.values.end(), values.begin(), values.end());
+            }
+            NG_RETURN_IF_ERROR(spilled.file->write(record));
+        }
+        spilled.runs.emplace_back(offset, spilled.file->bytes());
+    }
+    NG_RETURN_IF_ERROR(spilled.file->flush());
+    return spilled;
+}
+
+std::vector<size_t> SortExecutor::mergeChunks(const std::vector<SortChunk>& chunks) const {
+    std::vector<size_t> order;
+    if (chunks.size() == 1) {
+        order.reserve(chunks[0].order.size());
+        for (auto idx : chunks[0].order) {
+            order.emplace_back(chunks[0].begin + idx);
+        }
+        return order;
+    }
+
+    // K-way merge by a heap of the chunk cursors, the chunk on top has the smallest head row
+    auto numFactors = asNode<Sort>(node())->factors().size();
+    std::vector<size_t> cursors(chunks.size(), 0);
+    auto head = [&chunks, &cursors, numFactors](size_t chunk) {
+        return &chunks[chunk].keys[chunks[chunk].order[cursors[chunk]] * numFactors];
+    };
+    auto greater = [&head, this](size_t l, size_t r) {
+        auto cmp = compareKeys(head(l), head(r));
+        // Chunks are split in the input order, so the former chunk wins on equal keys
+        return cmp > 0 || (cmp == 0 && l > r);
+    };
+    std::vector<size_t> heap;
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        total += chunks[i].order.size();
+        if (!chunks[i].order.empty()) {
+            heap.emplace_back(i);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    order.reserve(total);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        auto chunk = heap.back();
+        order.emplace_back(chunks[chunk].begin + chunks[chunk].order[cursors[chunk]]);
+        if (++cursors[chunk] < chunks[chunk].order.size()) {
+            std::push_heap(heap.begin(), heap.end(), greater);
+        } else {
+            heap.pop_back();
+        }
+    }
+    return order;
+}
+
+Status SortExecutor::mergeRuns(std::vector<SpilledRuns>&& jobs,
+                               const std::function<Status(Row&&)>& emit) const {
+    size_t fanIn = std::max<size_t>(FLAGS_spill_merge_fanin, 2);
+    std::vector<SpillFile::Reader> runs;
+    for (auto& job : jobs) {
+        for (auto& run : job.runs) {
+            runs.emplace_back(job.file.get(), run.first, run.second);
+        }
+    }
+
+    // Merge each `fanIn' runs into one run of a new file, until all runs could be merged
+    // at once. The files of each pass are released after it.
+    std::unique_ptr<SpillFile> merged;
+    while (runs.size() > fanIn) {
+        auto file = SpillFile::create(FLAGS_spill_dir);
+        NG_RETURN_IF_ERROR(file);
+        auto next = std::move(file).value();
+        auto write = [&next](Row&& record) {
+            return next->write(record);
+        };
+        std::vector<SpillFile::Reader> nextRuns;
+        for (size_t i = 0; i < runs.size(); i += fanIn) {
+            auto offset = next->bytes();
+            std::vector<SpillFile::Reader> group(
+                std::make_move_iterator(runs.begin() + i),
+                std::make_move_iterator(runs.begin() + std::min(i + fanIn, runs.size())));
+            NG_RETURN_IF_ERROR(mergeGroup(std::move(group), write));
+            nextRuns.emplace_back(next.get(), offset, next->bytes());
+        }
+        NG_RETURN_IF_ERROR(next->flush());
+        VLOG(1) << node()->outputVar() << " merges " << runs.size() << " spilled runs into "
+                << nextRuns.size();
+        runs = std::move(nextRuns);
+        jobs.clear();
+        merged = std::move(next);
+    }
+
+    return mergeGroup(std::move(runs), emit);
+}
+
+Status SortExecutor::mergeGroup(std::vector<SpillFile::Reader>&& runs,
+                                const std::function<Status(Row&&)>& emit) const {
+    // Only the head record of each run is kept in memory
+    auto numFactors = asNode<Sort>(node())->factors().size();
+    std::vector<Row> heads(runs.size());
+    std::vector<std::vector<const Value*>> headKeys(runs.size(),
+                                                    std::vector<const Value*>(numFactors));
+    auto next = [&runs, &heads, &headKeys, numFactors](size_t run) -> StatusOr<bool> {
+        auto hasNext = runs[run].read(&heads[run]);
+        if (hasNext.ok() && hasNext.value()) {
+            for (size_t i = 0; i < numFactors; ++i) {
+                headKeys[run][i] = &heads[run].values[i + 1];
+            }
+        }
+        return hasNext;
+    };
+    auto greater = [&heads, &headKeys, this](size_t l, size_t r) {
+        auto cmp = compareKeys(headKeys[l].data(), headKeys[r].data());
+        // Rows with equal keys keep the input order
+        return cmp > 0 ||
+               (cmp == 0 && heads[l].values[0].getInt() > heads[r].values[0].getInt());
+    };
+
+    std::vector<size_t> heap;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        auto hasNext = next(i);
+        NG_RETURN_IF_ERROR(hasNext);
+        if (hasNext.value()) {
+            heap.emplace_back(i);
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        auto run = heap.back();
+        NG_RETURN_IF_ERROR(emit(std::move(heads[run])));
+        auto hasNext = next(run);
+        NG_RETURN_IF_ERROR(hasNext);
+        if (hasNext.value()) {
+            std::push_heap(heap.begin(), heap.end(), greater);
+        } else {
+            heap.pop_back();
+        }
+    }
+    return Status::OK();
+}
+
+int SortExecutor::compareKeys(const Value* const* lhs, const Value* const* rhs) const {
+    auto& factors = asNode<Sort>(node())->factors();
+    for (size_t i = 0; i < factors.size(); ++i) {
+        auto& lVal = *lhs[i];
+        auto& rVal = *rhs[i];
+        bool asc = factors[i].second == OrderFactor::OrderType::ASCEND;
+        // Compare the int and string keys directly, which are the most common sort keys
+        if (lVal.isInt() && rVal.isInt()) {
+            auto l = lVal.getInt();
+            auto r = rVal.getInt();
+            if (l == r) {
+                continue;
+            }
+            return (asc ? l < r : l > r) ? -1 : 1;
+        }
+        if (lVal.isStr() && rVal.isStr()) {
+            auto cmp = lVal.getStr().compare(rVal.getStr());
+            if (cmp == 0) {
+                continue;
+            }
+            return (asc ? cmp < 0 : cmp > 0) ? -1 : 1;
+        }
+
+        if (lVal == rVal) {
+            continue;
+        }
+        return (asc ? lVal < rVal : lVal > rVal) ? -1 : 1;
+    }
+    return 0;
+}
+
 }   // namespace graph
 }   // namespace nebula
@@ -8,6 +8,7 @@
 #define EXECUTOR_QUERY_SORTEXECUTOR_H_
 
 #include "executor/Executor.h"
+#include "util/SpillFile.h"
 
 namespace nebula {
 namespace graph {
@@ -18,6 +19,82 @@ public:
         : Executor("SortExecutor", node, qctx) {}
 
     folly::Future<Status> execute() override;
+
+private:
+    // Sort keys of a range of rows, the keys are extracted from the rows only once
+    struct SortChunk {
+        // Index of the first row of this chunk in the input
+        size_t                      begin{0};
+        // Keys of the i-th row are keys[i * numFactors, (i + 1) * numFactors)
+        std::vector<const Value*>   keys;
+        // Row indices relative to `begin' in the sorted order
+        std::vector<size_t>         order;
+    };
+
+    // Sorted runs spilled by one job, each record is | rowIdx | key1 | key2 | ... followed by
+    // the values of the row if the rows are spilled
+    struct SpilledRuns {
+        std::unique_ptr<SpillFile>                  file;
+        // The [begin, end) offsets of each run in the file
+        std::vector<std::pair<size_t, size_t>>      runs;
+    };
+
+    // Extract the sort keys of rows [begin, end) and sort them
+    SortChunk sortJob(size_t begin, size_t end, Iterator *iter) const;
+
+    // Sort rows [begin, end) by runs of at most `runSize' rows, and spill each run, along with
+    // the rows if `withRows'
+    StatusOr<SpilledRuns> spillJob(size_t begin,
+                                   size_t end,
+                                   Iterator *iter,
+                                   size_t runSize,
+                                   bool withRows) const;
+
+    // Whether the rows are spilled, so the input is released once all of them are in the
+    // files. Only the rows of a dataset read by nothing else than this sort are.
+    bool spillsRows(const Iterator *iter) const;
+
+    // Merge the sorted chunks, return the row indices of input in the sorted order
+    std::vector<size_t> mergeChunks(const std::vector<SortChunk> &chunks) const;
+
+    // Merge the spilled runs of the jobs by FLAGS_spill_merge_fanin runs at most at once,
+    // in multiple passes if there are more runs, and hand the records to `emit' in the
+    // sorted order.
+    Status mergeRuns(std::vector<SpilledRuns> &&jobs,
+                     const std::function<Status(Row &&)> &emit) const;
+
+    // Merge the records of `runs', and hand them to `emit' in the sorted order
+    Status mergeGroup(std::vector<SpillFile::Reader> &&runs,
+                      const std::function<Status(Row &&)> &emit) const;
+
+    // Reorder the rows of `iter' by `order' and finish with them
+    Status finishSorted(std::unique_ptr<Iterator> iter, const std::vector<size_t> &order);
+
+    // Return negative if lhs sorts before rhs, positive if after and 0 if equal
+    int compareKeys(const Value *const *lhs, const Value *const *rhs) const;
+
+    // Permute the rows in place by following the cycles of `order', so no copy of the
+    // rows is needed.
+    template <typename T, typename U>
+    void reorder(Iterator *iter, const std::vector<size_t> &order) {
+        auto uIter = static_cast<U *>(iter);
+        auto beg = uIter->begin();
+        std::vector<bool> placed(order.size(), false);
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (placed[i]) {
+                continue;
+            }
+            T row = std::move(beg[i]);
+            auto pos = i;
+            while (order[pos] != i) {
+                beg[pos] = std::move(beg[order[pos]]);
+                placed[pos] = true;
+                pos = order[pos];
+            }
+            beg[pos] = std::move(row);
+            placed[pos] = true;
+        }
+    }
 };
 
 }   // namespace graph
@@ -19,8 +19,8 @@ public:
 
     folly::Future<Status> execute() override;
 
-private:
-    std::vector<Value> extractList(Value &val);
+    // Values to unwind, a non-list value is taken as a list of itself
+    static std::vector<Value> extractList(Value &val);
 };
 
 }   // namespace graph
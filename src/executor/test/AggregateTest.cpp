@@ -9,6 +9,7 @@
 #include "context/QueryContext.h"
 #include "executor/query/AggregateExecutor.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -2189,5 +2190,211 @@ TEST_F(AggregateTest, BitXor) {
         TEST_AGG_4("BIT_XOR", "bit_xor", true)
     }
 }
+
+TEST_F(AggregateTest, MultiJobs) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1;
+    {
+        // ========
+        // | sum  |
+        // --------
+        // | 45   |
+        // --------
+        DataSet expected;
+        expected.colNames = {"sum"};
+        Row row;
+        row.emplace_back(45);
+        expected.rows.emplace_back(std::move(row));
+
+        // key =
+        // items = sum(col1)
+        TEST_AGG_1("SUM", "sum", false)
+    }
+    {
+        // ========
+        // | sum  |
+        // --------
+        // |   0  |
+        // --------
+        // |   2  |
+        // --------
+        // |   4  |
+        // --------
+        // |   6  |
+        // --------
+        // |   8  |
+        // --------
+        // | NULL |
+        // --------
+        DataSet expected;
+        expected.colNames = {"sum"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(2 * i);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2
+        // items = sum(col2)
+        TEST_AGG_2("SUM", "sum", false)
+    }
+    {
+        // ================
+        // | col2 | count |
+        // ----------------
+        // |  0   |   1   |
+        // ----------------
+        // |  1   |   1   |
+        // ----------------
+        // |  2   |   1   |
+        // ----------------
+        // |  3   |   1   |
+        // ----------------
+        // |  4   |   1   |
+        // ----------------
+        // | NULL |   0   |
+        // ----------------
+        DataSet expected;
+        expected.colNames = {"col2", "count"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(i);
+            row.values.emplace_back(1);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        row.values.emplace_back(0);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2, col3
+        // items = col2, count(distinct col3)
+        TEST_AGG_3("COUNT", "count", true)
+    }
+    {
+        // The AVG of each job is merged by its SUM and COUNT
+        DataSet expected;
+        expected.colNames = {"avg"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(i);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2
+        // items = avg(col2)
+        TEST_AGG_2("AVG", "avg", false)
+    }
+    {
+        // The lists of the jobs are concatenated in the order of rows
+        DataSet expected;
+        expected.colNames = {"list"};
+        Row row;
+        List list;
+        for (auto i = 0; i < 10; ++i) {
+            list.values.emplace_back(i);
+        }
+        row.emplace_back(std::move(list));
+        expected.rows.emplace_back(std::move(row));
+
+        // key =
+        // items = collect(col1)
+        TEST_AGG_1("COLLECT", "list", false)
+    }
+    {
+        // STD couldn't be merged, so it's aggregated by one job
+        DataSet expected;
+        expected.colNames = {"stdev"};
+        Row row;
+        row.emplace_back(2.87228132327);
+        expected.rows.emplace_back(std::move(row));
+
+        // key =
+        // items = stdev(col1)
+        TEST_AGG_1("STD", "stdev", false)
+    }
+}
+
+TEST_F(AggregateTest, Spill) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 2;
+    FLAGS_min_batch_size = 1;
+    // The partial groups of any job exceed such a budget
+    FLAGS_query_memory_budget_bytes = 1;
+    {
+        DataSet expected;
+        expected.colNames = {"sum"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(2 * i);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2
+        // items = sum(col2)
+        TEST_AGG_2("SUM", "sum", false)
+    }
+    {
+        DataSet expected;
+        expected.colNames = {"col2", "count"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(i);
+            row.values.emplace_back(1);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        row.values.emplace_back(0);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2, col3
+        // items = col2, count(distinct col3)
+        TEST_AGG_3("COUNT", "count", true)
+    }
+    {
+        // The AVG of each job is merged by its SUM and COUNT
+        DataSet expected;
+        expected.colNames = {"avg"};
+        for (auto i = 0; i < 5; ++i) {
+            Row row;
+            row.values.emplace_back(i);
+            expected.rows.emplace_back(std::move(row));
+        }
+        Row row;
+        row.values.emplace_back(Value::kNullValue);
+        expected.rows.emplace_back(std::move(row));
+
+        // key = col2
+        // items = avg(col2)
+        TEST_AGG_2("AVG", "avg", false)
+    }
+    {
+        // The lists of the jobs are concatenated in the order of rows
+        DataSet expected;
+        expected.colNames = {"list"};
+        Row row;
+        List list;
+        for (auto i = 0; i < 10; ++i) {
+            list.values.emplace_back(i);
+        }
+        row.emplace_back(std::move(list));
+        expected.rows.emplace_back(std::move(row));
+
+        // key =
+        // items = collect(col1)
+        TEST_AGG_1("COLLECT", "list", false)
+    }
+}
 }  // namespace graph
 }  // namespace nebula
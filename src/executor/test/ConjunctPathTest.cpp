@@ -23,13 +23,40 @@ protected:
         }
         return path;
     }
-    static bool comparePath(Row& row1, Row& row2) {
-        // row : path|  cost |
-        if (row1.values[1] != row2.values[1]) {
-            return row1.values[0] < row2.values[0];
+    static bool comparePath(const Row& row1, const Row& row2) {
+        return row1.values[0].toString() < row2.values[0].toString();
+    }
+
+    static Result neighbors(const std::string& edge,
+                            const std::vector<std::pair<std::string, std::string>>& edges) {
+        DataSet ds;
+        ds.colNames = {kVid, "_stats", "_edge:" + edge + ":_type:_dst:_rank", "_expr"};
+        for (auto& e : edges) {
+            List props;
+            props.values.emplace_back(edge.front() == '+' ? 1 : -1);
+            props.values.emplace_back(e.second);
+            props.values.emplace_back(0);
+            List edgeList;
+            edgeList.values.emplace_back(std::move(props));
+            ds.rows.emplace_back(Row({e.first, Value(), std::move(edgeList), Value()}));
+        }
+        List datasets;
+        datasets.values.emplace_back(std::move(ds));
+        return ResultBuilder()
+            .value(Value(std::move(datasets)))
+            .iter(Iterator::Kind::kGetNeighbors)
+            .finish();
+    }
+
+    static Result startVids(const std::vector<std::string>& vids) {
+        DataSet ds;
+        ds.colNames = {kVid};
+        for (auto& vid : vids) {
+            ds.rows.emplace_back(Row({vid}));
         }
-        return row1[0] < row2[0];
+        return ResultBuilder().value(Value(std::move(ds))).finish();
     }
+
     void multiplePairPathInit() {
         /*
          *  overall path is :
@@ -41,381 +68,49 @@ protected:
          *  startVids {0, 1, 2, 3}
          *  endVids {9, 12}
          */
-        qctx_->symTable()->newVariable("forwardPath1");
-        qctx_->symTable()->newVariable("forwardPath2");
-        qctx_->symTable()->newVariable("forwardPath3");
-        qctx_->symTable()->newVariable("backwardPath1");
-        qctx_->symTable()->newVariable("backwardPath2");
-        qctx_->symTable()->newVariable("backwardPath3");
-        qctx_->symTable()->newVariable("conditionalVar");
-        {
-            DataSet ds;
-            ds.colNames = {kVid, kVid};
-            std::vector<std::string> dst = {"9", "12"};
-            for (size_t i = 0; i < 4; i++) {
-                for (size_t j = 0; j < dst.size(); ++j) {
-                    Row row;
-                    row.values.emplace_back(folly::to<std::string>(i));
-                    row.values.emplace_back(dst[j]);
-                    ds.rows.emplace_back(std::move(row));
-                }
-            }
-            qctx_->ectx()->setResult("conditionalVar", ResultBuilder().value(ds).finish());
-        }
-        {
-            DataSet ds;
-            auto cost = 1;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 0->1
-                Row row;
-                Path path = createPath("0", {"1"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("1");
-                row.values.emplace_back("0");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 1->5
-                Row row;
-                Path path = createPath("1", {"5"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("5");
-                row.values.emplace_back("1");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 1->6
-                Row row;
-                Path path = createPath("1", {"6"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("6");
-                row.values.emplace_back("1");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 2->6
-                Row row;
-                Path path = createPath("2", {"6"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("6");
-                row.values.emplace_back("2");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 3->4
-                Row row;
-                Path path = createPath("3", {"4"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("4");
-                row.values.emplace_back("3");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("forwardPath1", ResultBuilder().value(ds).finish());
-        }
-        {
-            DataSet ds;
-            auto cost = 2;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 0->1->5
-                Row row;
-                Path path = createPath("0", {"1", "5"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("5");
-                row.values.emplace_back("0");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 0->1->6
-                Row row;
-                Path path = createPath("0", {"1", "6"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("6");
-                row.values.emplace_back("0");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 2->6->7
-                Row row;
-                Path path = createPath("2", {"6", "7"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("7");
-                row.values.emplace_back("2");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 3->4->7
-                Row row;
-                Path path = createPath("3", {"4", "7"}, 1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("7");
-                row.values.emplace_back("3");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 1->5->7, 1->6->7
-                List paths;
-                for (auto i = 5; i < 7; i++) {
-                    Path path = createPath("1", {folly::to<std::string>(i), "7"}, 1);
-                    paths.values.emplace_back(std::move(path));
-                }
-                Row row;
-                row.values.emplace_back("7");
-                row.values.emplace_back("1");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("forwardPath2", ResultBuilder().value(ds).finish());
-        }
-        {
-            DataSet ds;
-            auto cost = 3;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 0->1->5->7, 0->1->6->7
-                List paths;
-                for (auto i = 5; i < 7; i++) {
-                    Path path = createPath("0", {"1", folly::to<std::string>(i), "7"}, 1);
-                    paths.values.emplace_back(std::move(path));
-                }
-                Row row;
-                row.values.emplace_back("7");
-                row.values.emplace_back("0");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 1->5->7->8, 1->6->7->8
-                List paths;
-                for (auto i = 5; i < 7; i++) {
-                    Path path = createPath("1", {folly::to<std::string>(i), "7", "8"}, 1);
-                    paths.values.emplace_back(std::move(path));
-                }
-                Row row;
-                row.values.emplace_back("8");
-                row.values.emplace_back("1");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 2->6->7->8
-                List paths;
-                Path path = createPath("2", {"6", "7", "8"}, 1);
-                paths.values.emplace_back(std::move(path));
-                Row row;
-                row.values.emplace_back("8");
-                row.values.emplace_back("2");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 3->4->7->8
-                List paths;
-                Path path = createPath("3", {"4", "7", "8"}, 1);
-                paths.values.emplace_back(std::move(path));
-                Row row;
-                row.values.emplace_back("8");
-                row.values.emplace_back("3");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 1->5->7->10, 1->6->7->10
-                List paths;
-                for (auto i = 5; i < 7; i++) {
-                    Path path = createPath("1", {folly::to<std::string>(i), "7", "10"}, 1);
-                    paths.values.emplace_back(std::move(path));
-                }
-                Row row;
-                row.values.emplace_back("10");
-                row.values.emplace_back("1");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 2->6->7->10
-                List paths;
-                Path path = createPath("2", {"6", "7", "10"}, 1);
-                paths.values.emplace_back(std::move(path));
-                Row row;
-                row.values.emplace_back("10");
-                row.values.emplace_back("2");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 3->4->7->10
-                List paths;
-                Path path = createPath("3", {"4", "7", "10"}, 1);
-                paths.values.emplace_back(std::move(path));
-                Row row;
-                row.values.emplace_back("10");
-                row.values.emplace_back("3");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("forwardPath3", ResultBuilder().value(ds).finish());
-        }
-        // backward endVid {9, 12}
-        {
-            DataSet ds;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                Row row;
-                row.values = {"9", Value::kEmpty, 0, Value::kEmpty};
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                Row row;
-                row.values = {"12", Value::kEmpty, 0, Value::kEmpty};
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("backwardPath1", ResultBuilder().value(ds).finish());
+        qctx_->symTable()->newVariable("multi_forward");
+        qctx_->symTable()->newVariable("multi_backward");
+        qctx_->symTable()->newVariable("multi_forward_vids");
+        qctx_->symTable()->newVariable("multi_backward_vids");
+        qctx_->ectx()->setResult("multi_forward_vids", startVids({"0", "1", "2", "3"}));
+        qctx_->ectx()->setResult("multi_backward_vids", startVids({"9", "12"}));
+    }
 
-            DataSet ds1;
-            auto cost = 1;
-            ds1.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 9->8
-                Row row;
-                Path path = createPath("9", {"8"}, -1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("8");
-                row.values.emplace_back("9");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds1.rows.emplace_back(std::move(row));
-            }
-            {
-                // 12->11
-                Row row;
-                Path path = createPath("12", {"11"}, -1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("11");
-                row.values.emplace_back("12");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds1.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("backwardPath1", ResultBuilder().value(ds1).finish());
-            qctx_->ectx()->setResult("backwardPath2", ResultBuilder().value(ds1).finish());
-        }
-        {
-            DataSet ds;
-            auto cost = 2;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 9->8->7
-                Row row;
-                Path path = createPath("9", {"8", "7"}, -1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("7");
-                row.values.emplace_back("9");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                // 12->11->10
-                Row row;
-                Path path = createPath("12", {"11", "10"}, -1);
-
-                List paths;
-                paths.values.emplace_back(std::move(path));
-                row.values.emplace_back("10");
-                row.values.emplace_back("12");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("backwardPath2", ResultBuilder().value(ds).finish());
-            qctx_->ectx()->setResult("backwardPath3", ResultBuilder().value(ds).finish());
-        }
-        {
-            DataSet ds;
-            auto cost = 3;
-            ds.colNames = {"_dst", "_src", "cost", "paths"};
-            {
-                // 9->8->7->4, 9->8->7->5, 9->8->7->6
-                for (auto i = 4; i < 7; i++) {
-                    Row row;
-                    Path path = createPath("9", {"8", "7", folly::to<std::string>(i)}, -1);
-
-                    List paths;
-                    paths.values.emplace_back(std::move(path));
-                    row.values.emplace_back(folly::to<std::string>(i));
-                    row.values.emplace_back("9");
-                    row.values.emplace_back(cost);
-                    row.values.emplace_back(std::move(paths));
-                    ds.rows.emplace_back(std::move(row));
-                }
-            }
-            {
-                // 12->11->10->7
-                List paths;
-                Path path = createPath("12", {"11", "10", "7"}, -1);
-                paths.values.emplace_back(std::move(path));
-                Row row;
-                row.values.emplace_back("7");
-                row.values.emplace_back("12");
-                row.values.emplace_back(cost);
-                row.values.emplace_back(std::move(paths));
-                ds.rows.emplace_back(std::move(row));
-            }
-            qctx_->ectx()->setResult("backwardPath3", ResultBuilder().value(ds).finish());
+    // Set the edges fetched by both sides in the next round
+    void multiplePairRound(const std::vector<std::pair<std::string, std::string>>& forward,
+                           const std::vector<std::pair<std::string, std::string>>& backward) {
+        qctx_->ectx()->setResult("multi_forward", neighbors("+edge1", forward));
+        qctx_->ectx()->setResult("multi_backward", neighbors("-edge1", backward));
+    }
+
+    ConjunctPath* multiplePairConjunct(size_t steps) {
+        auto* conjunct = ConjunctPath::make(qctx_.get(),
+                                            StartNode::make(qctx_.get()),
+                                            StartNode::make(qctx_.get()),
+                                            ConjunctPath::PathKind::kMultiBFS,
+                                            steps);
+        conjunct->setLeftVar("multi_forward");
+        conjunct->setRightVar("multi_backward");
+        conjunct->setStartVidsVars("multi_forward_vids", "multi_backward_vids");
+        conjunct->setColNames({"_path"});
+        return conjunct;
+    }
+
+    DataSet sortedPaths(const std::string& var) {
+        auto ds = qctx_->ectx()->getResult(var).value().getDataSet();
+        std::sort(ds.rows.begin(), ds.rows.end(), comparePath);
+        return ds;
+    }
+
+    std::vector<std::string> startVidsOf(const std::string& var) {
+        std::vector<std::string> vids;
+        for (auto& row : qctx_->ectx()->getResult(var).value().getDataSet().rows) {
+            vids.emplace_back(row.values[0].getStr());
         }
+        std::sort(vids.begin(), vids.end());
+        return vids;
     }
+
     void biBfsInit() {
         qctx_->symTable()->newVariable("forward1");
         qctx_->symTable()->newVariable("backward1");
@@ -520,6 +215,15 @@ protected:
         }
     }
 
+    // A row of the paths found by ProduceAllPaths, `parent' is the row of the path it extends
+    static Row allPathsRow(const std::string& src,
+                           const std::string& dst,
+                           int type,
+                           int64_t parent,
+                           EdgeRanking ranking = 0) {
+        return Row({dst, Edge(src, dst, type, "edge1", ranking, {}), parent});
+    }
+
     void allPathInit() {
         qctx_->symTable()->newVariable("all_paths_forward1");
         qctx_->symTable()->newVariable("all_paths_backward1");
@@ -530,93 +234,43 @@ protected:
             // 1->2
             // 1->3
             DataSet ds;
-            ds.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("1", {"2"}, 1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"2", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
-            {
-                Row row;
-                List paths;
-                Path path = createPath("1", {"3"}, 1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"3", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
+            ds.colNames = {kVid, "edge", "parent"};
+            ds.rows.emplace_back(allPathsRow("1", "2", 1, -1));
+            ds.rows.emplace_back(allPathsRow("1", "3", 1, -1));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds).finish());
         }
         {
             // 4->7
             DataSet ds2;
-            ds2.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("4", {"7"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"7", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, "edge", "parent"};
+            ds2.rows.emplace_back(allPathsRow("4", "7", -1, -1));
             qctx_->ectx()->setResult("all_paths_backward1", ResultBuilder().value(ds2).finish());
         }
         {
             // 2
             DataSet ds1;
-            ds1.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path;
-                path.src = Vertex("2", {});
-                paths.values.emplace_back(std::move(path));
-                row.values = {"2", std::move(paths)};
-                ds1.rows.emplace_back(std::move(row));
-            }
+            ds1.colNames = {kVid, "edge", "parent"};
+            ds1.rows.emplace_back(Row({"2", Value(), -1}));
             qctx_->ectx()->setResult("all_paths_backward2", ResultBuilder().value(ds1).finish());
 
             // 2->7
             DataSet ds2;
-            ds2.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("2", {"7"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"7", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, "edge", "parent"};
+            ds2.rows.emplace_back(allPathsRow("2", "7", -1, -1));
             qctx_->ectx()->setResult("all_paths_backward2", ResultBuilder().value(ds2).finish());
         }
         {
             // 4->3
             DataSet ds2;
-            ds2.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("4", {"3"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"3", std::move(paths)};
-                ds2.rows.emplace_back(std::move(row));
-            }
+            ds2.colNames = {kVid, "edge", "parent"};
+            ds2.rows.emplace_back(allPathsRow("4", "3", -1, -1));
             qctx_->ectx()->setResult("all_paths_backward3", ResultBuilder().value(ds2).finish());
         }
         {
             // 5->4
             DataSet ds;
-            ds.colNames = {kVid, "path"};
-            {
-                Row row;
-                List paths;
-                Path path = createPath("5", {"4"}, -1);
-                paths.values.emplace_back(std::move(path));
-                row.values = {"4", std::move(paths)};
-                ds.rows.emplace_back(std::move(row));
-            }
+            ds.colNames = {kVid, "edge", "parent"};
+            ds.rows.emplace_back(allPathsRow("5", "4", -1, -1));
             qctx_->ectx()->setResult("all_paths_backward4", ResultBuilder().value(ds).finish());
         }
     }
@@ -878,6 +532,131 @@ TEST_F(ConjunctPathTest, BiBFSFourStepsPath) {
     }
 }
 
+TEST_F(ConjunctPathTest, BiBFSExpandCheaperSide) {
+    auto setResult = [this](const std::string& var, std::vector<Row> rows) {
+        DataSet ds;
+        ds.colNames = {kVid, "edge"};
+        ds.rows = std::move(rows);
+        qctx_->ectx()->setResult(var, ResultBuilder().value(Value(std::move(ds))).finish());
+    };
+    qctx_->symTable()->newVariable("cheaper_forward");
+    qctx_->symTable()->newVariable("cheaper_backward");
+    qctx_->symTable()->newVariable("cheaper_forward_vids");
+    qctx_->symTable()->newVariable("cheaper_backward_vids");
+    // 1->2, 1->3, 1->4
+    setResult("cheaper_forward", {Row({"1", Value::kEmpty})});
+    setResult("cheaper_forward",
+              {Row({"2", Edge("1", "2", 1, "edge1", 0, {})}),
+               Row({"3", Edge("1", "3", 1, "edge1", 0, {})}),
+               Row({"4", Edge("1", "4", 1, "edge1", 0, {})})});
+    // 9->8
+    setResult("cheaper_backward", {Row({"9", Value::kEmpty})});
+    setResult("cheaper_backward", {Row({"8", Edge("9", "8", -1, "edge1", 0, {})})});
+
+    auto* conjunct = ConjunctPath::make(qctx_.get(),
+                                        StartNode::make(qctx_.get()),
+                                        StartNode::make(qctx_.get()),
+                                        ConjunctPath::PathKind::kBiBFS,
+                                        5);
+    conjunct->setLeftVar("cheaper_forward");
+    conjunct->setRightVar("cheaper_backward");
+    conjunct->setStartVidsVars("cheaper_forward_vids", "cheaper_backward_vids");
+    conjunct->setColNames({"_path"});
+
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    {
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
+        EXPECT_TRUE(result.value().getDataSet().rows.empty());
+
+        // Only the backward side is expanded next
+        auto& forwardVids = qctx_->ectx()->getResult("cheaper_forward_vids");
+        EXPECT_TRUE(forwardVids.value().getDataSet().rows.empty());
+        DataSet expected;
+        expected.colNames = {kVid};
+        expected.rows.emplace_back(Row({"8"}));
+        EXPECT_EQ(qctx_->ectx()->getResult("cheaper_backward_vids").value().getDataSet(),
+                  expected);
+    }
+    {
+        // Nothing fetched by the forward side
+        setResult("cheaper_forward", {});
+        // 8->2
+        setResult("cheaper_backward", {Row({"2", Edge("8", "2", -1, "edge1", 0, {})})});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
+
+        DataSet expected;
+        expected.colNames = {"_path"};
+        Row row;
+        row.values.emplace_back(createPath("1", {"2", "8", "9"}, 1));
+        expected.rows.emplace_back(std::move(row));
+        EXPECT_EQ(result.value().getDataSet(), expected);
+    }
+}
+
+TEST_F(ConjunctPathTest, WeightedLightestPath) {
+    // 1->2: 1, 2->3: 1, 1->3: 5
+    auto weighted = [](const std::string& edge,
+                       const std::vector<std::tuple<std::string, std::string, double>>& edges) {
+        DataSet ds;
+        ds.colNames = {kVid, "_stats", "_edge:" + edge + ":_type:_dst:_rank:weight", "_expr"};
+        for (auto& e : edges) {
+            List props;
+            props.values.emplace_back(edge.front() == '+' ? 1 : -1);
+            props.values.emplace_back(std::get<1>(e));
+            props.values.emplace_back(0);
+            props.values.emplace_back(std::get<2>(e));
+            List edgeList;
+            edgeList.values.emplace_back(std::move(props));
+            ds.rows.emplace_back(Row({std::get<0>(e), Value(), std::move(edgeList), Value()}));
+        }
+        List datasets;
+        datasets.values.emplace_back(std::move(ds));
+        return ResultBuilder()
+            .value(Value(std::move(datasets)))
+            .iter(Iterator::Kind::kGetNeighbors)
+            .finish();
+    };
+    qctx_->symTable()->newVariable("weighted_forward");
+    qctx_->symTable()->newVariable("weighted_backward");
+    qctx_->symTable()->newVariable("weighted_forward_vids");
+    qctx_->symTable()->newVariable("weighted_backward_vids");
+    qctx_->ectx()->setResult("weighted_forward_vids", startVids({"1"}));
+    qctx_->ectx()->setResult("weighted_backward_vids", startVids({"3"}));
+    qctx_->ectx()->setResult("weighted_forward",
+                             weighted("+edge1", {{"1", "2", 1.0}, {"1", "3", 5.0}}));
+    qctx_->ectx()->setResult("weighted_backward",
+                             weighted("-edge1", {{"3", "2", 1.0}, {"3", "1", 5.0}}));
+
+    auto* conjunct = ConjunctPath::make(qctx_.get(),
+                                        StartNode::make(qctx_.get()),
+                                        StartNode::make(qctx_.get()),
+                                        ConjunctPath::PathKind::kWeighted,
+                                        2);
+    conjunct->setLeftVar("weighted_forward");
+    conjunct->setRightVar("weighted_backward");
+    conjunct->setStartVidsVars("weighted_forward_vids", "weighted_backward_vids");
+    conjunct->setWeightProp("weight");
+    conjunct->setColNames({"_path", "weight"});
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    auto status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+
+    // All the edges within the steps are fetched by one round of both sides
+    EXPECT_TRUE(
+        qctx_->ectx()->getResult("weighted_forward_vids").value().getDataSet().rows.empty());
+    EXPECT_TRUE(
+        qctx_->ectx()->getResult("weighted_backward_vids").value().getDataSet().rows.empty());
+    auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
+    DataSet expected;
+    expected.colNames = {"_path", "weight"};
+    expected.rows.emplace_back(Row({createPath("1", {"2", "3"}, 1), 2.0}));
+    EXPECT_EQ(result.value().getDataSet(), expected);
+}
+
 TEST_F(ConjunctPathTest, AllPathsNoPath) {
     auto* conjunct = ConjunctPath::make(qctx_.get(),
                                         StartNode::make(qctx_.get()),
@@ -980,23 +759,9 @@ TEST_F(ConjunctPathTest, AllPathsThreeStepsPath) {
             // 1->2->4@0
             // 1->2->4@1
             DataSet ds1;
-            ds1.colNames = {kVid, "path"};
-
-            Row row;
-            List paths;
-            {
-                Path path = createPath("1", {"2", "4"}, 1);
-                paths.values.emplace_back(std::move(path));
-            }
-            {
-                Path path;
-                path.src = Vertex("1", {});
-                path.steps.emplace_back(Step(Vertex("2", {}), 1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("4", {}), 1, "edge1", 1, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"4", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, "edge", "parent"};
+            ds1.rows.emplace_back(allPathsRow("2", "4", 1, 0));
+            ds1.rows.emplace_back(allPathsRow("2", "4", 1, 0, 1));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds1).finish());
         }
         auto future = conjunctExe->execute();
@@ -1057,41 +822,16 @@ TEST_F(ConjunctPathTest, AllPathsFourStepsPath) {
             // 1->2->6@0
             // 1->2->6@1
             DataSet ds1;
-            ds1.colNames = {kVid, "path"};
-
-            Row row;
-            List paths;
-            {
-                Path path = createPath("1", {"2", "6"}, 1);
-                paths.values.emplace_back(std::move(path));
-            }
-            {
-                Path path;
-                path.src = Vertex("1", {});
-                path.steps.emplace_back(Step(Vertex("2", {}), 1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("6", {}), 1, "edge1", 1, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"6", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, "edge", "parent"};
+            ds1.rows.emplace_back(allPathsRow("2", "6", 1, 0));
+            ds1.rows.emplace_back(allPathsRow("2", "6", 1, 0, 1));
             qctx_->ectx()->setResult("all_paths_forward1", ResultBuilder().value(ds1).finish());
         }
         {
             // 5->4->6@0
             DataSet ds1;
-            ds1.colNames = {kVid, "path"};
-
-            Row row;
-            List paths;
-            {
-                Path path;
-                path.src = Vertex("5", {});
-                path.steps.emplace_back(Step(Vertex("4", {}), -1, "edge1", 0, {}));
-                path.steps.emplace_back(Step(Vertex("6", {}), -1, "edge1", 0, {}));
-                paths.values.emplace_back(std::move(path));
-            }
-            row.values = {"6", std::move(paths)};
-            ds1.rows.emplace_back(std::move(row));
+            ds1.colNames = {kVid, "edge", "parent"};
+            ds1.rows.emplace_back(allPathsRow("4", "6", -1, 0));
             qctx_->ectx()->setResult("all_paths_backward4", ResultBuilder().value(ds1).finish());
         }
         auto future = conjunctExe->execute();
@@ -1124,148 +864,226 @@ TEST_F(ConjunctPathTest, AllPathsFourStepsPath) {
     }
 }
 
-TEST_F(ConjunctPathTest, multiplePairOneStep) {
+TEST_F(ConjunctPathTest, AllPathsDropHistory) {
     auto* conjunct = ConjunctPath::make(qctx_.get(),
                                         StartNode::make(qctx_.get()),
                                         StartNode::make(qctx_.get()),
-                                        ConjunctPath::PathKind::kFloyd,
+                                        ConjunctPath::PathKind::kAllPaths,
                                         5);
-    conjunct->setLeftVar("forwardPath1");
-    conjunct->setRightVar("backwardPath1");
-    conjunct->setColNames({"_path", "cost"});
-    conjunct->setConditionalVar("conditionalVar");
-    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
-    auto future = conjunctExe->execute();
-    auto status = std::move(future).get();
-    EXPECT_TRUE(status.ok());
-    auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
-
-    DataSet expected;
-    expected.colNames = {"_path", "cost"};
-    EXPECT_EQ(result.value().getDataSet(), expected);
-    EXPECT_EQ(result.state(), Result::State::kSuccess);
-}
+    conjunct->setLeftVar("all_paths_forward1");
+    conjunct->setRightVar("all_paths_backward4");
+    conjunct->setColNames({"_path"});
 
-TEST_F(ConjunctPathTest, multiplePairTwoSteps) {
-    auto* conjunct = ConjunctPath::make(qctx_.get(),
-                                        StartNode::make(qctx_.get()),
-                                        StartNode::make(qctx_.get()),
-                                        ConjunctPath::PathKind::kFloyd,
-                                        5);
-    conjunct->setLeftVar("forwardPath2");
-    conjunct->setRightVar("backwardPath2");
-    conjunct->setColNames({"_path", "cost"});
-    conjunct->setConditionalVar("conditionalVar");
     auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
-    auto future = conjunctExe->execute();
-    auto status = std::move(future).get();
-    EXPECT_TRUE(status.ok());
-    auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
+    auto* ectx = qctx_->ectx();
+    auto setResult = [ectx](const std::string& var, std::vector<Row> rows) {
+        DataSet ds;
+        ds.colNames = {kVid, "edge", "parent"};
+        ds.rows = std::move(rows);
+        ectx->setResult(var, ResultBuilder().value(Value(std::move(ds))).finish());
+    };
 
-    DataSet expected;
-    expected.colNames = {"_path", "cost"};
     {
-        // 1->5->7->8->9, 1->6->7->8->9
-        for (auto i = 5; i < 7; i++) {
-            Row row;
-            Path path = createPath("1", {folly::to<std::string>(i), "7", "8", "9"}, 1);
-            row.values.emplace_back(std::move(path));
-            row.values.emplace_back(4);
-            expected.rows.emplace_back(std::move(row));
-        }
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        EXPECT_EQ(ectx->getHistory("all_paths_forward1").size(), 1u);
+        EXPECT_EQ(ectx->getHistory("all_paths_backward4").size(), 1u);
     }
     {
-        // 2->6->7->8->9
-        Row row;
-        Path path = createPath("2", {"6", "7", "8", "9"}, 1);
-        row.values.emplace_back(std::move(path));
-        row.values.emplace_back(4);
-        expected.rows.emplace_back(std::move(row));
+        // 1->2->6, 5->4->6
+        setResult("all_paths_forward1", {allPathsRow("2", "6", 1, 0)});
+        setResult("all_paths_backward4", {allPathsRow("4", "6", -1, 0)});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        // Only the latest result of each side is kept
+        EXPECT_EQ(ectx->getHistory("all_paths_forward1").size(), 1u);
+        EXPECT_EQ(ectx->getHistory("all_paths_backward4").size(), 1u);
+        auto& result = ectx->getResult(conjunct->outputVar());
+        ASSERT_EQ(result.value().getDataSet().rows.size(), 1u);
+        EXPECT_EQ(result.value().getDataSet().rows[0],
+                  Row({createPath("1", {"2", "6", "4", "5"}, 1)}));
     }
     {
-        // 3->4->7->8->9
-        Row row;
-        Path path = createPath("3", {"4", "7", "8", "9"}, 1);
-        row.values.emplace_back(std::move(path));
-        row.values.emplace_back(4);
-        expected.rows.emplace_back(std::move(row));
+        // 1->3->4, the paths of the dropped results are still built
+        setResult("all_paths_forward1", {allPathsRow("3", "4", 1, 1)});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        EXPECT_EQ(ectx->getHistory("all_paths_forward1").size(), 1u);
+        EXPECT_EQ(ectx->getHistory("all_paths_backward4").size(), 1u);
+        auto& result = ectx->getResult(conjunct->outputVar());
+        ASSERT_EQ(result.value().getDataSet().rows.size(), 1u);
+        EXPECT_EQ(result.value().getDataSet().rows[0],
+                  Row({createPath("1", {"3", "4", "5"}, 1)}));
     }
-    std::sort(expected.rows.begin(), expected.rows.end(), comparePath);
-    auto resultDs = result.value().getDataSet();
-    std::sort(resultDs.rows.begin(), resultDs.rows.end(), comparePath);
-    EXPECT_EQ(resultDs, expected);
-    EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
-TEST_F(ConjunctPathTest, multiplePairThreeSteps) {
-    auto* conjunct = ConjunctPath::make(qctx_.get(),
-                                        StartNode::make(qctx_.get()),
-                                        StartNode::make(qctx_.get()),
-                                        ConjunctPath::PathKind::kFloyd,
-                                        5);
-    conjunct->setLeftVar("forwardPath3");
-    conjunct->setRightVar("backwardPath3");
-    conjunct->setColNames({"_path", "cost"});
-    conjunct->setConditionalVar("conditionalVar");
+TEST_F(ConjunctPathTest, MultiplePairPaths) {
+    auto* conjunct = multiplePairConjunct(6);
     auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
-    auto future = conjunctExe->execute();
-    auto status = std::move(future).get();
-    EXPECT_TRUE(status.ok());
-    auto& result = qctx_->ectx()->getResult(conjunct->outputVar());
-
     DataSet expected;
-    expected.colNames = {"_path", "cost"};
+    expected.colNames = {"_path"};
     {
-        // 1->5->7->10->11->12, 1->6->7->10->11->12
+        multiplePairRound({{"0", "1"}, {"1", "5"}, {"1", "6"}, {"2", "6"}, {"3", "4"}},
+                          {{"9", "8"}, {"12", "11"}});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+        // 1 is reached by 0, but it's fetched as a start already
+        EXPECT_EQ(startVidsOf("multi_forward_vids"), std::vector<std::string>({"4", "5", "6"}));
+        EXPECT_EQ(startVidsOf("multi_backward_vids"), std::vector<std::string>({"11", "8"}));
+    }
+    {
+        multiplePairRound({{"5", "7"}, {"6", "7"}, {"4", "7"}}, {{"8", "7"}, {"11", "10"}});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        // 1->5->7->8->9, 1->6->7->8->9, 2->6->7->8->9, 3->4->7->8->9
         for (auto i = 5; i < 7; i++) {
-            Row row;
-            Path path = createPath("1", {folly::to<std::string>(i), "7", "10", "11", "12"}, 1);
-            row.values.emplace_back(std::move(path));
-            row.values.emplace_back(5);
-            expected.rows.emplace_back(std::move(row));
+            expected.rows.emplace_back(
+                Row({createPath("1", {folly::to<std::string>(i), "7", "8", "9"}, 1)}));
         }
+        expected.rows.emplace_back(Row({createPath("2", {"6", "7", "8", "9"}, 1)}));
+        expected.rows.emplace_back(Row({createPath("3", {"4", "7", "8", "9"}, 1)}));
+        std::sort(expected.rows.begin(), expected.rows.end(), comparePath);
+        EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+        EXPECT_EQ(startVidsOf("multi_forward_vids"), std::vector<std::string>({"7"}));
+        EXPECT_EQ(startVidsOf("multi_backward_vids"), std::vector<std::string>({"10", "7"}));
     }
     {
-        // 0->1->5->7->8->9, 0->1->6->7->8->9
+        multiplePairRound({{"7", "8"}, {"7", "10"}},
+                          {{"7", "5"}, {"7", "6"}, {"7", "4"}, {"10", "7"}});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        expected.rows.clear();
         for (auto i = 5; i < 7; i++) {
-            Row row;
-            Path path = createPath("0", {"1", folly::to<std::string>(i), "7", "8", "9"}, 1);
-            row.values.emplace_back(std::move(path));
-            row.values.emplace_back(5);
-            expected.rows.emplace_back(std::move(row));
+            auto vid = folly::to<std::string>(i);
+            // 0->1->5->7->8->9, 0->1->6->7->8->9
+            expected.rows.emplace_back(Row({createPath("0", {"1", vid, "7", "8", "9"}, 1)}));
+            // 1->5->7->10->11->12, 1->6->7->10->11->12
+            expected.rows.emplace_back(Row({createPath("1", {vid, "7", "10", "11", "12"}, 1)}));
+            // 0->1->5->7->10->11->12, 0->1->6->7->10->11->12
+            expected.rows.emplace_back(
+                Row({createPath("0", {"1", vid, "7", "10", "11", "12"}, 1)}));
         }
+        // 2->6->7->10->11->12, 3->4->7->10->11->12
+        expected.rows.emplace_back(Row({createPath("2", {"6", "7", "10", "11", "12"}, 1)}));
+        expected.rows.emplace_back(Row({createPath("3", {"4", "7", "10", "11", "12"}, 1)}));
+        std::sort(expected.rows.begin(), expected.rows.end(), comparePath);
+        EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+        // All the pairs are met
+        EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+        EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
     }
+}
+
+TEST_F(ConjunctPathTest, MultiplePairWithinSteps) {
+    // The paths of 5 steps are met in the third round, which is beyond the steps
+    auto* conjunct = multiplePairConjunct(4);
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    multiplePairRound({{"0", "1"}, {"1", "5"}, {"1", "6"}, {"2", "6"}, {"3", "4"}},
+                      {{"9", "8"}, {"12", "11"}});
+    auto status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+
+    multiplePairRound({{"5", "7"}, {"6", "7"}, {"4", "7"}}, {{"8", "7"}, {"11", "10"}});
+    status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(sortedPaths(conjunct->outputVar()).rows.size(), 4u);
+    EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+    EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
+}
+
+TEST_F(ConjunctPathTest, MultiplePairNoPath) {
+    auto* conjunct = multiplePairConjunct(6);
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    // Nothing more is reached backward
+    multiplePairRound({{"0", "1"}, {"1", "5"}, {"1", "6"}, {"2", "6"}, {"3", "4"}}, {});
+    auto status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+    DataSet expected;
+    expected.colNames = {"_path"};
+    EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+    EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+    EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
+}
+
+TEST_F(ConjunctPathTest, MultiplePairSomeNoPath) {
+    // 1->7, 2->7, 7->9, 7->8, nothing from 3 or to 12
+    qctx_->ectx()->setResult("multi_forward_vids", startVids({"1", "2", "3"}));
+    auto* conjunct = multiplePairConjunct(4);
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
     {
-        // 2->6->7->10->11->12
-        Row row;
-        Path path = createPath("2", {"6", "7", "10", "11", "12"}, 1);
-        row.values.emplace_back(std::move(path));
-        row.values.emplace_back(5);
-        expected.rows.emplace_back(std::move(row));
+        multiplePairRound({{"1", "7"}, {"2", "7"}}, {{"9", "7"}});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        DataSet expected;
+        expected.colNames = {"_path"};
+        expected.rows.emplace_back(Row({createPath("1", {"7", "9"}, 1)}));
+        expected.rows.emplace_back(Row({createPath("2", {"7", "9"}, 1)}));
+        EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+        // The pairs of 3 and 12 are left
+        EXPECT_EQ(startVidsOf("multi_forward_vids"), std::vector<std::string>({"7"}));
+        EXPECT_EQ(startVidsOf("multi_backward_vids"), std::vector<std::string>({"7"}));
     }
     {
-        // 3->4->7->10->11->12
-        Row row;
-        Path path = createPath("3", {"4", "7", "10", "11", "12"}, 1);
-        row.values.emplace_back(std::move(path));
-        row.values.emplace_back(5);
-        expected.rows.emplace_back(std::move(row));
+        // Nothing more is reached backward, so the pairs left have no path
+        multiplePairRound({{"7", "8"}}, {});
+        auto status = conjunctExe->execute().get();
+        EXPECT_TRUE(status.ok());
+        DataSet expected;
+        expected.colNames = {"_path"};
+        EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+        EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+        EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
     }
-    {
-        // 0->1->5->7->10->11->12, 0->1->6->7->10->11->12
-        for (auto i = 5; i < 7; i++) {
-            Row row;
-            Path path = createPath("0", {"1", folly::to<std::string>(i), "7", "10", "11", "12"}, 1);
-            row.values.emplace_back(std::move(path));
-            row.values.emplace_back(6);
-            expected.rows.emplace_back(std::move(row));
-        }
+}
+
+TEST_F(ConjunctPathTest, MultiplePairDuplicateStarts) {
+    // Each pair is searched once however many times its vids are given
+    qctx_->ectx()->setResult("multi_forward_vids", startVids({"1", "1", "2", "1"}));
+    qctx_->ectx()->setResult("multi_backward_vids", startVids({"9", "9"}));
+    auto* conjunct = multiplePairConjunct(4);
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    multiplePairRound({{"1", "7"}, {"2", "7"}}, {{"9", "7"}});
+    auto status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+    DataSet expected;
+    expected.colNames = {"_path"};
+    expected.rows.emplace_back(Row({createPath("1", {"7", "9"}, 1)}));
+    expected.rows.emplace_back(Row({createPath("2", {"7", "9"}, 1)}));
+    EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+    // All the pairs are met
+    EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+    EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
+}
+
+TEST_F(ConjunctPathTest, MultiplePairManySources) {
+    // More sources than a word holds, each with two shortest paths to the target:
+    // s->a->t and s->b->t
+    std::vector<std::string> sources;
+    std::vector<std::pair<std::string, std::string>> forward;
+    for (auto i = 0; i < 70; ++i) {
+        sources.emplace_back("s" + folly::to<std::string>(i));
+        forward.emplace_back(sources.back(), "a");
+        forward.emplace_back(sources.back(), "b");
+    }
+    qctx_->ectx()->setResult("multi_forward_vids", startVids(sources));
+    qctx_->ectx()->setResult("multi_backward_vids", startVids({"t"}));
+    auto* conjunct = multiplePairConjunct(2);
+    auto conjunctExe = std::make_unique<ConjunctPathExecutor>(conjunct, qctx_.get());
+    multiplePairRound(forward, {{"t", "a"}, {"t", "b"}});
+    auto status = conjunctExe->execute().get();
+    EXPECT_TRUE(status.ok());
+
+    DataSet expected;
+    expected.colNames = {"_path"};
+    for (auto& source : sources) {
+        expected.rows.emplace_back(Row({createPath(source, {"a", "t"}, 1)}));
+        expected.rows.emplace_back(Row({createPath(source, {"b", "t"}, 1)}));
     }
     std::sort(expected.rows.begin(), expected.rows.end(), comparePath);
-    auto resultDs = result.value().getDataSet();
-    std::sort(resultDs.rows.begin(), resultDs.rows.end(), comparePath);
-    EXPECT_EQ(resultDs, expected);
-    EXPECT_EQ(result.state(), Result::State::kSuccess);
+    EXPECT_EQ(sortedPaths(conjunct->outputVar()), expected);
+    EXPECT_TRUE(startVidsOf("multi_forward_vids").empty());
+    EXPECT_TRUE(startVidsOf("multi_backward_vids").empty());
 }
 
 }  // namespace graph
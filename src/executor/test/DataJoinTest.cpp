@@ -10,6 +10,7 @@
 #include "planner/Query.h"
 #include "executor/query/DataJoinExecutor.h"
 #include "executor/test/QueryTestBase.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -150,6 +151,39 @@ TEST_F(DataJoinTest, Join) {
     testJoin("var2", "var1", expected, __LINE__);
 }
 
+TEST_F(DataJoinTest, JoinMultiJobs) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 3;
+    FLAGS_min_batch_size = 1;
+
+    DataSet expected;
+    expected.colNames = {
+        "src", "dst", kVid, "tag_prop", "edge_prop", kDst};
+    for (auto i = 11; i < 16; ++i) {
+        Row row1;
+        row1.values.emplace_back(folly::to<std::string>(i));
+        row1.values.emplace_back(folly::to<std::string>(i % 11));
+        row1.values.emplace_back(folly::to<std::string>(i % 11));
+        row1.values.emplace_back(i % 11 * 2);
+        row1.values.emplace_back(i % 11 * 2 + 1);
+        row1.values.emplace_back(folly::to<std::string>(i - 6));
+        expected.rows.emplace_back(std::move(row1));
+
+        Row row2;
+        row2.values.emplace_back(folly::to<std::string>(i));
+        row2.values.emplace_back(folly::to<std::string>(i % 11));
+        row2.values.emplace_back(folly::to<std::string>(i % 11));
+        row2.values.emplace_back(i % 11 * 2 + 1);
+        row2.values.emplace_back(i % 11 * 2 + 2);
+        row2.values.emplace_back(folly::to<std::string>(i - 5));
+        expected.rows.emplace_back(std::move(row2));
+    }
+
+    // $var1 inner join $var2 on $var2.dst = $var1._vid, both the hash table building and
+    // probing are split into multiple jobs
+    testJoin("var2", "var1", expected, __LINE__);
+}
+
 TEST_F(DataJoinTest, JoinTwice) {
     std::string join;
     {
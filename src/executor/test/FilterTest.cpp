@@ -10,6 +10,7 @@
 #include "executor/query/ProjectExecutor.h"
 #include "executor/test/QueryTestBase.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
 #include "util/ExpressionUtils.h"
 
 namespace nebula {
@@ -101,5 +102,19 @@ TEST_F(FilterTest, TestEmpty) {
                         "YIELD $^.person.name AS name WHERE study.start_year >= 2010",
                         expected);
 }
+
+TEST_F(FilterTest, TestMultiJobs) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 3;
+    FLAGS_min_batch_size = 1;
+
+    DataSet expected({"name"});
+    expected.emplace_back(Row({Value("Ann")}));
+    expected.emplace_back(Row({Value("Ann")}));
+    FILTER_RESUTL_CHECK("input_sequential",
+                        "filter_sequential",
+                        "YIELD $-.v_name AS name WHERE $-.e_start_year >= 2010",
+                        expected);
+}
 }   // namespace graph
 }   // namespace nebula
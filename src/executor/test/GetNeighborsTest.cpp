@@ -9,6 +9,7 @@
 #include "context/QueryContext.h"
 #include "planner/Query.h"
 #include "executor/query/GetNeighborsExecutor.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -82,5 +83,172 @@ TEST_F(GetNeighborsTest, BuildRequestDataSet) {
     auto& reqDs = gnExe->reqDs_;
     EXPECT_EQ(reqDs, expected);
 }
+
+TEST_F(GetNeighborsTest, SplitRequest) {
+    auto* pool = qctx_->objPool();
+    auto* vids = pool->add(new InputPropertyExpression(new std::string("id")));
+    auto* gn = GetNeighbors::make(
+            qctx_.get(),
+            nullptr,
+            0,
+            vids,
+            std::vector<EdgeType>(),
+            storage::cpp2::EdgeDirection::BOTH,
+            std::make_unique<std::vector<storage::cpp2::VertexProp>>(),
+            std::make_unique<std::vector<storage::cpp2::EdgeProp>>(),
+            std::make_unique<std::vector<storage::cpp2::StatProp>>(),
+            std::make_unique<std::vector<storage::cpp2::Expr>>());
+    gn->setInputVar("input_gn");
+
+    gflags::FlagSaver flagSaver;
+    auto split = [gn, this](uint32_t numParts) {
+        FLAGS_get_neighbors_parts = numParts;
+        auto gnExe = std::make_unique<GetNeighborsExecutor>(gn, qctx_.get());
+        EXPECT_TRUE(gnExe->buildRequestDataSet().ok());
+        auto parts = gnExe->splitRequest();
+        EXPECT_TRUE(gnExe->reqDs_.rows.empty());
+        return parts;
+    };
+    {
+        auto parts = split(3);
+        EXPECT_LE(parts.size(), 3);
+        std::unordered_set<Value> unique;
+        for (auto& part : parts) {
+            EXPECT_FALSE(part.empty());
+            for (auto& row : part) {
+                EXPECT_TRUE(unique.emplace(row.values[0]).second);
+            }
+        }
+        EXPECT_EQ(unique.size(), 10);
+        // The parts are decided by the vertex ids only
+        EXPECT_EQ(parts, split(3));
+    }
+    {
+        // No more parts than the vertices
+        auto parts = split(100);
+        EXPECT_LE(parts.size(), 10);
+        size_t numRows = 0;
+        for (auto& part : parts) {
+            numRows += part.size();
+        }
+        EXPECT_EQ(numRows, 10);
+    }
+    {
+        // The large parts are split into batches
+        FLAGS_get_neighbors_batch_size = 3;
+        auto batches = split(1);
+        ASSERT_EQ(batches.size(), 4);
+        EXPECT_EQ(batches[0].size(), 3);
+        EXPECT_EQ(batches[3].size(), 1);
+        EXPECT_EQ(batches[0][0].values[0], "0");
+        EXPECT_EQ(batches[3][0].values[0], "9");
+
+        FLAGS_get_neighbors_batch_size = 100;
+        EXPECT_EQ(split(1).size(), 1);
+    }
+}
+
+TEST_F(GetNeighborsTest, LookupCache) {
+    auto* pool = qctx_->objPool();
+    auto* vids = pool->add(new InputPropertyExpression(new std::string("id")));
+    auto makeGN = [this, vids](storage::cpp2::EdgeDirection direction) {
+        auto* gn = GetNeighbors::make(
+                qctx_.get(),
+                nullptr,
+                0,
+                vids,
+                std::vector<EdgeType>({1}),
+                direction,
+                std::make_unique<std::vector<storage::cpp2::VertexProp>>(),
+                std::make_unique<std::vector<storage::cpp2::EdgeProp>>(),
+                std::make_unique<std::vector<storage::cpp2::StatProp>>(),
+                std::make_unique<std::vector<storage::cpp2::Expr>>());
+        gn->setInputVar("input_gn");
+        return gn;
+    };
+    auto* out = makeGN(storage::cpp2::EdgeDirection::OUT_EDGE);
+    auto* in = makeGN(storage::cpp2::EdgeDirection::IN_EDGE);
+    EXPECT_TRUE(GetNeighborsExecutor::cacheable(out));
+    EXPECT_NE(GetNeighborsExecutor::signature(out), GetNeighborsExecutor::signature(in));
+    auto* limited = makeGN(storage::cpp2::EdgeDirection::OUT_EDGE);
+    limited->setLimit(10);
+    EXPECT_FALSE(GetNeighborsExecutor::cacheable(limited));
+
+    RowCache cache(100, std::chrono::milliseconds(0));
+    qctx_->setNeighborCache(&cache);
+    DataSet resp({kVid, "_stats", "_edge:+1:_dst", "_expr"});
+    for (auto vid : {"1", "3"}) {
+        Row row;
+        row.values.emplace_back(vid);
+        row.values.emplace_back(Value());
+        row.values.emplace_back(List());
+        row.values.emplace_back(Value());
+        resp.rows.emplace_back(std::move(row));
+    }
+    {
+        auto gnExe = std::make_unique<GetNeighborsExecutor>(out, qctx_.get());
+        ASSERT_TRUE(gnExe->buildRequestDataSet().ok());
+        gnExe->lookupCache();
+        EXPECT_TRUE(gnExe->hits_.values.empty());
+        EXPECT_EQ(gnExe->reqDs_.rows.size(), 10);
+        gnExe->fillCache(resp);
+    }
+    {
+        auto gnExe = std::make_unique<GetNeighborsExecutor>(out, qctx_.get());
+        ASSERT_TRUE(gnExe->buildRequestDataSet().ok());
+        gnExe->lookupCache();
+        ASSERT_EQ(gnExe->hits_.values.size(), 1);
+        EXPECT_EQ(gnExe->hits_.values[0].getDataSet(), resp);
+        // Only the others are sent
+        EXPECT_EQ(gnExe->reqDs_.rows.size(), 8);
+    }
+    {
+        // The neighbors of other direction are not cached
+        auto gnExe = std::make_unique<GetNeighborsExecutor>(in, qctx_.get());
+        ASSERT_TRUE(gnExe->buildRequestDataSet().ok());
+        gnExe->lookupCache();
+        EXPECT_TRUE(gnExe->hits_.values.empty());
+        EXPECT_EQ(gnExe->reqDs_.rows.size(), 10);
+    }
+    {
+        // Fetched before an edge of the vertex is written, the stale neighbors are not cached
+        auto gnExe = std::make_unique<GetNeighborsExecutor>(out, qctx_.get());
+        ASSERT_TRUE(gnExe->buildRequestDataSet().ok());
+        gnExe->lookupCache();
+        gnExe->evictEdge(0, "5", "6");
+        DataSet stale(resp.colNames);
+        stale.rows.emplace_back(Row({"5", Value(), List(), Value()}));
+        gnExe->fillCache(stale);
+        auto sig = GetNeighborsExecutor::signature(out);
+        EXPECT_EQ(cache.get(0, "5", sig), nullptr);
+
+        // Fetched after the write
+        gnExe->lookupCache();
+        gnExe->fillCache(stale);
+        EXPECT_NE(cache.get(0, "5", sig), nullptr);
+    }
+    qctx_->setNeighborCache(nullptr);
+}
+
+TEST_F(GetNeighborsTest, VidsKey) {
+    std::vector<Row> rows;
+    for (auto i = 0; i < 1000; ++i) {
+        rows.emplace_back(Row({folly::to<std::string>(i)}));
+    }
+    auto key = GetNeighborsExecutor::vidsKey(rows);
+    // Regardless of the order
+    std::reverse(rows.begin(), rows.end());
+    EXPECT_EQ(GetNeighborsExecutor::vidsKey(rows), key);
+    // But not of the vertices
+    rows.back() = Row({"1000"});
+    EXPECT_NE(GetNeighborsExecutor::vidsKey(rows), key);
+    rows.pop_back();
+    EXPECT_NE(GetNeighborsExecutor::vidsKey(rows), key);
+    // Nor of the type and boundaries of vertices
+    EXPECT_NE(GetNeighborsExecutor::vidsKey({Row({1})}),
+              GetNeighborsExecutor::vidsKey({Row({"1"})}));
+    EXPECT_NE(GetNeighborsExecutor::vidsKey({Row({"a:1:1:b"})}),
+              GetNeighborsExecutor::vidsKey({Row({"a"}), Row({"b"})}));
+}
 }  // namespace graph
 }  // namespace nebula
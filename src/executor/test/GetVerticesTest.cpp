@@ -0,0 +1,118 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "executor/query/GetVerticesExecutor.h"
+#include "planner/Query.h"
+
+namespace nebula {
+namespace graph {
+class GetVerticesTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+        {
+            DataSet ds;
+            ds.colNames = {"id"};
+            for (auto i = 0; i < 4; ++i) {
+                ds.rows.emplace_back(Row({folly::to<std::string>(i)}));
+            }
+            ResultBuilder builder;
+            builder.value(Value(std::move(ds)));
+            qctx_->symTable()->newVariable("input_gv");
+            qctx_->ectx()->setResult("input_gv", builder.finish());
+        }
+
+        auto session = Session::create(0);
+        SpaceInfo spaceInfo;
+        spaceInfo.name = "test_space";
+        spaceInfo.id = 1;
+        spaceInfo.spaceDesc.space_name = "test_space";
+        session->setSpace(std::move(spaceInfo));
+        auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+        rctx->setSession(std::move(session));
+        qctx_->setRCtx(std::move(rctx));
+    }
+
+    // The rows of `vids' as returned by storage
+    static DataSet response(const std::vector<std::string>& vids) {
+        DataSet ds({kVid, "person.name"});
+        for (auto& vid : vids) {
+            ds.rows.emplace_back(Row({vid, "name" + vid}));
+        }
+        return ds;
+    }
+
+protected:
+    std::unique_ptr<QueryContext> qctx_;
+};
+
+TEST_F(GetVerticesTest, Cache) {
+    auto* pool = qctx_->objPool();
+    auto* vids = pool->add(new InputPropertyExpression(new std::string("id")));
+    std::vector<storage::cpp2::VertexProp> props(1);
+    props.front().set_tag(1);
+    props.front().set_props(std::vector<std::string>{"name"});
+    auto* gv = GetVertices::make(qctx_.get(), nullptr, 1, vids, std::move(props), {});
+    gv->setInputVar("input_gv");
+    gv->setColNames({kVid, "person.name"});
+    ASSERT_TRUE(GetVerticesExecutor::cacheable(gv));
+    auto sig = GetVerticesExecutor::signature(gv);
+
+    RowCache cache(100, std::chrono::milliseconds(0));
+    qctx_->setVertexCache(&cache);
+    auto all = response({"0", "1", "2", "3"});
+    {
+        // Filled by the response
+        auto gvExe = std::make_unique<GetVerticesExecutor>(gv, qctx_.get());
+        gvExe->fillCache(&cache, sig, cache.generation(), all);
+        EXPECT_EQ(cache.size(), 4);
+    }
+    {
+        // All hit, so no request is sent
+        auto gvExe = std::make_unique<GetVerticesExecutor>(gv, qctx_.get());
+        auto status = gvExe->execute().get();
+        ASSERT_TRUE(status.ok()) << status;
+        auto ds = qctx_->ectx()->getResult(gv->outputVar()).value().getDataSet();
+        EXPECT_EQ(ds.colNames, all.colNames);
+        std::sort(ds.rows.begin(), ds.rows.end());
+        EXPECT_EQ(ds.rows, all.rows);
+    }
+    auto lookup = [gv, &cache, &sig, this](DataSet* hits) {
+        auto gvExe = std::make_unique<GetVerticesExecutor>(gv, qctx_.get());
+        auto vertices = qctx_->ectx()->getResult("input_gv").value().getDataSet();
+        gvExe->lookupCache(&cache, sig, &vertices, hits);
+        return vertices;
+    };
+    {
+        // The vertex written is fetched again
+        cache.evict(1, "2");
+        DataSet hits;
+        auto misses = lookup(&hits);
+        EXPECT_EQ(hits.rows.size(), 3);
+        ASSERT_EQ(misses.rows.size(), 1);
+        EXPECT_EQ(misses.rows.front(), Row({"2"}));
+    }
+    {
+        // Fetched before the vertex is written again, the stale row is not cached
+        auto gvExe = std::make_unique<GetVerticesExecutor>(gv, qctx_.get());
+        auto generation = cache.generation();
+        cache.evict(1, "2");
+        gvExe->fillCache(&cache, sig, generation, response({"2"}));
+        DataSet hits;
+        EXPECT_EQ(lookup(&hits).rows.size(), 1);
+
+        // Fetched after the write
+        gvExe->fillCache(&cache, sig, cache.generation(), response({"2"}));
+        EXPECT_TRUE(lookup(&hits).rows.empty());
+    }
+    qctx_->setVertexCache(nullptr);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,137 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "executor/mutate/InsertExecutor.h"
+#include "planner/Logic.h"
+
+namespace nebula {
+namespace graph {
+
+class InsertTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+        for (auto i = 0; i < 10; ++i) {
+            rows_.emplace_back(i);
+        }
+        exe_ = std::make_unique<BatchExecutor>(StartNode::make(qctx_.get()), qctx_.get());
+    }
+
+    // Expose the batching of the insert executors
+    class BatchExecutor final : public InsertExecutor {
+    public:
+        BatchExecutor(const PlanNode* node, QueryContext* qctx)
+            : InsertExecutor("BatchExecutor", node, qctx) {}
+
+        folly::Future<Status> execute() override {
+            return start();
+        }
+
+        using InsertExecutor::sendInBatches;
+    };
+
+    using Sender = std::function<folly::Future<Status>(std::vector<int>)>;
+
+    // The rows must be kept until the future is done
+    folly::Future<Status> send(const std::vector<int>& rows, Sender sender) {
+        return exe_->sendInBatches<int>(rows, std::move(sender));
+    }
+
+protected:
+    std::unique_ptr<QueryContext> qctx_;
+    std::unique_ptr<BatchExecutor> exe_;
+    std::vector<int> rows_;
+};
+
+TEST_F(InsertTest, Split) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_insert_batch_size = 3;
+    FLAGS_insert_concurrency = 0;
+    std::vector<std::vector<int>> batches;
+    auto status = send(rows_, [&batches](std::vector<int> batch) {
+        batches.emplace_back(std::move(batch));
+        return folly::makeFuture(Status::OK());
+    }).get();
+    ASSERT_TRUE(status.ok()) << status;
+    std::sort(batches.begin(), batches.end());
+    // The remainder is sent in a smaller batch
+    std::vector<std::vector<int>> expected = {{0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {9}};
+    EXPECT_EQ(batches, expected);
+
+    // Sent at once
+    batches.clear();
+    FLAGS_insert_batch_size = 0;
+    status = send(rows_, [&batches](std::vector<int> batch) {
+        batches.emplace_back(std::move(batch));
+        return folly::makeFuture(Status::OK());
+    }).get();
+    ASSERT_TRUE(status.ok()) << status;
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches.front(), rows_);
+}
+
+TEST_F(InsertTest, Empty) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_insert_batch_size = 3;
+    // An empty insert is still sent once
+    std::vector<std::vector<int>> batches;
+    std::vector<int> rows;
+    auto status = send(rows, [&batches](std::vector<int> batch) {
+        batches.emplace_back(std::move(batch));
+        return folly::makeFuture(Status::OK());
+    }).get();
+    ASSERT_TRUE(status.ok()) << status;
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_TRUE(batches.front().empty());
+}
+
+TEST_F(InsertTest, Concurrency) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_insert_batch_size = 2;
+    FLAGS_insert_concurrency = 2;
+    std::vector<folly::Promise<Status>> pending;
+    // Never reallocated while a promise is being fulfilled
+    pending.reserve(rows_.size());
+    std::vector<int> sent;
+    auto future = send(rows_, [&pending, &sent](std::vector<int> batch) {
+        sent.insert(sent.end(), batch.begin(), batch.end());
+        pending.emplace_back();
+        return pending.back().getFuture();
+    });
+    // No more than two batches in flight, the next one is sent once one is done
+    for (size_t done = 0; done < pending.size(); ++done) {
+        EXPECT_LE(pending.size() - done, 2);
+        EXPECT_FALSE(future.isReady());
+        pending[done].setValue(Status::OK());
+    }
+    EXPECT_EQ(pending.size(), 5);
+    ASSERT_TRUE(future.isReady());
+    auto status = std::move(future).get();
+    ASSERT_TRUE(status.ok()) << status;
+    std::sort(sent.begin(), sent.end());
+    EXPECT_EQ(sent, rows_);
+}
+
+TEST_F(InsertTest, Failure) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_insert_batch_size = 2;
+    FLAGS_insert_concurrency = 1;
+    size_t numSent = 0;
+    auto status = send(rows_, [&numSent](std::vector<int>) {
+        ++numSent;
+        auto status = numSent == 2 ? Status::Error("Failed") : Status::OK();
+        return folly::makeFuture(std::move(status));
+    }).get();
+    // No more batches are sent after the failed one
+    ASSERT_FALSE(status.ok());
+    EXPECT_EQ(numSent, 2);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -46,6 +46,32 @@ protected:
                    : (::testing::AssertionFailure() << result << " vs. " << expected);
     }
 
+    // Build the paths from the rows output so far, in the order they're output, and group
+    // them by their ends
+    DataSet collectPaths(const DataSet& ds) {
+        std::unordered_map<Value, List> ends;
+        for (auto& row : ds.rows) {
+            auto& edge = row.values[1].getEdge();
+            auto parent = row.values[2].getInt();
+            Path path;
+            if (parent < 0) {
+                path.src = Vertex(edge.src, {});
+            } else {
+                path = paths_[parent];
+            }
+            path.steps.emplace_back(
+                Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
+            ends[row.values[0]].values.emplace_back(path);
+            paths_.emplace_back(std::move(path));
+        }
+        DataSet result;
+        result.colNames = {kDst, "_paths"};
+        for (auto& end : ends) {
+            result.rows.emplace_back(Row({end.first, std::move(end.second)}));
+        }
+        return result;
+    }
+
     void SetUp() override {
         qctx_ = std::make_unique<QueryContext>();
         /*
@@ -224,6 +250,7 @@ protected:
     DataSet firstStepResult_;
     DataSet secondStepResult_;
     DataSet thridStepResult_;
+    std::vector<Path> paths_;
 };
 
 TEST_F(ProduceAllPathsTest, AllPath) {
@@ -231,7 +258,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
 
     auto* allPathsNode = ProduceAllPaths::make(qctx_.get(), nullptr);
     allPathsNode->setInputVar("input");
-    allPathsNode->setColNames({kDst, "_paths"});
+    allPathsNode->setColNames({kVid, "edge", "parent"});
 
     auto allPathsExe = std::make_unique<ProduceAllPathsExecutor>(allPathsNode, qctx_.get());
 
@@ -312,7 +339,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = collectPaths(result.value().getDataSet());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -401,7 +428,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = collectPaths(result.value().getDataSet());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -446,7 +473,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
             expected.rows.emplace_back(std::move(row));
         }
 
-        auto resultDs = result.value().getDataSet();
+        auto resultDs = collectPaths(result.value().getDataSet());
         EXPECT_TRUE(verifyAllPaths(resultDs, expected));
         EXPECT_EQ(result.state(), Result::State::kSuccess);
     }
@@ -455,7 +482,7 @@ TEST_F(ProduceAllPathsTest, AllPath) {
 TEST_F(ProduceAllPathsTest, EmptyInput) {
     auto* allPathsNode = ProduceAllPaths::make(qctx_.get(), nullptr);
     allPathsNode->setInputVar("empty_get_neighbors");
-    allPathsNode->setColNames({kDst, "_paths"});
+    allPathsNode->setColNames({kVid, "edge", "parent"});
 
     auto allPathsExe = std::make_unique<ProduceAllPathsExecutor>(allPathsNode, qctx_.get());
     auto future = allPathsExe->execute();
@@ -464,7 +491,7 @@ TEST_F(ProduceAllPathsTest, EmptyInput) {
     auto& result = qctx_->ectx()->getResult(allPathsNode->outputVar());
 
     DataSet expected;
-    expected.colNames = {"_dst", "_paths"};
+    expected.colNames = {kVid, "edge", "parent"};
     EXPECT_EQ(result.value().getDataSet(), expected);
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
@@ -11,6 +11,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/Logic.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -120,5 +121,64 @@ TEST_F(ProjectTest, EmptyInput) {
     EXPECT_EQ(result.state(), Result::State::kSuccess);
 }
 
+TEST_F(ProjectTest, MultiJobs) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1;
+
+    std::string input = "input_project";
+    auto yieldColumns = getYieldColumns(
+            "YIELD $input_project.vid AS vid, $input_project.col2 + 1 AS num");
+    auto* project = Project::make(qctx_.get(), start_, yieldColumns);
+    project->setInputVar(input);
+    project->setColNames(std::vector<std::string>{"vid", "num"});
+
+    auto proExe = Executor::create(project, qctx_.get());
+    auto future = proExe->execute();
+    auto status = std::move(future).get();
+    EXPECT_TRUE(status.ok());
+    auto& result = qctx_->ectx()->getResult(project->outputVar());
+
+    DataSet expected;
+    expected.colNames = {"vid", "num"};
+    for (auto i = 0; i < 10; ++i) {
+        Row row;
+        row.values.emplace_back(i);
+        row.values.emplace_back(i + 2);
+        expected.rows.emplace_back(std::move(row));
+    }
+    EXPECT_EQ(result.value().getDataSet(), expected);
+    EXPECT_EQ(result.state(), Result::State::kSuccess);
+}
+
+TEST_F(ProjectTest, MemoryLimit) {
+    std::string input = "input_project";
+    auto yieldColumns = getYieldColumns("YIELD $input_project.vid AS vid");
+    auto* project = Project::make(qctx_.get(), start_, yieldColumns);
+    project->setInputVar(input);
+    project->setColNames(std::vector<std::string>{"vid"});
+
+    {
+        qctx_->memTracker()->setLimit(1024 * 1024);
+        auto proExe = Executor::create(project, qctx_.get());
+        EXPECT_TRUE(proExe->open().ok());
+        auto status = std::move(proExe->execute()).get();
+        EXPECT_TRUE(status.ok());
+        EXPECT_GT(qctx_->memTracker()->current(), 0);
+        EXPECT_EQ(qctx_->memTracker()->current(), qctx_->memTracker()->peak());
+        EXPECT_TRUE(proExe->close().ok());
+    }
+    {
+        qctx_->memTracker()->setLimit(1);
+        auto proExe = Executor::create(project, qctx_.get());
+        EXPECT_TRUE(proExe->open().ok());
+        auto status = std::move(proExe->execute()).get();
+        EXPECT_FALSE(status.ok());
+    }
+    // The bytes are released when the results are dropped
+    qctx_->ectx()->deleteValue(project->outputVar());
+    EXPECT_EQ(qctx_->memTracker()->current(), 0);
+}
+
 }  // namespace graph
 }  // namespace nebula
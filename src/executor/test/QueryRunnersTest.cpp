@@ -0,0 +1,110 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include <folly/synchronization/Baton.h>
+
+#include "common/expression/ConstantExpression.h"
+#include "context/QueryContext.h"
+#include "executor/Executor.h"
+#include "planner/Algo.h"
+#include "planner/Logic.h"
+#include "planner/Query.h"
+#include "scheduler/QueryRunners.h"
+
+DECLARE_uint32(max_job_size);
+DECLARE_uint32(min_batch_size);
+
+namespace nebula {
+namespace graph {
+
+class QueryRunnersTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+    }
+
+    // Expose the morsel size of the executors
+    class BatchSizeExecutor final : public Executor {
+    public:
+        BatchSizeExecutor(const PlanNode* node, QueryContext* qctx)
+            : Executor("BatchSizeExecutor", node, qctx) {}
+
+        folly::Future<Status> execute() override {
+            return start();
+        }
+
+        using Executor::getBatchSize;
+    };
+
+protected:
+    std::unique_ptr<QueryContext> qctx_;
+};
+
+TEST_F(QueryRunnersTest, Classify) {
+    auto* start = StartNode::make(qctx_.get());
+    auto* project = Project::make(qctx_.get(), start, qctx_->objPool()->add(new YieldColumns()));
+    EXPECT_EQ(QueryRunners::classify(project), QueryPriority::kInteractive);
+
+    auto condition = std::make_unique<ConstantExpression>(true);
+    auto* loop = Loop::make(qctx_.get(), start, project, condition.get());
+    auto* loopProject = Project::make(qctx_.get(), loop, qctx_->objPool()->add(new YieldColumns()));
+    EXPECT_EQ(QueryRunners::classify(loopProject), QueryPriority::kBatch);
+
+    // The branches of Select are traversed too
+    auto* bfs = BFSShortestPath::make(qctx_.get(), start);
+    auto* select = Select::make(qctx_.get(), start, bfs, project, condition.get());
+    EXPECT_EQ(QueryRunners::classify(select), QueryPriority::kBatch);
+    select->setIf(project);
+    EXPECT_EQ(QueryRunners::classify(select), QueryPriority::kInteractive);
+}
+
+TEST_F(QueryRunnersTest, Priority) {
+    QueryRunners runners(1);
+    auto* interactive = runners.runner(QueryPriority::kInteractive);
+    auto* batch = runners.runner(QueryPriority::kBatch);
+
+    // Hold the only thread until both tasks are queued
+    folly::Baton<> started;
+    folly::Baton<> blocked;
+    interactive->add([&started, &blocked]() {
+        started.post();
+        blocked.wait();
+    });
+    started.wait();
+
+    std::vector<QueryPriority> order;
+    folly::Baton<> done;
+    batch->add([&order]() { order.emplace_back(QueryPriority::kBatch); });
+    interactive->add([&order]() { order.emplace_back(QueryPriority::kInteractive); });
+    batch->add([&done]() { done.post(); });
+    blocked.post();
+    done.wait();
+
+    std::vector<QueryPriority> expected = {QueryPriority::kInteractive, QueryPriority::kBatch};
+    EXPECT_EQ(order, expected);
+}
+
+TEST_F(QueryRunnersTest, BatchSize) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1;
+    auto* start = StartNode::make(qctx_.get());
+    BatchSizeExecutor exe(start, qctx_.get());
+
+    // The jobs are capped by `max_job_size' whatever the priority is
+    qctx_->setPriority(QueryPriority::kInteractive);
+    EXPECT_EQ(exe.getBatchSize(100000), 25000);
+    qctx_->setPriority(QueryPriority::kBatch);
+    EXPECT_EQ(exe.getBatchSize(100000), 25000);
+
+    FLAGS_min_batch_size = 30000;
+    EXPECT_EQ(exe.getBatchSize(100000), 30000);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -12,6 +12,7 @@
 #include "executor/test/QueryTestBase.h"
 #include "planner/Logic.h"
 #include "planner/Query.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -131,5 +132,88 @@ TEST_F(SortTest, sortTwoColDesDes_union) {
     factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
     SORT_RESUTL_CHECK("union_sequential", "union_sort_two_cols_des_des", true, factors, expected);
 }
+
+TEST_F(SortTest, sortTwoColsAscDesMultiJobs) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 4;
+    FLAGS_min_batch_size = 1;
+
+    DataSet expected({"age", "start_year"});
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({19, 2009}));
+    expected.emplace_back(Row({20, 2009}));
+    expected.emplace_back(Row({20, 2008}));
+    expected.emplace_back(Row({Value::kNullValue, 2009}));
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(2, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
+    SORT_RESUTL_CHECK("input_sequential", "sort_multi_jobs", true, factors, expected);
+}
+
+TEST_F(SortTest, sortTwoColsAscDesSpill) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 2;
+    // Make the sorted runs only hold one row
+    FLAGS_query_memory_budget_bytes = 1;
+
+    DataSet expected({"age", "start_year"});
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({19, 2009}));
+    expected.emplace_back(Row({20, 2009}));
+    expected.emplace_back(Row({20, 2008}));
+    expected.emplace_back(Row({Value::kNullValue, 2009}));
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(2, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
+    SORT_RESUTL_CHECK("input_sequential", "sort_spill", true, factors, expected);
+    // The rows are spilled, so the input read by nothing else is released
+    EXPECT_TRUE(qctx_->ectx()->getHistory("input_sequential").empty());
+}
+
+TEST_F(SortTest, sortTwoColsAscDesSpillSharedInput) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 2;
+    FLAGS_query_memory_budget_bytes = 1;
+    // The input is read by another node, so only the keys are spilled and the rows are
+    // sorted in place
+    auto* other = Sort::make(qctx_.get(), StartNode::make(qctx_.get()), {});
+    other->setInputVar("input_sequential");
+
+    DataSet expected({"age", "start_year"});
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({19, 2009}));
+    expected.emplace_back(Row({20, 2009}));
+    expected.emplace_back(Row({20, 2008}));
+    expected.emplace_back(Row({Value::kNullValue, 2009}));
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(2, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
+    SORT_RESUTL_CHECK("input_sequential", "sort_spill_shared", true, factors, expected);
+    EXPECT_FALSE(qctx_->ectx()->getHistory("input_sequential").empty());
+}
+
+TEST_F(SortTest, sortTwoColsAscDesMultiPassMerge) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_max_job_size = 2;
+    FLAGS_min_batch_size = 1;
+    FLAGS_query_memory_budget_bytes = 1;
+    // Each of the six rows is a run, which are more than merged at once
+    FLAGS_spill_merge_fanin = 2;
+
+    DataSet expected({"age", "start_year"});
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({18, 2010}));
+    expected.emplace_back(Row({19, 2009}));
+    expected.emplace_back(Row({20, 2009}));
+    expected.emplace_back(Row({20, 2008}));
+    expected.emplace_back(Row({Value::kNullValue, 2009}));
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+    factors.emplace_back(std::make_pair(2, OrderFactor::OrderType::ASCEND));
+    factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
+    SORT_RESUTL_CHECK("input_sequential", "sort_multi_pass", true, factors, expected);
+}
 }   // namespace graph
 }   // namespace nebula
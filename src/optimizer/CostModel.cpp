@@ -0,0 +1,149 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "optimizer/CostModel.h"
+
+#include <cmath>
+
+#include "context/QueryContext.h"
+#include "planner/PlanNode.h"
+#include "planner/Query.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::Explore;
+using nebula::graph::GetNeighbors;
+using nebula::graph::IndexScan;
+using nebula::graph::Limit;
+using nebula::graph::PlanNode;
+using nebula::graph::TopN;
+
+namespace nebula {
+namespace opt {
+
+double CostModel::rows(const PlanNode *node, double inputRows) const {
+    switch (node->kind()) {
+        case PlanNode::Kind::kStart:
+            return 1.0;
+        case PlanNode::Kind::kIndexScan: {
+            auto *scan = static_cast<const IndexScan *>(node);
+            if (scan->isEmptyResultSet()) {
+                return 0.0;
+            }
+            auto total = schemaRows(scan->space(), scan->isEdge(), scan->schemaId());
+            auto *contexts = scan->queryContext();
+            if (contexts == nullptr || contexts->empty()) {
+                return total;
+            }
+            // Each context scans a part of the index, e.g. for each operand of OR
+            double rows = 0.0;
+            for (auto &ctx : *contexts) {
+                auto scanned = total * selectivity(ctx.get_column_hints());
+                rows += ctx.get_filter().empty() ? scanned : scanned * kFilterSelectivity;
+            }
+            return std::min({rows, total, static_cast<double>(scan->limit())});
+        }
+        case PlanNode::Kind::kGetNeighbors: {
+            auto *gn = static_cast<const GetNeighbors *>(node);
+            auto rows = inputRows * degree(gn->space(), gn->edgeTypes());
+            return gn->filter().empty() ? rows : rows * kFilterSelectivity;
+        }
+        case PlanNode::Kind::kGetVertices:
+        case PlanNode::Kind::kGetEdges: {
+            auto *explore = static_cast<const Explore *>(node);
+            return explore->filter().empty() ? inputRows : inputRows * kFilterSelectivity;
+        }
+        case PlanNode::Kind::kFilter:
+            return inputRows * kFilterSelectivity;
+        case PlanNode::Kind::kLimit: {
+            auto *limit = static_cast<const Limit *>(node);
+            return std::min(inputRows, static_cast<double>(limit->offset() + limit->count()));
+        }
+        case PlanNode::Kind::kTopN: {
+            auto *topN = static_cast<const TopN *>(node);
+            return std::min(inputRows, static_cast<double>(topN->offset() + topN->count()));
+        }
+        case PlanNode::Kind::kAggregate: {
+            auto *agg = static_cast<const Aggregate *>(node);
+            return agg->groupKeys().empty() ? 1.0 : inputRows;
+        }
+        default:
+            return inputRows;
+    }
+}
+
+double CostModel::cost(const PlanNode *node, double inputRows) const {
+    switch (node->kind()) {
+        case PlanNode::Kind::kIndexScan:
+        case PlanNode::Kind::kGetNeighbors:
+        case PlanNode::Kind::kGetVertices:
+        case PlanNode::Kind::kGetEdges:
+            return rows(node, inputRows) * kStorageRowCost;
+        case PlanNode::Kind::kSort:
+            return inputRows * std::log2(inputRows + 2.0);
+        case PlanNode::Kind::kTopN:
+            return inputRows * std::log2(rows(node, inputRows) + 2.0);
+        default:
+            return inputRows;
+    }
+}
+
+double CostModel::schemaRows(GraphSpaceID space, bool isEdge, int32_t schemaId) const {
+    auto *statsCache = qctx_->statsCache();
+    auto *schemaMng = qctx_->schemaMng();
+    if (statsCache == nullptr || schemaMng == nullptr) {
+        return kDefaultRows;
+    }
+    auto stats = statsCache->get(space);
+    if (stats == nullptr) {
+        return kDefaultRows;
+    }
+    if (isEdge) {
+        auto name = schemaMng->toEdgeName(space, std::abs(schemaId));
+        if (!name.ok()) {
+            return kDefaultRows;
+        }
+        auto found = stats->edgeCounts.find(name.value());
+        return found == stats->edgeCounts.end() ? kDefaultRows : found->second;
+    }
+    auto name = schemaMng->toTagName(space, schemaId);
+    if (!name.ok()) {
+        return kDefaultRows;
+    }
+    auto found = stats->tagVertices.find(name.value());
+    return found == stats->tagVertices.end() ? kDefaultRows : found->second;
+}
+
+double CostModel::degree(GraphSpaceID space, const std::vector<EdgeType> &edgeTypes) const {
+    auto *statsCache = qctx_->statsCache();
+    auto stats = statsCache == nullptr ? nullptr : statsCache->get(space);
+    if (stats == nullptr || stats->vertices <= 0) {
+        return kDefaultDegree;
+    }
+    double edges = 0.0;
+    if (edgeTypes.empty()) {
+        // Over all the edge types
+        edges = stats->edges;
+    } else {
+        for (auto type : edgeTypes) {
+            edges += schemaRows(space, true, type);
+        }
+    }
+    return edges / stats->vertices;
+}
+
+// static
+double CostModel::selectivity(const std::vector<storage::cpp2::IndexColumnHint> &hints) {
+    double selectivity = 1.0;
+    for (auto &hint : hints) {
+        selectivity *= hint.get_scan_type() == storage::cpp2::ScanType::PREFIX
+                           ? kEqualSelectivity
+                           : kRangeSelectivity;
+    }
+    return selectivity;
+}
+
+}   // namespace opt
+}   // namespace nebula
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef OPTIMIZER_COSTMODEL_H_
+#define OPTIMIZER_COSTMODEL_H_
+
+#include "common/base/Base.h"
+#include "common/interface/gen-cpp2/storage_types.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace graph {
+class PlanNode;
+class QueryContext;
+}   // namespace graph
+
+namespace opt {
+
+/***************************************************************************
+ *
+ * Estimate the rows output by plan nodes and the cost to make them, so the
+ * optimizer compares the alternatives of a plan.
+ *
+ * The rows read from storage are estimated by the counts of the vertices
+ * and edges of the last STATS job, see `StatsCache'. Without them, each
+ * schema is assumed to have `kDefaultRows', so the estimates are only good
+ * to compare the plans reading the same schemas.
+ *
+ * The cost is in the unit of a row processed in graph, and a row read from
+ * storage costs `kStorageRowCost'.
+ *
+ **************************************************************************/
+class CostModel final {
+public:
+    static constexpr double kDefaultRows = 10000.0;
+    static constexpr double kDefaultDegree = 10.0;
+    static constexpr double kEqualSelectivity = 0.1;
+    static constexpr double kRangeSelectivity = 0.3;
+    static constexpr double kFilterSelectivity = 0.5;
+    static constexpr double kStorageRowCost = 4.0;
+
+    explicit CostModel(graph::QueryContext *qctx) : qctx_(qctx) {}
+
+    // The rows output by `node' when its dependencies output `inputRows'
+    double rows(const graph::PlanNode *node, double inputRows) const;
+
+    // The cost of `node' itself when its dependencies output `inputRows'
+    double cost(const graph::PlanNode *node, double inputRows) const;
+
+    // The number of vertices of the tag, or edges of the edge type
+    double schemaRows(GraphSpaceID space, bool isEdge, int32_t schemaId) const;
+
+    // The average number of edges of the edge types out of or into a vertex
+    double degree(GraphSpaceID space, const std::vector<EdgeType> &edgeTypes) const;
+
+    // The fraction of an index read by the hints of the columns
+    static double selectivity(const std::vector<storage::cpp2::IndexColumnHint> &hints);
+
+private:
+    graph::QueryContext *qctx_{nullptr};
+};
+
+}   // namespace opt
+}   // namespace nebula
+
+#endif   // OPTIMIZER_COSTMODEL_H_
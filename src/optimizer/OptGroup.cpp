@@ -9,6 +9,7 @@
 #include <limits>
 
 #include "context/QueryContext.h"
+#include "optimizer/CostModel.h"
 #include "optimizer/OptRule.h"
 #include "planner/Logic.h"
 #include "planner/PlanNode.h"
@@ -34,10 +35,12 @@ OptGroup::OptGroup(QueryContext *qctx) noexcept : qctx_(qctx) {
 void OptGroup::addGroupNode(OptGroupNode *groupNode) {
     DCHECK(groupNode != nullptr);
     DCHECK(groupNode->group() == this);
+    resetMinCost();
     groupNodes_.emplace_back(groupNode);
 }
 
 OptGroupNode *OptGroup::makeGroupNode(QueryContext *qctx, PlanNode *node) {
+    resetMinCost();
     groupNodes_.emplace_back(OptGroupNode::create(qctx, node, this));
     return groupNodes_.back();
 }
@@ -47,6 +50,8 @@ Status OptGroup::explore(const OptRule *rule) {
         return Status::OK();
     }
     setExplored(rule);
+    // The groups below may be changed too
+    resetMinCost();
 
     for (auto iter = groupNodes_.begin(); iter != groupNodes_.end();) {
         auto groupNode = *iter;
@@ -107,35 +112,43 @@ Status OptGroup::exploreUntilMaxRound(const OptRule *rule) {
     return Status::OK();
 }
 
-std::pair<double, const OptGroupNode *> OptGroup::findMinCostGroupNode() const {
-    double minCost = std::numeric_limits<double>::max();
-    const OptGroupNode *minGroupNode = nullptr;
+OptGroup::MinCost OptGroup::findMinCostGroupNode() const {
+    if (minCost_.groupNode != nullptr) {
+        return minCost_;
+    }
+    CostModel model(qctx_);
+    MinCost minCost{std::numeric_limits<double>::max(), 0.0, nullptr};
     for (auto &groupNode : groupNodes_) {
-        double cost = groupNode->getCost();
-        if (minCost > cost) {
-            minCost = cost;
-            minGroupNode = groupNode;
+        auto estimated = groupNode->estimate(model);
+        // The first one is kept among the equally cheap ones
+        if (minCost.groupNode == nullptr || minCost.cost > estimated.first) {
+            minCost = MinCost{estimated.first, estimated.second, groupNode};
         }
     }
-    return std::make_pair(minCost, minGroupNode);
+    minCost_ = minCost;
+    return minCost;
 }
 
 double OptGroup::getCost() const {
-    return findMinCostGroupNode().first;
+    return findMinCostGroupNode().cost;
+}
+
+double OptGroup::getRows() const {
+    return findMinCostGroupNode().rows;
 }
 
 const PlanNode *OptGroup::getPlan() const {
-    const OptGroupNode *minGroupNode = findMinCostGroupNode().second;
+    const OptGroupNode *minGroupNode = findMinCostGroupNode().groupNode;
     DCHECK(minGroupNode != nullptr);
     return minGroupNode->getPlan();
 }
 
 OptGroupNode *OptGroupNode::create(QueryContext *qctx, PlanNode *node, const OptGroup *group) {
-    return qctx->objPool()->add(new OptGroupNode(node, group));
+    return qctx->objPool()->add(new OptGroupNode(qctx, node, group));
 }
 
-OptGroupNode::OptGroupNode(PlanNode *node, const OptGroup *group) noexcept
-    : node_(node), group_(group) {
+OptGroupNode::OptGroupNode(QueryContext *qctx, PlanNode *node, const OptGroup *group) noexcept
+    : qctx_(qctx), node_(node), group_(group) {
     DCHECK(node != nullptr);
     DCHECK(group != nullptr);
 }
@@ -159,7 +172,31 @@ Status OptGroupNode::explore(const OptRule *rule) {
 }
 
 double OptGroupNode::getCost() const {
-    return node_->cost();
+    return estimate().first;
+}
+
+double OptGroupNode::getRows() const {
+    return estimate().second;
+}
+
+std::pair<double, double> OptGroupNode::estimate() const {
+    return estimate(CostModel(qctx_));
+}
+
+std::pair<double, double> OptGroupNode::estimate(const CostModel &model) const {
+    double cost = 0.0;
+    double inputRows = 0.0;
+    for (auto dep : dependencies_) {
+        auto minCost = dep->findMinCostGroupNode();
+        cost += minCost.cost;
+        inputRows += minCost.rows;
+    }
+    // The bodies of loop and select are counted once
+    for (auto body : bodies_) {
+        cost += body->getCost();
+    }
+    cost += model.cost(node_, inputRows);
+    return std::make_pair(cost, model.rows(node_, inputRows));
 }
 
 const PlanNode *OptGroupNode::getPlan() const {
@@ -20,6 +20,7 @@ class QueryContext;
 
 namespace opt {
 
+class CostModel;
 class OptGroupNode;
 class OptRule;
 
@@ -52,18 +53,37 @@ public:
     Status explore(const OptRule *rule);
     Status exploreUntilMaxRound(const OptRule *rule);
     double getCost() const;
+    // The rows output by the cheapest plan of this group
+    double getRows() const;
     const graph::PlanNode *getPlan() const;
 
 private:
+    friend class OptGroupNode;
+
     explicit OptGroup(graph::QueryContext *qctx) noexcept;
 
     static constexpr int16_t kMaxExplorationRound = 128;
 
-    std::pair<double, const OptGroupNode *> findMinCostGroupNode() const;
+    // The cheapest group node, along with its cost and rows
+    struct MinCost {
+        double cost;
+        double rows;
+        const OptGroupNode *groupNode;
+    };
+
+    // Memoized until the group is changed or explored again, so each group node is only
+    // estimated once however many group nodes above ask for it
+    MinCost findMinCostGroupNode() const;
+
+    void resetMinCost() {
+        minCost_.groupNode = nullptr;
+    }
 
     graph::QueryContext *qctx_{nullptr};
     std::list<OptGroupNode *> groupNodes_;
     std::vector<const OptRule *> exploredRules_;
+    // Valid if its group node isn't nullptr
+    mutable MinCost minCost_{0.0, 0.0, nullptr};
 };
 
 class OptGroupNode final {
@@ -106,12 +126,19 @@ public:
     }
 
     Status explore(const OptRule *rule);
+    // The cost of the plan rooted at this node over the cheapest plans of its dependencies
     double getCost() const;
+    // The rows output by this node
+    double getRows() const;
+    // The cost and the rows above, estimated at once
+    std::pair<double, double> estimate() const;
+    std::pair<double, double> estimate(const CostModel &model) const;
     const graph::PlanNode *getPlan() const;
 
 private:
-    OptGroupNode(graph::PlanNode *node, const OptGroup *group) noexcept;
+    OptGroupNode(graph::QueryContext *qctx, graph::PlanNode *node, const OptGroup *group) noexcept;
 
+    graph::QueryContext *qctx_{nullptr};
     graph::PlanNode *node_{nullptr};
     const OptGroup *group_{nullptr};
     std::vector<OptGroup *> dependencies_;
@@ -6,6 +6,7 @@
 
 #include "optimizer/rule/IndexScanRule.h"
 #include "common/expression/LabelAttributeExpression.h"
+#include "optimizer/CostModel.h"
 #include "optimizer/OptGroup.h"
 #include "planner/PlanNode.h"
 #include "planner/Query.h"
@@ -419,24 +420,39 @@ Expression::Kind IndexScanRule::reverseRelationalExprKind(Expression::Kind kind)
 IndexItem IndexScanRule::findOptimalIndex(graph::QueryContext *qctx,
                                           const OptGroupNode *groupNode,
                                           const FilterItems& items) const {
-    // The rule of priority is '==' --> '< > <= >=' --> '!='
     // Step 1 : find out all valid indexes for where condition.
     auto validIndexes = findValidIndex(qctx, groupNode, items);
     if (validIndexes.empty()) {
         LOG(ERROR) << "No valid index found";
         return nullptr;
     }
-    // Step 2 : find optimal indexes for equal condition.
-    auto indexesEq = findIndexForEqualScan(validIndexes, items);
-    if (indexesEq.size() == 1) {
-        return indexesEq[0];
-    }
-    // Step 3 : find optimal indexes for range condition.
-    auto indexesRange = findIndexForRangeScan(indexesEq, items);
+    // Step 2 : find the index which reads the fewest rows of the schema.
+    return findCheapestIndex(validIndexes, items);
+}
 
-    // At this stage, all the optimizations are done.
-    // Because the storage layer only needs one. So return first one of indexesRange.
-    return indexesRange[0];
+IndexItem IndexScanRule::findCheapestIndex(const std::vector<IndexItem>& indexes,
+                                           const FilterItems& items) const {
+    // The rows read are estimated by the column hints made of the condition for each
+    // index, e.g. '==' on a prefix of the fields reads fewer rows than '<' on it. All of
+    // them scan the same schema, so it's all up to the selectivity of the hints.
+    IndexItem cheapest;
+    double minSelectivity = 0.0;
+    for (const auto& index : indexes) {
+        IndexQueryCtx iqctx = std::make_unique<std::vector<IndexQueryContext>>();
+        if (!appendIQCtx(index, items, iqctx).ok()) {
+            continue;
+        }
+        auto selectivity = CostModel::selectivity(iqctx->back().get_column_hints());
+        // The index of fewer fields is lighter to read among the equal ones
+        if (cheapest == nullptr || selectivity < minSelectivity ||
+            (selectivity == minSelectivity &&
+             index->get_fields().size() < cheapest->get_fields().size())) {
+            cheapest = index;
+            minSelectivity = selectivity;
+        }
+    }
+    // Leave the error of the hints to be reported by the caller
+    return cheapest == nullptr ? indexes[0] : cheapest;
 }
 
 // Find the index with the fewest fields
@@ -531,85 +547,6 @@ IndexScanRule::findValidIndex(graph::QueryContext *qctx,
     return validIndexes;
 }
 
-std::vector<IndexItem>
-IndexScanRule::findIndexForEqualScan(const std::vector<IndexItem>& indexes,
-                                     const FilterItems& items) const {
-    std::vector<std::pair<int32_t, IndexItem>> eqIndexHint;
-    for (auto& index : indexes) {
-        int32_t hintCount = 0;
-        for (const auto& field : index->get_fields()) {
-            auto it = std::find_if(items.items.begin(), items.items.end(),
-                                   [field](const auto &item) {
-                                       return item.col_ == field.get_name();
-                                   });
-            if (it == items.items.end()) {
-                break;
-            }
-            if (it->relOP_ == RelationalExpression::Kind::kRelEQ) {
-                ++hintCount;
-            } else {
-                break;
-            }
-        }
-        eqIndexHint.emplace_back(hintCount, index);
-    }
-    // Sort the priorityIdxs for equivalent condition.
-    std::vector<IndexItem> priorityIdxs;
-    auto comp = [] (std::pair<int32_t, IndexItem>& lhs,
-                    std::pair<int32_t, IndexItem>& rhs) {
-        return lhs.first > rhs.first;
-    };
-    std::sort(eqIndexHint.begin(), eqIndexHint.end(), comp);
-    // Get the index with the highest hit rate from eqIndexHint.
-    int32_t maxHint = eqIndexHint[0].first;
-    for (const auto& hint : eqIndexHint) {
-        if (hint.first < maxHint) {
-            break;
-        }
-        priorityIdxs.emplace_back(hint.second);
-    }
-    return priorityIdxs;
-}
-
-std::vector<IndexItem>
-IndexScanRule::findIndexForRangeScan(const std::vector<IndexItem>& indexes,
-                                     const FilterItems& items) const {
-    std::map<int32_t, IndexItem> rangeIndexHint;
-    for (const auto& index : indexes) {
-        int32_t hintCount = 0;
-        for (const auto& field : index->get_fields()) {
-            auto fi = std::find_if(items.items.begin(), items.items.end(),
-                                   [field](const auto &item) {
-                                       return item.col_ == field.get_name();
-                                   });
-            if (fi == items.items.end()) {
-                break;
-            }
-            if ((*fi).relOP_ == RelationalExpression::Kind::kRelEQ) {
-                continue;
-            }
-            if ((*fi).relOP_ == RelationalExpression::Kind::kRelGE ||
-                (*fi).relOP_ == RelationalExpression::Kind::kRelGT ||
-                (*fi).relOP_ == RelationalExpression::Kind::kRelLE ||
-                (*fi).relOP_ == RelationalExpression::Kind::kRelLT) {
-                hintCount++;
-            } else {
-                break;
-            }
-        }
-        rangeIndexHint[hintCount] = index;
-    }
-    std::vector<IndexItem> priorityIdxs;
-    int32_t maxHint = rangeIndexHint.rbegin()->first;
-    for (auto iter = rangeIndexHint.rbegin(); iter != rangeIndexHint.rend(); iter++) {
-        if (iter->first < maxHint) {
-            break;
-        }
-        priorityIdxs.emplace_back(iter->second);
-    }
-    return priorityIdxs;
-}
-
 bool IndexScanRule::isEmptyResultSet(const OptGroupNode *groupNode) const {
     auto in = static_cast<const IndexScan *>(groupNode->node());
     return in->isEmptyResultSet();
@@ -30,6 +30,7 @@ class IndexScanRule final : public OptRule {
     FRIEND_TEST(IndexScanRuleTest, BoundValueTest);
     FRIEND_TEST(IndexScanRuleTest, IQCtxTest);
     FRIEND_TEST(IndexScanRuleTest, BoundValueRangeTest);
+    FRIEND_TEST(IndexScanRuleTest, CheapestIndexTest);
 
 public:
     const Pattern& pattern() const override;
@@ -172,11 +173,8 @@ private:
                                           const OptGroupNode *groupNode,
                                           const FilterItems& items) const;
 
-    std::vector<IndexItem> findIndexForEqualScan(const std::vector<IndexItem>& indexes,
-                                                 const FilterItems& items) const;
-
-    std::vector<IndexItem> findIndexForRangeScan(const std::vector<IndexItem>& indexes,
-                                                 const FilterItems& items) const;
+    IndexItem findCheapestIndex(const std::vector<IndexItem>& indexes,
+                                const FilterItems& items) const;
 
     bool isEmptyResultSet(const OptGroupNode *groupNode) const;
 };
@@ -0,0 +1,122 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/expression/ConstantExpression.h"
+#include "context/QueryContext.h"
+#include "optimizer/CostModel.h"
+#include "optimizer/OptGroup.h"
+#include "planner/Logic.h"
+#include "planner/Query.h"
+#include "util/StatsCache.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::Filter;
+using nebula::graph::GetNeighbors;
+using nebula::graph::Limit;
+using nebula::graph::QueryContext;
+using nebula::graph::Sort;
+using nebula::graph::StartNode;
+using nebula::graph::StatsCache;
+
+namespace nebula {
+namespace opt {
+
+class CostModelTest : public testing::Test {
+protected:
+    void SetUp() override {
+        qctx_ = std::make_unique<QueryContext>();
+        start_ = StartNode::make(qctx_.get());
+    }
+
+protected:
+    std::unique_ptr<QueryContext> qctx_;
+    StartNode *start_{nullptr};
+};
+
+TEST_F(CostModelTest, Rows) {
+    CostModel model(qctx_.get());
+    EXPECT_DOUBLE_EQ(model.rows(start_, 0.0), 1.0);
+
+    auto condition = std::make_unique<ConstantExpression>(true);
+    auto *filter = Filter::make(qctx_.get(), start_, condition.get());
+    EXPECT_DOUBLE_EQ(model.rows(filter, 100.0), 100.0 * CostModel::kFilterSelectivity);
+
+    auto *limit = Limit::make(qctx_.get(), start_, 10, 20);
+    EXPECT_DOUBLE_EQ(model.rows(limit, 100.0), 30.0);
+    EXPECT_DOUBLE_EQ(model.rows(limit, 5.0), 5.0);
+
+    auto *count = Aggregate::make(qctx_.get(), start_, {}, {});
+    EXPECT_DOUBLE_EQ(model.rows(count, 100.0), 1.0);
+    auto *group = Aggregate::make(qctx_.get(), start_, {condition.get()}, {});
+    EXPECT_DOUBLE_EQ(model.rows(group, 100.0), 100.0);
+}
+
+TEST_F(CostModelTest, Cost) {
+    CostModel model(qctx_.get());
+    // Without the stats
+    auto *gn = GetNeighbors::make(qctx_.get(), start_, 1);
+    EXPECT_DOUBLE_EQ(model.rows(gn, 10.0), 10.0 * CostModel::kDefaultDegree);
+    EXPECT_DOUBLE_EQ(model.cost(gn, 10.0),
+                     10.0 * CostModel::kDefaultDegree * CostModel::kStorageRowCost);
+
+    auto *sort = Sort::make(qctx_.get(), start_, {});
+    EXPECT_DOUBLE_EQ(model.cost(sort, 6.0), 18.0);
+    auto condition = std::make_unique<ConstantExpression>(true);
+    auto *filter = Filter::make(qctx_.get(), start_, condition.get());
+    EXPECT_DOUBLE_EQ(model.cost(filter, 6.0), 6.0);
+}
+
+TEST_F(CostModelTest, Stats) {
+    StatsCache stats(nullptr, std::chrono::seconds(60));
+    meta::cpp2::StatisItem item;
+    item.set_space_vertices(100);
+    item.set_space_edges(500);
+    stats.put(1, item);
+    qctx_->setStatsCache(&stats);
+
+    CostModel model(qctx_.get());
+    // Over all the edge types
+    EXPECT_DOUBLE_EQ(model.degree(1, {}), 5.0);
+    auto *gn = GetNeighbors::make(qctx_.get(), start_, 1);
+    EXPECT_DOUBLE_EQ(model.rows(gn, 10.0), 50.0);
+    // No stats of the space
+    EXPECT_DOUBLE_EQ(model.degree(2, {}), CostModel::kDefaultDegree);
+    // The schemas are unknown without the schema manager
+    EXPECT_DOUBLE_EQ(model.schemaRows(1, false, 1), CostModel::kDefaultRows);
+    qctx_->setStatsCache(nullptr);
+}
+
+TEST_F(CostModelTest, Selectivity) {
+    std::vector<storage::cpp2::IndexColumnHint> hints(2);
+    hints[0].set_scan_type(storage::cpp2::ScanType::PREFIX);
+    hints[1].set_scan_type(storage::cpp2::ScanType::RANGE);
+    EXPECT_DOUBLE_EQ(CostModel::selectivity(hints),
+                     CostModel::kEqualSelectivity * CostModel::kRangeSelectivity);
+    EXPECT_DOUBLE_EQ(CostModel::selectivity({}), 1.0);
+}
+
+TEST_F(CostModelTest, MinCostGroupNode) {
+    // A group of two alternatives over the same input, the cheaper one is chosen
+    auto *input = OptGroup::create(qctx_.get());
+    input->makeGroupNode(qctx_.get(), start_);
+    auto *group = OptGroup::create(qctx_.get());
+    auto *sort = group->makeGroupNode(qctx_.get(), Sort::make(qctx_.get(), start_, {}));
+    sort->dependsOn(input);
+    auto *limit = group->makeGroupNode(qctx_.get(), Limit::make(qctx_.get(), start_, 0, 1));
+    limit->dependsOn(input);
+    EXPECT_DOUBLE_EQ(group->getRows(), 1.0);
+    EXPECT_EQ(group->getPlan()->kind(), graph::PlanNode::Kind::kLimit);
+
+    // Estimated again once the group is changed
+    auto *start = group->makeGroupNode(qctx_.get(), StartNode::make(qctx_.get()));
+    EXPECT_LT(start->getCost(), limit->getCost());
+    EXPECT_EQ(group->getPlan()->kind(), graph::PlanNode::Kind::kStart);
+}
+
+}   // namespace opt
+}   // namespace nebula
@@ -494,6 +494,52 @@ TEST(IndexScanRuleTest, BoundValueRangeTest) {
     }
 }
 
+TEST(IndexScanRuleTest, CheapestIndexTest) {
+    auto* inst = std::move(IndexScanRule::kInstance).get();
+    auto* instance = static_cast<IndexScanRule*>(inst);
+    auto makeIndex = [](IndexID id, const std::vector<std::string>& fields) {
+        IndexItem index = std::make_unique<meta::cpp2::IndexItem>();
+        std::vector<meta::cpp2::ColumnDef> cols;
+        for (auto& field : fields) {
+            meta::cpp2::ColumnDef col;
+            col.set_name(field);
+            col.type.set_type(meta::cpp2::PropertyType::INT64);
+            cols.emplace_back(std::move(col));
+        }
+        index->set_fields(std::move(cols));
+        index->set_index_id(id);
+        return index;
+    };
+    std::vector<IndexItem> indexes{makeIndex(1, {"col0"}),
+                                   makeIndex(2, {"col1", "col0"}),
+                                   makeIndex(3, {"col0", "col1"})};
+    // col0 == 1 and col1 > 2, the index prefixed by both reads the fewest rows
+    {
+        IndexScanRule::FilterItems items;
+        items.addItem("col0", RelationalExpression::Kind::kRelEQ, Value(1L));
+        items.addItem("col1", RelationalExpression::Kind::kRelGT, Value(2L));
+        auto index = instance->findCheapestIndex(indexes, items);
+        ASSERT_NE(nullptr, index);
+        ASSERT_EQ(3, index->get_index_id());
+    }
+    // col0 == 1, the index of fewer fields is lighter
+    {
+        IndexScanRule::FilterItems items;
+        items.addItem("col0", RelationalExpression::Kind::kRelEQ, Value(1L));
+        auto index = instance->findCheapestIndex(indexes, items);
+        ASSERT_NE(nullptr, index);
+        ASSERT_EQ(1, index->get_index_id());
+    }
+    // col1 > 2, prefixed only by the second one
+    {
+        IndexScanRule::FilterItems items;
+        items.addItem("col1", RelationalExpression::Kind::kRelGT, Value(2L));
+        auto index = instance->findCheapestIndex(indexes, items);
+        ASSERT_NE(nullptr, index);
+        ASSERT_EQ(2, index->get_index_id());
+    }
+}
+
 }   // namespace opt
 }   // namespace nebula
 
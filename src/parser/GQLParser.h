@@ -16,7 +16,7 @@ namespace nebula {
 class GQLParser {
 public:
     explicit GQLParser(nebula::graph::QueryContext *qctx = nullptr)
-        : parser_(scanner_, error_, &sentences_, qctx) {
+        : qctx_(qctx), parser_(scanner_, error_, &sentences_, qctx_) {
         // Callback invoked by GraphScanner
         auto readBuffer = [this] (char *buf, int maxSize) -> int {
             // Reach the end
@@ -38,23 +38,25 @@ public:
         if (sentences_ != nullptr) delete sentences_;
     }
 
-    StatusOr<std::unique_ptr<Sentence>> parse(std::string query) {
-        // Since GraphScanner needs a writable buffer, we have to copy the query string
-        buffer_ = std::move(query);
-        pos_ = &buffer_[0];
-        end_ = pos_ + buffer_.size();
+    // The query is read in place, so it must outlive the parsing
+    StatusOr<std::unique_ptr<Sentence>> parse(const std::string &query) {
+        // Recover from the query parsed last, which may have failed in the middle
+        scanner_.reset();
+        pos_ = query.data();
+        end_ = pos_ + query.size();
 
-        scanner_.setQuery(&buffer_);
-        if (parser_.parse() != 0) {
-            pos_ = nullptr;
-            end_ = nullptr;
+        scanner_.setQuery(&query);
+        auto ret = parser_.parse();
+        pos_ = nullptr;
+        end_ = nullptr;
+        scanner_.setQuery(nullptr);
+        if (ret != 0) {
             // To flush the internal buffer to recover from a failure
             scanner_.flushBuffer();
             if (sentences_ != nullptr) {
                 delete sentences_;
                 sentences_ = nullptr;
             }
-            scanner_.setQuery(nullptr);
             return Status::SyntaxError(error_);
         }
 
@@ -63,14 +65,26 @@ public:
         }
         auto *sentences = sentences_;
         sentences_ = nullptr;
-        scanner_.setQuery(nullptr);
         return std::unique_ptr<Sentence>(sentences);
     }
 
+    // Parse with the parser of the calling thread, which is reused by all the queries
+    // on it rather than built for each of them.
+    static StatusOr<std::unique_ptr<Sentence>> parseInThread(
+            const std::string &query,
+            nebula::graph::QueryContext *qctx) {
+        thread_local GQLParser parser;
+        parser.qctx_ = qctx;
+        auto result = parser.parse(query);
+        parser.qctx_ = nullptr;
+        return result;
+    }
+
 private:
-    std::string                     buffer_;
     const char                     *pos_{nullptr};
     const char                     *end_{nullptr};
+    // Referred by the parser, so it's changed for each query when reused
+    nebula::graph::QueryContext    *qctx_{nullptr};
     nebula::GraphScanner            scanner_;
     nebula::GraphParser             parser_;
     std::string                     error_;
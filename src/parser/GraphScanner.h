@@ -43,11 +43,22 @@ public:
         yy_flush_buffer(yy_buffer_stack ? yy_buffer_stack[yy_buffer_stack_top] : nullptr);
     }
 
-    void setQuery(std::string *query) {
+    // Manually invoked by GQLParser before each query, so the scanner is reused across
+    // queries even if the last one failed in the middle of a string or comment.
+    void reset() {
+        flushBuffer();
+        // Back to the INITIAL start condition, as `BEGIN(INITIAL)' does, which is only defined
+        // in the generated scanner. Flex takes 0 as not initialized yet.
+        yy_start = 1;
+        hasUnaryMinus_ = false;
+        yylineno = 1;
+    }
+
+    void setQuery(const std::string *query) {
         query_ = query;
     }
 
-    std::string* query() {
+    const std::string* query() {
         return query_;
     }
 
@@ -172,7 +183,7 @@ private:
     size_t                              sbufSize_{0};
     size_t                              sbufPos_{0};
     std::function<int(char*, int)>      readBuffer_;
-    std::string*                        query_{nullptr};
+    const std::string*                  query_{nullptr};
 };
 
 }   // namespace nebula
@@ -98,7 +98,9 @@ std::string InsertVerticesSentence::toString() const {
     buf += "INSERT VERTEX ";
     buf += tagList_->toString();
     buf += " VALUES ";
-    buf += rows_->toString();
+    if (rows_ != nullptr) {
+        buf += rows_->toString();
+    }
     return buf;
 }
 
@@ -148,7 +150,9 @@ std::string InsertEdgesSentence::toString() const {
     buf += "(";
     buf += properties_->toString();
     buf += ") VALUES";
-    buf += rows_->toString();
+    if (rows_ != nullptr) {
+        buf += rows_->toString();
+    }
     return buf;
 }
 
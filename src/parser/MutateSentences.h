@@ -179,6 +179,17 @@ public:
         return rows_->rows();
     }
 
+    // Move the rows out, which are most of a large insert, to be dropped once they're
+    // converted. The sentence is consumed then, see `consumed'.
+    std::unique_ptr<VertexRowList> moveRows() {
+        return std::move(rows_);
+    }
+
+    // Whether the rows are moved out, then `rows' is invalid and `toString' leaves them out
+    bool consumed() const {
+        return rows_ == nullptr;
+    }
+
     std::string toString() const override;
 
 private:
@@ -291,6 +302,17 @@ public:
         return rows_->rows();
     }
 
+    // Move the rows out, which are most of a large insert, to be dropped once they're
+    // converted. The sentence is consumed then, see `consumed'.
+    std::unique_ptr<EdgeRowList> moveRows() {
+        return std::move(rows_);
+    }
+
+    // Whether the rows are moved out, then `rows' is invalid and `toString' leaves them out
+    bool consumed() const {
+        return rows_ == nullptr;
+    }
+
     std::string toString() const override;
 
 private:
@@ -200,6 +200,11 @@ std::string FindPathSentence::toString() const {
         buf += step_->toString();
         buf += " ";
     }
+    if (weight_ != nullptr) {
+        buf += "WEIGHT BY ";
+        buf += *weight_;
+        buf += " ";
+    }
     if (where_ != nullptr) {
         buf += where_->toString();
         buf += " ";
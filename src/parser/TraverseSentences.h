@@ -460,6 +460,10 @@ public:
         where_.reset(clause);
     }
 
+    void setWeight(std::string *weight) {
+        weight_.reset(weight);
+    }
+
     FromClause* from() const {
         return from_.get();
     }
@@ -480,6 +484,11 @@ public:
         return where_.get();
     }
 
+    // The edge property to weigh the paths by, nullptr if they're weighed by the steps
+    const std::string* weight() const {
+        return weight_.get();
+    }
+
     bool isShortest() const {
         return isShortest_;
     }
@@ -503,6 +512,7 @@ private:
     std::unique_ptr<OverClause>     over_;
     std::unique_ptr<StepClause>     step_;
     std::unique_ptr<WhereClause>    where_;
+    std::unique_ptr<std::string>    weight_;
 };
 
 class LimitSentence final : public Sentence {
@@ -8,7 +8,7 @@
 %parse-param { nebula::GraphScanner& scanner }
 %parse-param { std::string &errmsg }
 %parse-param { nebula::Sentence** sentences }
-%parse-param { nebula::graph::QueryContext* qctx }
+%parse-param { nebula::graph::QueryContext*& qctx }
 
 %code requires {
 #include <iostream>
@@ -168,7 +168,7 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %token KW_ORDER KW_ASC KW_LIMIT KW_OFFSET
 %token KW_DISTINCT KW_ALL KW_OF
 %token KW_BALANCE KW_LEADER KW_RESET KW_PLAN
-%token KW_SHORTEST KW_PATH KW_NOLOOP
+%token KW_SHORTEST KW_PATH KW_NOLOOP KW_WEIGHT
 %token KW_IS KW_NULL KW_DEFAULT
 %token KW_SNAPSHOT KW_SNAPSHOTS KW_LOOKUP
 %token KW_JOBS KW_JOB KW_RECOVER KW_FLUSH KW_COMPACT KW_REBUILD KW_SUBMIT KW_STATS KW_STATUS
@@ -202,6 +202,7 @@ static constexpr size_t MAX_ABS_INTEGER = 9223372036854775808ULL;
 %token <strval> STRING VARIABLE LABEL IPV4
 
 %type <strval> name_label unreserved_keyword agg_function predicate_name
+%type <strval> opt_find_path_weight_clause
 %type <expr> expression
 %type <expr> property_expression
 %type <expr> vertex_prop_expression
@@ -469,6 +470,7 @@ unreserved_keyword
     | KW_REDUCE             { $$ = new std::string("reduce"); }
     | KW_SHORTEST           { $$ = new std::string("shortest"); }
     | KW_NOLOOP             { $$ = new std::string("noloop"); }
+    | KW_WEIGHT             { $$ = new std::string("weight"); }
     | KW_COUNT_DISTINCT     { $$ = new std::string("count_distinct"); }
     | KW_CONTAINS           { $$ = new std::string("contains"); }
     | KW_STARTS             { $$ = new std::string("starts"); }
@@ -1798,13 +1800,14 @@ find_path_sentence
         $$ = s;
     }
     | KW_FIND KW_SHORTEST KW_PATH opt_with_properites from_clause to_clause over_clause find_path_upto_clause
-    /* where_clause */ {
+    opt_find_path_weight_clause /* where_clause */ {
         auto *s = new FindPathSentence(true, $4, false);
         s->setFrom($5);
         s->setTo($6);
         s->setOver($7);
         s->setStep($8);
-        /* s->setWhere($9); */
+        s->setWeight($9);
+        /* s->setWhere($10); */
         $$ = s;
     }
     | KW_FIND KW_NOLOOP KW_PATH opt_with_properites from_clause to_clause over_clause find_path_upto_clause
@@ -1831,6 +1834,11 @@ find_path_upto_clause
     }
     ;
 
+opt_find_path_weight_clause
+    : %empty { $$ = nullptr; }
+    | KW_WEIGHT KW_BY name_label { $$ = $3; }
+    ;
+
 to_clause
     : KW_TO vid_list {
         $$ = new ToClause($2);
@@ -2045,6 +2045,25 @@ TEST(Parser, FindPath) {
         auto result = parser.parse(query);
         ASSERT_TRUE(result.ok()) << result.status();
     }
+    {
+        GQLParser parser;
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like "
+                            "UPTO 3 STEPS WEIGHT BY likeness";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like WEIGHT BY weight";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+    }
+    {
+        GQLParser parser;
+        std::string query = "FIND ALL PATH FROM \"1\" TO \"2\" OVER like WEIGHT BY likeness";
+        auto result = parser.parse(query);
+        ASSERT_FALSE(result.ok());
+    }
 }
 
 TEST(Parser, Limit) {
@@ -3136,4 +3155,54 @@ TEST(Parser, JobTest) {
     checkTest("REBUILD EDGE INDEX name_index, age_index",
             "REBUILD EDGE INDEX name_index,age_index");
 }
+
+TEST(Parser, Reuse) {
+    GQLParser parser;
+    // Failed in the middle of a string and a comment
+    {
+        auto result = parser.parse("INSERT VERTEX person(name) VALUES \"1\":(\"Tom");
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        auto result = parser.parse("USE myspace /* comment");
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        auto result = parser.parse("INSERT VERTEX person(name) VALUES \"1\":(\"Tom\")");
+        ASSERT_TRUE(result.ok()) << result.status();
+        ASSERT_EQ(result.value()->kind(), Sentence::Kind::kSequential);
+    }
+    // Different statements in turn, each parsed as by a new parser
+    std::vector<std::string> queries = {
+        "CREATE USER user1 WITH PASSWORD \"aaa\"",
+        "GO FROM \"1\" OVER like YIELD like._dst AS id",
+        "ALTER USER user1 WITH PASSWORD \"a\"",
+        "FETCH PROP ON person \"1\"",
+    };
+    for (auto& query : queries) {
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        GQLParser fresh;
+        auto expected = fresh.parse(query);
+        ASSERT_TRUE(expected.ok()) << expected.status();
+        EXPECT_EQ(result.value()->toString(), expected.value()->toString());
+    }
+    // Failed by a syntax error
+    {
+        auto result = parser.parse("GO FROM \"1\" OVER");
+        ASSERT_FALSE(result.ok());
+    }
+    {
+        std::string query = "CREATE USER IF NOT EXISTS user1 WITH PASSWORD \"aaa\"";
+        auto result = parser.parse(query);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(query, result.value()->toString());
+    }
+    // Parsed by the parser of this thread
+    for (auto i = 0; i < 3; i++) {
+        auto result = GQLParser::parseInThread(i == 1 ? "USE" : "USE myspace", nullptr);
+        ASSERT_EQ(result.ok(), i != 1) << result.status();
+    }
+}
+
 }   // namespace nebula
@@ -419,6 +419,9 @@ TEST(Scanner, Basic) {
         CHECK_SEMANTIC_TYPE("SHORTEST", TokenType::KW_SHORTEST),
         CHECK_SEMANTIC_TYPE("Shortest", TokenType::KW_SHORTEST),
         CHECK_SEMANTIC_TYPE("shortest", TokenType::KW_SHORTEST),
+        CHECK_SEMANTIC_TYPE("WEIGHT", TokenType::KW_WEIGHT),
+        CHECK_SEMANTIC_TYPE("Weight", TokenType::KW_WEIGHT),
+        CHECK_SEMANTIC_TYPE("weight", TokenType::KW_WEIGHT),
         CHECK_SEMANTIC_TYPE("SUBGRAPH", TokenType::KW_SUBGRAPH),
         CHECK_SEMANTIC_TYPE("Subgraph", TokenType::KW_SUBGRAPH),
         CHECK_SEMANTIC_TYPE("subgraph", TokenType::KW_SUBGRAPH),
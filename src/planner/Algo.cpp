@@ -17,12 +17,12 @@ std::unique_ptr<PlanNodeDescription> ConjunctPath::explain() const {
             addDescription("kind", "BFS", desc.get());
             break;
         }
-        case PathKind::kBiDijkstra: {
-            addDescription("kind", "Dijkstra", desc.get());
+        case PathKind::kWeighted: {
+            addDescription("kind", "Weighted", desc.get());
             break;
         }
-        case PathKind::kFloyd: {
-            addDescription("kind", "Floyd", desc.get());
+        case PathKind::kMultiBFS: {
+            addDescription("kind", "MultiBFS", desc.get());
             break;
         }
         case PathKind::kAllPaths: {
@@ -30,7 +30,13 @@ std::unique_ptr<PlanNodeDescription> ConjunctPath::explain() const {
             break;
         }
     }
-    addDescription("conditionalVar", util::toJson(conditionalVar_), desc.get());
+    if (!leftStartVidsVar_.empty()) {
+        addDescription("leftStartVidsVar", util::toJson(leftStartVidsVar_), desc.get());
+        addDescription("rightStartVidsVar", util::toJson(rightStartVidsVar_), desc.get());
+    }
+    if (!weightProp_.empty()) {
+        addDescription("weightProp", util::toJson(weightProp_), desc.get());
+    }
     addDescription("noloop", util::toJson(noLoop_), desc.get());
     return desc;
 }
@@ -13,17 +13,6 @@
 
 namespace nebula {
 namespace graph {
-class ProduceSemiShortestPath : public SingleInputNode {
-public:
-    static ProduceSemiShortestPath* make(QueryContext* qctx, PlanNode* input) {
-        return qctx->objPool()->add(new ProduceSemiShortestPath(qctx, input));
-    }
-
-private:
-    ProduceSemiShortestPath(QueryContext* qctx, PlanNode* input)
-        : SingleInputNode(qctx, Kind::kProduceSemiShortestPath, input) {}
-};
-
 class BFSShortestPath : public SingleInputNode {
 public:
     static BFSShortestPath* make(QueryContext* qctx, PlanNode* input) {
@@ -39,8 +28,8 @@ class ConjunctPath : public BiInputNode {
 public:
     enum class PathKind : uint8_t {
         kBiBFS,
-        kBiDijkstra,
-        kFloyd,
+        kWeighted,
+        kMultiBFS,
         kAllPaths,
     };
 
@@ -60,12 +49,19 @@ public:
         return steps_;
     }
 
-    void setConditionalVar(std::string varName) {
-        conditionalVar_ = std::move(varName);
+    // The vids the two sides of BFS expand from in the next round, which are
+    // rewritten by the executor, e.g. to expand only the cheaper side
+    void setStartVidsVars(std::string leftVar, std::string rightVar) {
+        leftStartVidsVar_ = std::move(leftVar);
+        rightStartVidsVar_ = std::move(rightVar);
+    }
+
+    const std::string& leftStartVidsVar() const {
+        return leftStartVidsVar_;
     }
 
-    std::string conditionalVar() const {
-        return conditionalVar_;
+    const std::string& rightStartVidsVar() const {
+        return rightStartVidsVar_;
     }
 
     bool noLoop() const {
@@ -75,6 +71,16 @@ public:
     void setNoLoop(bool noLoop) {
         noLoop_ = noLoop;
     }
+
+    // The edge property Dijkstra weighs the paths by, fetched by GetNeighbors of both sides
+    void setWeightProp(std::string prop) {
+        weightProp_ = std::move(prop);
+    }
+
+    const std::string& weightProp() const {
+        return weightProp_;
+    }
+
     std::unique_ptr<PlanNodeDescription> explain() const override;
 
 private:
@@ -90,7 +96,9 @@ private:
 
     PathKind pathKind_;
     size_t   steps_{0};
-    std::string conditionalVar_;
+    std::string leftStartVidsVar_;
+    std::string rightStartVidsVar_;
+    std::string weightProp_;
     bool noLoop_;
 };
 
@@ -107,6 +115,7 @@ public:
     void setNoLoop(bool noLoop) {
         noLoop_ = noLoop;
     }
+
     std::unique_ptr<PlanNodeDescription> explain() const override;
 
 private:
@@ -199,8 +199,6 @@ const char* PlanNode::toString(PlanNode::Kind kind) {
             return "GetConfig";
         case Kind::kBFSShortest:
             return "BFSShortest";
-        case Kind::kProduceSemiShortestPath:
-            return "ProduceSemiShortestPath";
         case Kind::kConjunctPath:
             return "ConjunctPath";
         case Kind::kProduceAllPaths:
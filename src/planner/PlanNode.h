@@ -114,7 +114,6 @@ public:
         kSetConfig,
         kGetConfig,
         kBFSShortest,
-        kProduceSemiShortestPath,
         kConjunctPath,
         kProduceAllPaths,
         kCartesianProduct,
@@ -246,10 +246,6 @@ std::unique_ptr<PlanNodeDescription> DataCollect::explain() const {
             addDescription("kind", "ALL PATHS", desc.get());
             break;
         }
-        case CollectKind::kMultiplePairShortest: {
-            addDescription("kind", "Multiple Pair Shortest", desc.get());
-            break;
-        }
     }
     return desc;
 }
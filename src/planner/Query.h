@@ -883,7 +883,6 @@ public:
         kMToN,
         kBFSShortest,
         kAllPaths,
-        kMultiplePairShortest,
     };
 
     static DataCollect* make(QueryContext* qctx,
@@ -6,6 +6,7 @@
 
 #include "planner/match/MatchClausePlanner.h"
 
+#include "context/QueryContext.h"
 #include "context/ast/QueryAstContext.h"
 #include "planner/Query.h"
 #include "planner/match/Expand.h"
@@ -49,25 +50,27 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
     bool foundStart = false;
     // Find the start plan node
     for (auto& finder : startVidFinders) {
+        // Of the nodes found by the same finder, start from the one estimated to have the
+        // fewest vertices, so fewer paths are expanded from it
+        std::unique_ptr<NodeContext> startNodeCtx;
+        std::unique_ptr<StartVidFinder> startNodeFinder;
+        double startRows = 0.0;
         for (size_t i = 0; i < nodeInfos.size() && !foundStart; ++i) {
-            auto nodeCtx = NodeContext(matchClauseCtx, &nodeInfos[i]);
+            auto nodeCtx = std::make_unique<NodeContext>(matchClauseCtx, &nodeInfos[i]);
             auto nodeFinder = finder();
-            if (nodeFinder->match(&nodeCtx)) {
-                auto plan = nodeFinder->transform(&nodeCtx);
-                if (!plan.ok()) {
-                    return plan.status();
+            if (nodeFinder->match(nodeCtx.get())) {
+                auto rows = estimateStartRows(nodeCtx.get());
+                if (startNodeCtx == nullptr || rows < startRows) {
+                    startNodeCtx = std::move(nodeCtx);
+                    startNodeFinder = std::move(nodeFinder);
+                    startRows = rows;
+                    startIndex = i;
                 }
-                matchClausePlan = std::move(plan).value();
-                startIndex = i;
-                foundStart = true;
-                initialExpr_ = nodeCtx.initialExpr->clone();
-                VLOG(1) << "Find starts: " << startIndex
-                    << " node: " << matchClausePlan.root->outputVar()
-                    << " colNames: " << folly::join(",", matchClausePlan.root->colNames());
-                break;
+                continue;
             }
 
-            if (i != nodeInfos.size() - 1) {
+            // Start from an edge only before any node is found, as it was before
+            if (startNodeCtx == nullptr && i != nodeInfos.size() - 1) {
                 auto edgeCtx = EdgeContext(matchClauseCtx, &edgeInfos[i]);
                 auto edgeFinder = finder();
                 if (edgeFinder->match(&edgeCtx)) {
@@ -83,6 +86,18 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
                 }
             }
         }
+        if (!foundStart && startNodeCtx != nullptr) {
+            auto plan = startNodeFinder->transform(startNodeCtx.get());
+            if (!plan.ok()) {
+                return plan.status();
+            }
+            matchClausePlan = std::move(plan).value();
+            foundStart = true;
+            initialExpr_ = startNodeCtx->initialExpr->clone();
+            VLOG(1) << "Find starts: " << startIndex
+                << " node: " << matchClausePlan.root->outputVar()
+                << " colNames: " << folly::join(",", matchClausePlan.root->colNames());
+        }
         if (foundStart) {
             break;
         }
@@ -95,6 +110,25 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
     return Status::OK();
 }
 
+double MatchClausePlanner::estimateStartRows(const NodeContext* nodeCtx) const {
+    auto* matchClauseCtx = nodeCtx->matchClauseCtx;
+    auto& node = *nodeCtx->info;
+    auto* statsCache = matchClauseCtx->qctx->statsCache();
+    // The vertices sought by ids are few, but how many is unknown until the ids are evaluated
+    if (statsCache == nullptr || nodeCtx->ids != nullptr || node.labels.size() != 1) {
+        return std::numeric_limits<double>::max();
+    }
+    auto stats = statsCache->get(matchClauseCtx->space.id);
+    if (stats == nullptr) {
+        return std::numeric_limits<double>::max();
+    }
+    auto found = stats->tagVertices.find(*node.labels.back());
+    if (found == stats->tagVertices.end()) {
+        return std::numeric_limits<double>::max();
+    }
+    return found->second;
+}
+
 Status MatchClausePlanner::expand(const std::vector<NodeInfo>& nodeInfos,
                                   const std::vector<EdgeInfo>& edgeInfos,
                                   MatchClauseContext* matchClauseCtx,
@@ -26,6 +26,9 @@ private:
                       size_t& startIndex,
                       SubPlan& matchClausePlan);
 
+    // The vertices the node found starts from, by the stats of the last STATS job
+    double estimateStartRows(const NodeContext* nodeCtx) const;
+
     Status expand(const std::vector<NodeInfo>& nodeInfos,
                   const std::vector<EdgeInfo>& edgeInfos,
                   MatchClauseContext* matchClauseCtx,
@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "scheduler/QueryRunners.h"
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include "planner/Logic.h"
+#include "planner/PlanNode.h"
+
+namespace nebula {
+namespace graph {
+
+QueryRunners::QueryRunners(size_t numThreads) {
+    pool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        numThreads, 2, std::make_shared<folly::NamedThreadFactory>("query-runner"));
+    interactive_ = std::make_unique<Runner>(pool_.get(), folly::Executor::HI_PRI);
+    batch_ = std::make_unique<Runner>(pool_.get(), folly::Executor::LO_PRI);
+}
+
+QueryRunners::~QueryRunners() {
+    pool_->join();
+}
+
+folly::Executor* QueryRunners::runner(QueryPriority priority) const {
+    return priority == QueryPriority::kBatch ? batch_.get() : interactive_.get();
+}
+
+// static
+QueryPriority QueryRunners::classify(const PlanNode* root) {
+    std::vector<const PlanNode*> stack{root};
+    std::unordered_set<const PlanNode*> visited;
+    while (!stack.empty()) {
+        auto* node = stack.back();
+        stack.pop_back();
+        if (node == nullptr || !visited.emplace(node).second) {
+            continue;
+        }
+        switch (node->kind()) {
+            case PlanNode::Kind::kLoop:
+            case PlanNode::Kind::kBFSShortest:
+            case PlanNode::Kind::kConjunctPath:
+            case PlanNode::Kind::kProduceAllPaths:
+                return QueryPriority::kBatch;
+            case PlanNode::Kind::kSelect: {
+                auto* select = static_cast<const Select*>(node);
+                stack.emplace_back(select->then());
+                stack.emplace_back(select->otherwise());
+                break;
+            }
+            default:
+                break;
+        }
+        for (auto* dep : node->dependencies()) {
+            stack.emplace_back(dep);
+        }
+    }
+    return QueryPriority::kInteractive;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,77 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef SCHEDULER_QUERYRUNNERS_H_
+#define SCHEDULER_QUERYRUNNERS_H_
+
+#include <memory>
+
+#include <folly/Executor.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include "common/cpp/helpers.h"
+#include "context/QueryContext.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanNode;
+
+/***************************************************************************
+ *
+ * The thread pool dedicated to executing the query plans, instead of the
+ * thrift worker threads which also accept the requests.
+ *
+ * All the threads take tasks from the shared queues, one for each priority
+ * class, and the pending tasks of interactive queries always go before the
+ * ones of batch queries. A running task is never preempted, the priority
+ * only decides which task is picked up next. So an interactive query only
+ * gets ahead of a long running batch executor when the latter splits its
+ * input into morsels run as separate tasks, i.e. when max_job_size > 1.
+ * With the default of 1 each executor runs as a single task.
+ *
+ **************************************************************************/
+class QueryRunners final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    explicit QueryRunners(size_t numThreads);
+
+    ~QueryRunners();
+
+    // The runner submitting the tasks in the priority class
+    folly::Executor* runner(QueryPriority priority) const;
+
+    // The queries traversing multiple steps or searching paths are batch queries,
+    // the others are interactive.
+    static QueryPriority classify(const PlanNode* root);
+
+private:
+    class Runner final : public folly::Executor {
+    public:
+        Runner(folly::CPUThreadPoolExecutor* pool, int8_t priority)
+            : pool_(pool), priority_(priority) {}
+
+        void add(folly::Func func) override {
+            pool_->addWithPriority(std::move(func), priority_);
+        }
+
+        uint8_t getNumPriorities() const override {
+            return pool_->getNumPriorities();
+        }
+
+    private:
+        folly::CPUThreadPoolExecutor* pool_;
+        int8_t priority_;
+    };
+
+    std::unique_ptr<folly::CPUThreadPoolExecutor> pool_;
+    std::unique_ptr<Runner> interactive_;
+    std::unique_ptr<Runner> batch_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // SCHEDULER_QUERYRUNNERS_H_
@@ -9,10 +9,12 @@
 #include "context/QueryContext.h"
 #include "executor/ExecutionError.h"
 #include "executor/Executor.h"
+#include "executor/Pipeline.h"
 #include "executor/logic/LoopExecutor.h"
 #include "executor/logic/PassThroughExecutor.h"
 #include "executor/logic/SelectExecutor.h"
 #include "planner/PlanNode.h"
+#include "service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -115,6 +117,12 @@ folly::Future<Status> Scheduler::doSchedule(Executor *executor) {
                 }));
         }
         default: {
+            if (FLAGS_enable_pipeline) {
+                auto pipeline = Pipeline::make(executor);
+                if (pipeline != nullptr) {
+                    return schedulePipeline(std::move(pipeline));
+                }
+            }
             auto deps = executor->depends();
             if (deps.empty()) {
                 return execute(executor);
@@ -128,6 +136,20 @@ folly::Future<Status> Scheduler::doSchedule(Executor *executor) {
     }
 }
 
+folly::Future<Status> Scheduler::schedulePipeline(std::unique_ptr<Pipeline> pipeline) {
+    // Only the dependencies of head are scheduled, the executors in pipeline are run together
+    auto *sink = pipeline->sink();
+    std::shared_ptr<Pipeline> p(std::move(pipeline));
+    auto deps = p->head()->depends();
+    if (deps.empty()) {
+        return p->execute().ensure([p]() {});
+    }
+    return doScheduleParallel(deps).then(task(sink, [sink, p](Status status) {
+        if (!status.ok()) return sink->error(std::move(status));
+        return p->execute().ensure([p]() {});
+    }));
+}
+
 folly::Future<Status> Scheduler::doScheduleParallel(const std::set<Executor *> &dependents) {
     CHECK(!dependents.empty());
 
@@ -25,6 +25,7 @@ namespace graph {
 class Executor;
 class QueryContext;
 class LoopExecutor;
+class Pipeline;
 
 class Scheduler final : private cpp::NonCopyable, private cpp::NonMovable {
 public:
@@ -65,6 +66,7 @@ private:
     void analyze(Executor *executor);
     folly::Future<Status> doSchedule(Executor *executor);
     folly::Future<Status> doScheduleParallel(const std::set<Executor *> &dependents);
+    folly::Future<Status> schedulePipeline(std::unique_ptr<Pipeline> pipeline);
     folly::Future<Status> iterate(LoopExecutor *loop);
     folly::Future<Status> execute(Executor *executor);
 
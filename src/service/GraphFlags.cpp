@@ -49,4 +49,108 @@ DEFINE_uint32(max_allowed_statements, 512, "Max allowed sequential statements");
 
 DEFINE_bool(enable_optimizer, false, "Whether to enable optimizer");
 
+DEFINE_uint32(num_query_threads,
+              0,
+              "The number of threads dedicated to executing the query plans with the tasks "
+              "of interactive queries before the batch ones, 0 to run on the thrift worker "
+              "threads");
+
+DEFINE_uint32(max_job_size, 1, "The max number of concurrent jobs of one executor, 1 to disable");
+DEFINE_uint32(min_batch_size, 8192, "The min number of rows of each job in multi-job mode");
+
+DEFINE_bool(enable_pipeline,
+            false,
+            "Whether to run the chains of Filter, Project, Limit, Dedup and Unwind "
+            "as pipelines without storing the intermediate results");
+DEFINE_uint32(pipeline_batch_size, 1024, "The number of rows of each batch in pipeline");
+
+DEFINE_bool(enable_vectorized,
+            false,
+            "Whether to evaluate the expressions of Filter, Project and Aggregate "
+            "column by column over batches of rows");
+
+DEFINE_bool(enable_compiled_expr,
+            false,
+            "Whether to compile the expressions of Filter, Project and Aggregate for "
+            "the input to resolve the properties once instead of for each row");
+
+DEFINE_uint32(get_neighbors_parts,
+              1,
+              "The number of parts of each get neighbors request, the responses of parts "
+              "are handled as soon as they arrive, 1 to wait for the whole response");
+DEFINE_uint32(get_neighbors_batch_size,
+              0,
+              "The max number of vertices of each get neighbors request, the larger "
+              "frontiers are sent in batches, 0 for unlimited");
+DEFINE_uint32(get_neighbors_concurrency,
+              0,
+              "The max number of get neighbors requests of one executor in flight, "
+              "0 for unlimited");
+
+DEFINE_uint32(vertex_cache_capacity,
+              0,
+              "The max number of vertices whose props fetched are cached, 0 to disable");
+DEFINE_uint32(vertex_cache_ttl_ms,
+              1000,
+              "How long the cached vertex props are valid, for the writes by other graph "
+              "services, 0 to never expire");
+
+DEFINE_uint32(neighbor_cache_capacity,
+              0,
+              "The max number of vertices whose neighbors fetched are cached, 0 to disable");
+DEFINE_uint64(neighbor_cache_capacity_bytes,
+              256UL * 1024 * 1024,
+              "The max estimated bytes of the neighbors cached, the neighbors of a vertex "
+              "are never cached if they are larger than its share of a cache shard, "
+              "0 for no limit");
+DEFINE_uint32(neighbor_cache_ttl_ms,
+              1000,
+              "How long the cached neighbors are valid, for the writes by other graph "
+              "services, 0 to never expire");
+
+DEFINE_bool(coalesce_storage_requests,
+            false,
+            "Whether the identical get neighbors and get vertices requests in flight "
+            "of all queries share one storage request");
+
+DEFINE_uint32(plan_cache_capacity,
+              0,
+              "The max number of plans kept for the queries repeated with exactly the "
+              "same text in a session, 0 to disable");
+DEFINE_uint32(plan_cache_ttl_secs,
+              60,
+              "How long the cached plans are valid, for the schemas changed by other "
+              "graph services");
+
+DEFINE_bool(enable_optimizer_stats,
+            false,
+            "Whether to estimate the rows of plans by the counts of the last STATS job, "
+            "e.g. to start MATCH from the node of the fewest vertices");
+DEFINE_uint32(optimizer_stats_ttl_secs,
+              600,
+              "How long the stats fetched for the optimizer are used before fetched again");
+
+DEFINE_uint32(insert_batch_size,
+              0,
+              "The max number of vertices or edges of each insert request, the larger "
+              "inserts are sent in batches, 0 for unlimited");
+DEFINE_uint32(insert_concurrency,
+              0,
+              "The max number of insert requests of one statement in flight, 0 for unlimited");
+
+DEFINE_int64(query_memory_budget_bytes,
+             0,
+             "The memory budget of sort and aggregate working set in one query, "
+             "they spill to local files when exceeded, 0 for unlimited");
+DEFINE_string(spill_dir, "/tmp", "The directory to hold the spill files");
+DEFINE_uint32(spill_merge_fanin,
+              64,
+              "The max number of spilled sorted runs merged at once, more runs are merged "
+              "in multiple passes");
+
+DEFINE_int64(query_memory_limit_bytes,
+             0,
+             "The max memory held by the results of one query, "
+             "the query is killed when exceeded, 0 for unlimited");
+
 DEFINE_uint32(ft_request_retry_times, 3, "Retry times if fulltext request failed");
@@ -38,4 +38,58 @@ DECLARE_uint32(max_allowed_statements);
 // optimizer
 DECLARE_bool(enable_optimizer);
 
+// query threads
+DECLARE_uint32(num_query_threads);
+
+// multi-job execution
+DECLARE_uint32(max_job_size);
+DECLARE_uint32(min_batch_size);
+
+// pipelined execution
+DECLARE_bool(enable_pipeline);
+DECLARE_uint32(pipeline_batch_size);
+
+// vectorized execution
+DECLARE_bool(enable_vectorized);
+
+// compiled expressions
+DECLARE_bool(enable_compiled_expr);
+
+// streaming get neighbors
+DECLARE_uint32(get_neighbors_parts);
+DECLARE_uint32(get_neighbors_batch_size);
+DECLARE_uint32(get_neighbors_concurrency);
+
+// vertex cache
+DECLARE_uint32(vertex_cache_capacity);
+DECLARE_uint32(vertex_cache_ttl_ms);
+
+// neighbor cache
+DECLARE_uint32(neighbor_cache_capacity);
+DECLARE_uint64(neighbor_cache_capacity_bytes);
+DECLARE_uint32(neighbor_cache_ttl_ms);
+
+// request coalescing
+DECLARE_bool(coalesce_storage_requests);
+
+// plan cache
+DECLARE_uint32(plan_cache_capacity);
+DECLARE_uint32(plan_cache_ttl_secs);
+
+// optimizer stats
+DECLARE_bool(enable_optimizer_stats);
+DECLARE_uint32(optimizer_stats_ttl_secs);
+
+// batched insert
+DECLARE_uint32(insert_batch_size);
+DECLARE_uint32(insert_concurrency);
+
+// spill
+DECLARE_int64(query_memory_budget_bytes);
+DECLARE_string(spill_dir);
+DECLARE_uint32(spill_merge_fanin);
+
+// memory tracker
+DECLARE_int64(query_memory_limit_bytes);
+
 #endif   // GRAPH_GRAPHFLAGS_H_
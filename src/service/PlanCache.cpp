@@ -0,0 +1,195 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "service/PlanCache.h"
+
+#include "context/QueryContext.h"
+#include "parser/ExplainSentence.h"
+#include "parser/SequentialSentences.h"
+#include "parser/TraverseSentences.h"
+#include "service/PermissionCheck.h"
+
+namespace nebula {
+namespace graph {
+
+std::atomic<uint64_t> PlanCache::epoch_{0};
+
+PlanCache::PlanCache(size_t capacity, std::chrono::seconds ttl)
+    : capacity_(std::max<size_t>(capacity, 1)), ttl_(ttl) {}
+
+PlanCache::~PlanCache() = default;
+
+std::unique_ptr<PlanCache::CachedPlan> PlanCache::take(const std::string &key) {
+    std::unique_ptr<CachedPlan> plan;
+    {
+        std::lock_guard<std::mutex> lock(lock_);
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            auto &plans = found->second->plans;
+            plan = std::move(plans.back());
+            plans.pop_back();
+            if (plans.empty()) {
+                lru_.erase(found->second);
+                index_.erase(found);
+            } else {
+                lru_.splice(lru_.begin(), lru_, found->second);
+            }
+        }
+    }
+    if (plan == nullptr || stale(*plan)) {
+        // Destroyed out of the lock
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return plan;
+}
+
+void PlanCache::put(const std::string &key, std::unique_ptr<CachedPlan> plan) {
+    if (stale(*plan)) {
+        return;
+    }
+    std::vector<std::unique_ptr<CachedPlan>> dropped;
+    std::lock_guard<std::mutex> lock(lock_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+        // Made by an identical query at the same time
+        auto &plans = found->second->plans;
+        if (plans.size() < kMaxIdlePlans) {
+            plans.emplace_back(std::move(plan));
+        } else {
+            dropped.emplace_back(std::move(plan));
+        }
+        lru_.splice(lru_.begin(), lru_, found->second);
+        return;
+    }
+    lru_.emplace_front(Entry{key, {}});
+    lru_.front().plans.emplace_back(std::move(plan));
+    index_.emplace(key, lru_.begin());
+    if (lru_.size() > capacity_) {
+        dropped = std::move(lru_.back().plans);
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+size_t PlanCache::size() const {
+    std::lock_guard<std::mutex> lock(lock_);
+    return lru_.size();
+}
+
+bool PlanCache::stale(const CachedPlan &plan) const {
+    return plan.epoch != epoch() || Clock::now() - plan.createdAt > ttl_;
+}
+
+// static
+bool PlanCache::cacheable(const Sentence *sentence) {
+    switch (sentence->kind()) {
+        case Sentence::Kind::kSequential: {
+            auto *seq = static_cast<const SequentialSentences *>(sentence);
+            for (auto *s : seq->sentences()) {
+                if (!cacheable(s)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case Sentence::Kind::kPipe: {
+            auto *pipe = static_cast<const PipedSentence *>(sentence);
+            return cacheable(pipe->left()) && cacheable(pipe->right());
+        }
+        case Sentence::Kind::kSet: {
+            auto *set = static_cast<SetSentence *>(const_cast<Sentence *>(sentence));
+            return cacheable(set->left()) && cacheable(set->right());
+        }
+        case Sentence::Kind::kAssignment:
+            return cacheable(static_cast<const AssignmentSentence *>(sentence)->sentence());
+        case Sentence::Kind::kGo:
+        case Sentence::Kind::kMatch:
+        case Sentence::Kind::kFetchVertices:
+        case Sentence::Kind::kFetchEdges:
+        case Sentence::Kind::kLookup:
+        case Sentence::Kind::kFindPath:
+        case Sentence::Kind::kGetSubgraph:
+        case Sentence::Kind::kYield:
+        case Sentence::Kind::kOrderBy:
+        case Sentence::Kind::kLimit:
+        case Sentence::Kind::kGroupBy:
+        case Sentence::Kind::kReturn:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// static
+Status PlanCache::checkPermission(Session *session, Sentence *sentence) {
+    switch (sentence->kind()) {
+        case Sentence::Kind::kSequential: {
+            auto *seq = static_cast<SequentialSentences *>(sentence);
+            for (auto *s : seq->sentences()) {
+                NG_RETURN_IF_ERROR(checkPermission(session, s));
+            }
+            return Status::OK();
+        }
+        case Sentence::Kind::kPipe: {
+            auto *pipe = static_cast<PipedSentence *>(sentence);
+            NG_RETURN_IF_ERROR(checkPermission(session, pipe->left()));
+            return checkPermission(session, pipe->right());
+        }
+        case Sentence::Kind::kSet: {
+            auto *set = static_cast<SetSentence *>(sentence);
+            NG_RETURN_IF_ERROR(checkPermission(session, set->left()));
+            return checkPermission(session, set->right());
+        }
+        case Sentence::Kind::kAssignment:
+            return checkPermission(session,
+                                   static_cast<AssignmentSentence *>(sentence)->sentence());
+        default:
+            return PermissionCheck::permissionCheck(session, sentence, session->space().id);
+    }
+}
+
+// static
+bool PlanCache::invalidates(const Sentence *sentence) {
+    switch (sentence->kind()) {
+        case Sentence::Kind::kExplain:
+            return invalidates(static_cast<const ExplainSentence *>(sentence)->seqSentences());
+        case Sentence::Kind::kSequential: {
+            auto *seq = static_cast<const SequentialSentences *>(sentence);
+            for (auto *s : seq->sentences()) {
+                if (invalidates(s)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        case Sentence::Kind::kCreateTag:
+        case Sentence::Kind::kAlterTag:
+        case Sentence::Kind::kDropTag:
+        case Sentence::Kind::kCreateEdge:
+        case Sentence::Kind::kAlterEdge:
+        case Sentence::Kind::kDropEdge:
+        case Sentence::Kind::kCreateTagIndex:
+        case Sentence::Kind::kCreateEdgeIndex:
+        case Sentence::Kind::kDropTagIndex:
+        case Sentence::Kind::kDropEdgeIndex:
+        case Sentence::Kind::kCreateSpace:
+        case Sentence::Kind::kDropSpace:
+        case Sentence::Kind::kCreateUser:
+        case Sentence::Kind::kDropUser:
+        case Sentence::Kind::kAlterUser:
+        case Sentence::Kind::kGrant:
+        case Sentence::Kind::kRevoke:
+            return true;
+        default:
+            // The others are either queries or data changes, or can't be in a pipe
+            return false;
+    }
+}
+
+}   // namespace graph
+}   // namespace nebula
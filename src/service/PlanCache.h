@@ -0,0 +1,131 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef SERVICE_PLANCACHE_H_
+#define SERVICE_PLANCACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+#include "context/ExecutionContext.h"
+#include "parser/Sentence.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryContext;
+class Session;
+
+/***************************************************************************
+ *
+ * The plans validated and optimized, kept for the later queries of the same
+ * text in the same session and space, so they are executed again without
+ * being parsed, validated and optimized. The permission of the session is
+ * still checked each time, since its roles may be changed meanwhile. The
+ * literals are not normalized, since the validators fold them into the
+ * plans, e.g. the vertex ids to start from, and there are no placeholders
+ * to bind, so only the queries of exactly the same text share plans.
+ *
+ * The plan nodes keep the state of evaluating their expressions, so a plan
+ * is taken out while it's executed, and put back once done. The identical
+ * queries at the same time make plans of their own when all the plans of
+ * their text are taken, and up to `kMaxIdlePlans' of them are kept, so they
+ * all reuse plans the next time.
+ *
+ * The plans are dropped once any schema or role is changed by this graph
+ * service, see `invalidate', and `ttl' after they are made, for the changes
+ * made elsewhere.
+ *
+ **************************************************************************/
+class PlanCache final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct CachedPlan {
+        // Own the plan nodes and their expressions, some of which are in the sentence
+        std::unique_ptr<QueryContext> qctx;
+        std::unique_ptr<Sentence> sentence;
+        // The results preset by the validators, e.g. the literal vertex ids
+        std::unique_ptr<ExecutionContext> preset;
+        uint64_t epoch{0};
+        Clock::time_point createdAt;
+    };
+
+    // The plans kept for each query text
+    static constexpr size_t kMaxIdlePlans = 4;
+
+    // Keep the plans of at most `capacity' query texts
+    PlanCache(size_t capacity, std::chrono::seconds ttl);
+
+    ~PlanCache();
+
+    // Take a plan of `key' out to execute, nullptr if none is cached or not taken, or it's
+    // stale
+    std::unique_ptr<CachedPlan> take(const std::string &key);
+
+    // Put back the plan of `key', the plans of the least recently used key are dropped
+    // if full
+    void put(const std::string &key, std::unique_ptr<CachedPlan> plan);
+
+    // The number of keys whose plans are cached
+    size_t size() const;
+
+    uint64_t hits() const {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    // Only the plans of queries which read the graph are cached
+    static bool cacheable(const Sentence *sentence);
+
+    // Check the permission of `session' to run the cached `sentence' again, as the
+    // validators do
+    static Status checkPermission(Session *session, Sentence *sentence);
+
+    // Whether `sentence' may change the schemas or roles which the plans depend on
+    static bool invalidates(const Sentence *sentence);
+
+    // The plans made before the epoch changed are stale
+    static uint64_t epoch() {
+        return epoch_.load(std::memory_order_acquire);
+    }
+
+    static void invalidate() {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        // The plans not taken, never empty
+        std::vector<std::unique_ptr<CachedPlan>> plans;
+    };
+
+    bool stale(const CachedPlan &plan) const;
+
+    static std::atomic<uint64_t> epoch_;
+
+    size_t capacity_;
+    std::chrono::seconds ttl_;
+    mutable std::mutex lock_;
+    // The most recently used plan is at front
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // SERVICE_PLANCACHE_H_
@@ -62,6 +62,34 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
     }
     optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
 
+    if (FLAGS_num_query_threads > 0) {
+        runners_ = std::make_unique<QueryRunners>(FLAGS_num_query_threads);
+    }
+
+    if (FLAGS_vertex_cache_capacity > 0) {
+        vertexCache_ = std::make_unique<RowCache>(
+            FLAGS_vertex_cache_capacity, std::chrono::milliseconds(FLAGS_vertex_cache_ttl_ms));
+    }
+    if (FLAGS_neighbor_cache_capacity > 0) {
+        // The neighbors of a vertex vary much in size, so they are bounded by bytes too
+        neighborCache_ = std::make_unique<RowCache>(
+            FLAGS_neighbor_cache_capacity,
+            std::chrono::milliseconds(FLAGS_neighbor_cache_ttl_ms),
+            RowCache::kDefaultShards,
+            FLAGS_neighbor_cache_capacity_bytes);
+    }
+    if (FLAGS_coalesce_storage_requests) {
+        storageFlight_ = std::make_unique<StorageFlight>();
+    }
+    if (FLAGS_plan_cache_capacity > 0) {
+        planCache_ = std::make_unique<PlanCache>(
+            FLAGS_plan_cache_capacity, std::chrono::seconds(FLAGS_plan_cache_ttl_secs));
+    }
+    if (FLAGS_enable_optimizer_stats) {
+        statsCache_ = std::make_unique<StatsCache>(
+            metaClient_.get(), std::chrono::seconds(FLAGS_optimizer_stats_ttl_secs));
+    }
+
     return Status::OK();
 }
 
@@ -72,7 +100,13 @@ void QueryEngine::execute(RequestContextPtr rctx) {
                                                storage_.get(),
                                                metaClient_.get(),
                                                charsetInfo_);
-    auto* instance = new QueryInstance(std::move(ectx), optimizer_.get());
+    ectx->memTracker()->setLimit(FLAGS_query_memory_limit_bytes);
+    ectx->setVertexCache(vertexCache_.get());
+    ectx->setNeighborCache(neighborCache_.get());
+    ectx->setStorageFlight(storageFlight_.get());
+    ectx->setStatsCache(statsCache_.get());
+    auto* instance = new QueryInstance(
+        std::move(ectx), optimizer_.get(), runners_.get(), planCache_.get());
     instance->execute();
 }
 
@@ -18,7 +18,12 @@
 #include "common/clients/storage/GraphStorageClient.h"
 #include "common/network/NetworkUtils.h"
 #include "common/charset/Charset.h"
+#include "context/QueryContext.h"
 #include "optimizer/Optimizer.h"
+#include "scheduler/QueryRunners.h"
+#include "service/PlanCache.h"
+#include "util/RowCache.h"
+#include "util/StatsCache.h"
 #include <folly/executors/IOThreadPoolExecutor.h>
 
 /**
@@ -51,6 +56,18 @@ private:
     std::unique_ptr<storage::GraphStorageClient>      storage_;
     std::unique_ptr<meta::MetaClient>                 metaClient_;
     std::unique_ptr<opt::Optimizer>                   optimizer_;
+    // nullptr if the plans are executed on the thrift worker threads
+    std::unique_ptr<QueryRunners>                     runners_;
+    // nullptr if the vertices are not cached
+    std::unique_ptr<RowCache>                         vertexCache_;
+    // nullptr if the neighbors are not cached
+    std::unique_ptr<RowCache>                         neighborCache_;
+    // nullptr if the identical storage requests are not coalesced
+    std::unique_ptr<StorageFlight>                    storageFlight_;
+    // nullptr if the plans are not cached
+    std::unique_ptr<PlanCache>                        planCache_;
+    // nullptr if the plans are not estimated by the stats
+    std::unique_ptr<StatsCache>                       statsCache_;
     CharsetInfo*                                      charsetInfo_{nullptr};
 };
 
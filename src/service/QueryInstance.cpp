@@ -23,9 +23,14 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
-QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
+QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx,
+                             Optimizer *optimizer,
+                             QueryRunners *runners,
+                             PlanCache *planCache) {
     qctx_ = std::move(qctx);
     optimizer_ = DCHECK_NOTNULL(optimizer);
+    runners_ = runners;
+    planCache_ = planCache;
     scheduler_ = std::make_unique<Scheduler>(qctx_.get());
 }
 
@@ -41,7 +46,8 @@ void QueryInstance::execute() {
         return;
     }
 
-    scheduler_->schedule()
+    auto future = runners_ != nullptr ? scheduleOnRunner() : scheduler_->schedule();
+    std::move(future)
         .then([this](Status s) {
             if (s.ok()) {
                 this->onFinish();
@@ -53,10 +59,26 @@ void QueryInstance::execute() {
         .onError([this](const std::exception &e) { onError(Status::Error("%s", e.what())); });
 }
 
+folly::Future<Status> QueryInstance::scheduleOnRunner() {
+    // Run the whole plan on the query threads in the priority class of this query
+    auto priority = QueryRunners::classify(qctx_->plan()->root());
+    auto *runner = runners_->runner(priority);
+    qctx_->setPriority(priority);
+    qctx_->rctx()->setRunner(runner);
+    return folly::via(runner, [this]() { return scheduler_->schedule(); });
+}
+
 Status QueryInstance::validateAndOptimize() {
+    auto reused = reuseCachedPlan();
+    NG_RETURN_IF_ERROR(reused);
+    if (reused.value()) {
+        return Status::OK();
+    }
     auto *rctx = qctx()->rctx();
+    // The plan made is stale if the schemas are changed since now
+    auto epoch = PlanCache::epoch();
     VLOG(1) << "Parsing query: " << rctx->query();
-    auto result = GQLParser(qctx()).parse(rctx->query());
+    auto result = GQLParser::parseInThread(rctx->query(), qctx());
     NG_RETURN_IF_ERROR(result);
     sentence_ = std::move(result).value();
 
@@ -67,11 +89,69 @@ Status QueryInstance::validateAndOptimize() {
     auto newRoot = std::move(rootStatus).value();
     qctx_->setPlan(std::make_unique<ExecutionPlan>(const_cast<PlanNode *>(newRoot)));
 
+    if (planCache_ != nullptr && PlanCache::cacheable(sentence_.get())) {
+        cachedPlan_ = std::make_unique<PlanCache::CachedPlan>();
+        cachedPlan_->preset = std::make_unique<ExecutionContext>();
+        qctx_->ectx()->copyTo(cachedPlan_->preset.get());
+        cachedPlan_->epoch = epoch;
+        cachedPlan_->createdAt = PlanCache::Clock::now();
+    }
     return Status::OK();
 }
 
+StatusOr<bool> QueryInstance::reuseCachedPlan() {
+    if (planCache_ == nullptr) {
+        return false;
+    }
+    planKey_ = planKey();
+    cachedPlan_ = planCache_->take(planKey_);
+    if (cachedPlan_ == nullptr) {
+        return false;
+    }
+    // The roles of session may be changed since the plan was validated
+    auto status = PlanCache::checkPermission(qctx()->rctx()->session(),
+                                             cachedPlan_->sentence.get());
+    if (!status.ok()) {
+        cachedPlan_.reset();
+        return status;
+    }
+    VLOG(1) << "Reuse the plan of query: " << qctx()->rctx()->query();
+    cachedPlan_->preset->copyTo(qctx_->ectx());
+    qctx_->setPlan(std::make_unique<ExecutionPlan>(cachedPlan_->qctx->plan()->root()));
+    return true;
+}
+
+void QueryInstance::cachePlan(bool succeeded) {
+    if (sentence_ != nullptr && PlanCache::invalidates(sentence_.get())) {
+        PlanCache::invalidate();
+    }
+    if (cachedPlan_ == nullptr) {
+        return;
+    }
+    if (cachedPlan_->qctx == nullptr) {
+        // Made by this query, only kept if it works
+        if (!succeeded) {
+            return;
+        }
+        // Keep the plan nodes along with the context owning them, but not the request
+        // and the results of this query
+        qctx_->setRCtx(nullptr);
+        qctx_->resetExecution();
+        cachedPlan_->qctx = std::move(qctx_);
+        cachedPlan_->sentence = std::move(sentence_);
+    }
+    planCache_->put(planKey_, std::move(cachedPlan_));
+}
+
+std::string QueryInstance::planKey() const {
+    auto *rctx = qctx()->rctx();
+    auto *session = rctx->session();
+    return folly::stringPrintf("%ld:%d:", session->id(), session->space().id) + rctx->query();
+}
+
 bool QueryInstance::explainOrContinue() {
-    if (sentence_->kind() != Sentence::Kind::kExplain) {
+    // The plans reused are never explained
+    if (sentence_ == nullptr || sentence_->kind() != Sentence::Kind::kExplain) {
         return true;
     }
     qctx_->fillPlanDescription();
@@ -108,6 +188,7 @@ void QueryInstance::onFinish() {
     }
 
     rctx->finish();
+    cachePlan(true);
 
     // The `QueryInstance' is the root node holding all resources during the execution.
     // When the whole query process is done, it's safe to release this object, as long as
@@ -161,6 +242,7 @@ void QueryInstance::onError(Status status) {
     auto latency = rctx->duration().elapsedInUSec();
     rctx->resp().latencyInUs = latency;
     rctx->finish();
+    cachePlan(false);
     delete this;
 }
 
@@ -13,7 +13,9 @@
 #include "context/QueryContext.h"
 #include "optimizer/Optimizer.h"
 #include "parser/GQLParser.h"
+#include "scheduler/QueryRunners.h"
 #include "scheduler/Scheduler.h"
+#include "service/PlanCache.h"
 
 /**
  * QueryInstance coordinates the execution process,
@@ -26,7 +28,10 @@ namespace graph {
 
 class QueryInstance final : public cpp::NonCopyable, public cpp::NonMovable {
 public:
-    explicit QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+    QueryInstance(std::unique_ptr<QueryContext> qctx,
+                  opt::Optimizer* optimizer,
+                  QueryRunners* runners = nullptr,
+                  PlanCache* planCache = nullptr);
     ~QueryInstance() = default;
 
     void execute();
@@ -52,11 +57,27 @@ private:
     Status validateAndOptimize();
     // return true if continue to execute
     bool explainOrContinue();
+    folly::Future<Status> scheduleOnRunner();
+
+    // Execute the plan cached for the same query, return false if there is none, or an error
+    // if the session is no longer permitted to run it
+    StatusOr<bool> reuseCachedPlan();
+
+    // Keep the plan, which is reused or made by this query, for the later queries
+    void cachePlan(bool succeeded);
+
+    // The session, space and text of this query
+    std::string planKey() const;
 
     std::unique_ptr<Sentence>                   sentence_;
     std::unique_ptr<QueryContext>               qctx_;
     std::unique_ptr<Scheduler>                  scheduler_;
     opt::Optimizer*                             optimizer_{nullptr};
+    QueryRunners*                               runners_{nullptr};
+    PlanCache*                                  planCache_{nullptr};
+    // The plan reused, or the one to cache once this query succeeds
+    std::unique_ptr<PlanCache::CachedPlan>      cachedPlan_;
+    std::string                                 planKey_;
 };
 
 }   // namespace graph
@@ -11,6 +11,7 @@ namespace graph {
 
 Session::Session(int64_t id) {
     id_ = id;
+    memTracker_ = std::make_shared<MemoryTracker>(MemoryTracker::root());
 }
 
 std::shared_ptr<Session> Session::create(int64_t id) {
@@ -10,6 +10,7 @@
 #include "common/clients/meta/MetaClient.h"
 #include "common/interface/gen-cpp2/meta_types.h"
 #include "common/time/Duration.h"
+#include "util/MemoryTracker.h"
 
 namespace nebula {
 namespace graph {
@@ -79,6 +80,11 @@ public:
 
     uint64_t idleSeconds() const;
 
+    // Account the memory of all the running queries in this session
+    const std::shared_ptr<MemoryTracker>& memTracker() const {
+        return memTracker_;
+    }
+
     void charge();
 
 private:
@@ -91,6 +97,7 @@ private:
     SpaceInfo         space_;
     std::string       account_;
     time::Duration    idleDuration_;
+    std::shared_ptr<MemoryTracker> memTracker_;
     /*
      * map<spaceId, role>
      * One user can have roles in multiple spaces
@@ -0,0 +1,177 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include <gtest/gtest.h>
+
+#include "context/QueryContext.h"
+#include "optimizer/OptRule.h"
+#include "optimizer/Optimizer.h"
+#include "parser/GQLParser.h"
+#include "service/PlanCache.h"
+#include "service/GraphFlags.h"
+#include "service/QueryInstance.h"
+
+namespace nebula {
+namespace graph {
+
+static std::unique_ptr<PlanCache::CachedPlan> makePlan() {
+    auto plan = std::make_unique<PlanCache::CachedPlan>();
+    plan->qctx = std::make_unique<QueryContext>();
+    plan->preset = std::make_unique<ExecutionContext>();
+    plan->epoch = PlanCache::epoch();
+    plan->createdAt = PlanCache::Clock::now();
+    return plan;
+}
+
+static std::unique_ptr<Sentence> parse(const std::string &query) {
+    auto result = GQLParser().parse(query);
+    CHECK(result.ok()) << result.status();
+    return std::move(result).value();
+}
+
+TEST(PlanCacheTest, TakeAndPut) {
+    PlanCache cache(2, std::chrono::seconds(60));
+    EXPECT_EQ(cache.take("a"), nullptr);
+
+    cache.put("a", makePlan());
+    cache.put("b", makePlan());
+    auto plan = cache.take("a");
+    ASSERT_NE(plan, nullptr);
+    // Taken out while it's executed
+    EXPECT_EQ(cache.take("a"), nullptr);
+    cache.put("a", std::move(plan));
+
+    // "b" is the least recently used
+    cache.put("c", makePlan());
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.take("b"), nullptr);
+    EXPECT_NE(cache.take("c"), nullptr);
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 3);
+}
+
+TEST(PlanCacheTest, IdenticalQueries) {
+    PlanCache cache(2, std::chrono::seconds(60));
+    // Made by the identical queries at the same time
+    for (size_t i = 0; i < PlanCache::kMaxIdlePlans + 1; ++i) {
+        cache.put("a", makePlan());
+    }
+    EXPECT_EQ(cache.size(), 1);
+    std::vector<std::unique_ptr<PlanCache::CachedPlan>> plans;
+    for (size_t i = 0; i < PlanCache::kMaxIdlePlans; ++i) {
+        plans.emplace_back(cache.take("a"));
+        EXPECT_NE(plans.back(), nullptr);
+    }
+    EXPECT_EQ(cache.take("a"), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+    for (auto &plan : plans) {
+        cache.put("a", std::move(plan));
+    }
+    EXPECT_NE(cache.take("a"), nullptr);
+}
+
+TEST(PlanCacheTest, Stale) {
+    PlanCache cache(10, std::chrono::seconds(60));
+    cache.put("a", makePlan());
+    auto plan = makePlan();
+    PlanCache::invalidate();
+    EXPECT_EQ(cache.take("a"), nullptr);
+    // Made before the schemas changed
+    cache.put("b", std::move(plan));
+    EXPECT_EQ(cache.take("b"), nullptr);
+
+    PlanCache expiring(10, std::chrono::seconds(0));
+    plan = makePlan();
+    plan->createdAt -= std::chrono::seconds(1);
+    expiring.put("a", std::move(plan));
+    EXPECT_EQ(expiring.take("a"), nullptr);
+}
+
+// Run `query' to the end, the plan is reused or made, and then cached
+static ExecutionResponse run(PlanCache *cache,
+                             opt::Optimizer *optimizer,
+                             std::shared_ptr<Session> session,
+                             const std::string &query) {
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setQuery(query);
+    rctx->setSession(std::move(session));
+    auto future = rctx->future();
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->setRCtx(std::move(rctx));
+    // Deleted by itself once done, which is before `execute' returns without the runners
+    auto *instance = new QueryInstance(std::move(qctx), optimizer, nullptr, cache);
+    instance->execute();
+    return std::move(future).get();
+}
+
+TEST(PlanCacheTest, Queries) {
+    PlanCache cache(10, std::chrono::seconds(60));
+    opt::Optimizer optimizer({&opt::RuleSet::QueryRules()});
+    auto session = Session::create(1);
+    std::string query = "$a = YIELD 1 AS x, 2 AS y; YIELD $a.x + $a.y AS z, \"b\" AS s";
+
+    auto made = run(&cache, &optimizer, session, query);
+    ASSERT_EQ(made.errorCode, ErrorCode::SUCCEEDED);
+    ASSERT_NE(made.data, nullptr);
+    DataSet expected({"z", "s"});
+    expected.emplace_back(Row({3, "b"}));
+    EXPECT_EQ(*made.data, expected);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.hits(), 0);
+
+    // Executed again by the plan cached, to the same result
+    for (auto i = 0; i < 2; ++i) {
+        auto reused = run(&cache, &optimizer, session, query);
+        ASSERT_EQ(reused.errorCode, ErrorCode::SUCCEEDED);
+        ASSERT_NE(reused.data, nullptr);
+        EXPECT_EQ(*reused.data, *made.data);
+        EXPECT_EQ(cache.hits(), i + 1);
+        EXPECT_EQ(cache.size(), 1);
+    }
+
+    // Different literals make a plan of their own
+    auto other = run(&cache, &optimizer, session, "YIELD 2 AS x");
+    ASSERT_EQ(other.errorCode, ErrorCode::SUCCEEDED);
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(PlanCacheTest, Sentences) {
+    EXPECT_TRUE(PlanCache::cacheable(parse("GO FROM \"a\" OVER like").get()));
+    EXPECT_TRUE(PlanCache::cacheable(
+        parse("GO FROM \"a\" OVER like YIELD like._dst AS id | "
+              "FETCH PROP ON person $-.id").get()));
+    EXPECT_TRUE(PlanCache::cacheable(parse("$a = GO FROM \"a\" OVER like; YIELD 1").get()));
+    EXPECT_FALSE(PlanCache::cacheable(parse("USE test; GO FROM \"a\" OVER like").get()));
+    EXPECT_FALSE(PlanCache::cacheable(parse("INSERT VERTEX person(name) VALUES \"a\":(\"a\")")
+                                          .get()));
+    EXPECT_FALSE(PlanCache::cacheable(parse("EXPLAIN GO FROM \"a\" OVER like").get()));
+
+    EXPECT_TRUE(PlanCache::invalidates(parse("CREATE TAG person(name string)").get()));
+    EXPECT_TRUE(PlanCache::invalidates(parse("ALTER EDGE like ADD (w int)").get()));
+    EXPECT_TRUE(PlanCache::invalidates(parse("GRANT ROLE ADMIN ON test TO user1").get()));
+    EXPECT_FALSE(PlanCache::invalidates(parse("GO FROM \"a\" OVER like").get()));
+    EXPECT_FALSE(PlanCache::invalidates(parse("DELETE VERTEX \"a\"").get()));
+}
+
+TEST(PlanCacheTest, Permission) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_enable_authorize = true;
+    auto session = Session::create(1);
+    SpaceInfo space;
+    space.id = 1;
+    session->setSpace(space);
+    auto sentence = parse("$a = GO FROM \"a\" OVER like YIELD like._dst AS id; "
+                          "GO FROM $a.id OVER like | YIELD 1");
+    // No role in the space
+    EXPECT_FALSE(PlanCache::checkPermission(session.get(), sentence.get()).ok());
+
+    session->setRole(1, meta::cpp2::RoleType::GUEST);
+    EXPECT_TRUE(PlanCache::checkPermission(session.get(), sentence.get()).ok());
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,254 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/CompiledExpr.h"
+
+#include <limits>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "context/Iterator.h"
+#include "context/QueryExpressionContext.h"
+#include "util/ExprKernels.h"
+
+namespace nebula {
+namespace graph {
+
+// static
+std::unique_ptr<CompiledExpr> CompiledExpr::compile(Expression *expr, const Iterator *iter) {
+    size_t numResolved = 0;
+    auto root = build(expr, iter, &numResolved);
+    if (numResolved == 0) {
+        return nullptr;
+    }
+    return std::unique_ptr<CompiledExpr>(new CompiledExpr(std::move(root)));
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::build(Expression *expr,
+                                          const Iterator *iter,
+                                          size_t *numResolved) {
+    switch (expr->kind()) {
+        case Expression::Kind::kInputProperty:
+        case Expression::Kind::kVarProperty:
+        case Expression::Kind::kTagProperty:
+        case Expression::Kind::kSrcProperty:
+        case Expression::Kind::kDstProperty:
+        case Expression::Kind::kEdgeProperty: {
+            auto closure = buildProperty(expr, iter);
+            if (closure) {
+                ++*numResolved;
+                return closure;
+            }
+            break;
+        }
+        case Expression::Kind::kConstant: {
+            auto &val = static_cast<ConstantExpression *>(expr)->value();
+            return [&val](Iterator *, QueryExpressionContext &) -> const Value & { return val; };
+        }
+        case Expression::Kind::kAdd:
+        case Expression::Kind::kMinus:
+        case Expression::Kind::kMultiply:
+        case Expression::Kind::kDivision:
+        case Expression::Kind::kMod: {
+            auto *arith = static_cast<ArithmeticExpression *>(expr);
+            return buildArithmetic(expr,
+                                   build(arith->left(), iter, numResolved),
+                                   build(arith->right(), iter, numResolved));
+        }
+        case Expression::Kind::kRelEQ:
+        case Expression::Kind::kRelNE:
+        case Expression::Kind::kRelLT:
+        case Expression::Kind::kRelLE:
+        case Expression::Kind::kRelGT:
+        case Expression::Kind::kRelGE: {
+            auto *rel = static_cast<RelationalExpression *>(expr);
+            return buildRelational(expr,
+                                   build(rel->left(), iter, numResolved),
+                                   build(rel->right(), iter, numResolved));
+        }
+        case Expression::Kind::kLogicalAnd:
+        case Expression::Kind::kLogicalOr: {
+            std::vector<Closure> operands;
+            for (auto &operand : static_cast<LogicalExpression *>(expr)->operands()) {
+                operands.emplace_back(build(operand.get(), iter, numResolved));
+            }
+            return buildLogical(expr, std::move(operands));
+        }
+        case Expression::Kind::kUnaryNot:
+        case Expression::Kind::kUnaryNegate: {
+            auto *operand = static_cast<UnaryExpression *>(expr)->operand();
+            return buildUnary(expr, build(operand, iter, numResolved));
+        }
+        default:
+            break;
+    }
+    return buildRow(expr);
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildProperty(Expression *expr, const Iterator *iter) {
+    auto *propExpr = static_cast<PropertyExpression *>(expr);
+    auto &prop = *propExpr->prop();
+    auto kind = expr->kind();
+    bool isColumn =
+        kind == Expression::Kind::kInputProperty || kind == Expression::Kind::kVarProperty;
+
+    if (iter->isSequentialIter()) {
+        // The vertex and edge properties are the columns named `sym.prop'
+        auto name = isColumn ? prop : *propExpr->sym() + "." + prop;
+        auto &colIndices = static_cast<const SequentialIter *>(iter)->getColIndices();
+        auto found = colIndices.find(name);
+        if (found == colIndices.end()) {
+            return nullptr;
+        }
+        auto index = static_cast<int32_t>(found->second);
+        return [index](Iterator *it, QueryExpressionContext &) -> const Value & {
+            if (!it->valid()) {
+                return Value::kNullValue;
+            }
+            return it->getColumn(index);
+        };
+    }
+
+    if (!iter->isGetNeighborsIter()) {
+        return nullptr;
+    }
+    auto *gnIter = static_cast<const GetNeighborsIter *>(iter);
+    if (isColumn) {
+        auto positions = gnIter->columnPositions(prop);
+        return [positions](Iterator *it, QueryExpressionContext &) -> const Value & {
+            return static_cast<GetNeighborsIter *>(it)->getColumnAt(positions);
+        };
+    }
+    if (kind != Expression::Kind::kEdgeProperty) {
+        // The source and destination properties are read as the tag properties
+        auto positions = gnIter->tagPropPositions(*propExpr->sym(), prop);
+        return [positions](Iterator *it, QueryExpressionContext &) -> const Value & {
+            return static_cast<GetNeighborsIter *>(it)->getTagPropAt(positions);
+        };
+    }
+    auto &edge = *propExpr->sym();
+    if (edge == "*") {
+        // The property of any edge depends on the edge of each row
+        return nullptr;
+    }
+    auto positions = gnIter->edgePropPositions(edge, prop);
+    return [positions](Iterator *it, QueryExpressionContext &) -> const Value & {
+        return static_cast<GetNeighborsIter *>(it)->getEdgePropAt(positions);
+    };
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildArithmetic(Expression *expr, Closure lhs, Closure rhs) {
+    return [expr, lhs = std::move(lhs), rhs = std::move(rhs), result = Value()](
+               Iterator *it, QueryExpressionContext &ctx) mutable -> const Value & {
+        auto &l = lhs(it, ctx);
+        auto &r = rhs(it, ctx);
+        auto kind = expr->kind();
+        if (l.isInt() && r.isInt()) {
+            int64_t val;
+            if (ExprKernels::arithInt(kind, l.getInt(), r.getInt(), &val)) {
+                result = val;
+                return result;
+            }
+        } else if (l.isNumeric() && r.isNumeric()) {
+            // At least one of them is float, the result is float
+            double val;
+            auto toFloat = [](const Value &v) {
+                return v.isInt() ? static_cast<double>(v.getInt()) : v.getFloat();
+            };
+            if (ExprKernels::arithFloat(kind, toFloat(l), toFloat(r), &val)) {
+                result = val;
+                return result;
+            }
+        }
+        return expr->eval(ctx(it));
+    };
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildRelational(Expression *expr, Closure lhs, Closure rhs) {
+    return [expr, lhs = std::move(lhs), rhs = std::move(rhs), result = Value()](
+               Iterator *it, QueryExpressionContext &ctx) mutable -> const Value & {
+        auto &l = lhs(it, ctx);
+        auto &r = rhs(it, ctx);
+        auto kind = expr->kind();
+        if (l.type() == r.type()) {
+            switch (l.type()) {
+                case Value::Type::INT:
+                    result = ExprKernels::compare(kind, l.getInt(), r.getInt());
+                    return result;
+                case Value::Type::STRING:
+                    result = ExprKernels::compare(kind, l.getStr(), r.getStr());
+                    return result;
+                case Value::Type::BOOL:
+                    if (kind == Expression::Kind::kRelEQ || kind == Expression::Kind::kRelNE) {
+                        result = ExprKernels::compare(kind, l.getBool(), r.getBool());
+                        return result;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        return expr->eval(ctx(it));
+    };
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildLogical(Expression *expr, std::vector<Closure> operands) {
+    return [expr, operands = std::move(operands), result = Value()](
+               Iterator *it, QueryExpressionContext &ctx) mutable -> const Value & {
+        bool isAnd = expr->kind() == Expression::Kind::kLogicalAnd;
+        bool val = isAnd;
+        for (auto &operand : operands) {
+            auto &v = operand(it, ctx);
+            if (!v.isBool()) {
+                // NULL and EMPTY follow the three-valued logic of the original expression
+                return expr->eval(ctx(it));
+            }
+            val = isAnd ? (val && v.getBool()) : (val || v.getBool());
+        }
+        result = val;
+        return result;
+    };
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildUnary(Expression *expr, Closure operand) {
+    return [expr, operand = std::move(operand), result = Value()](
+               Iterator *it, QueryExpressionContext &ctx) mutable -> const Value & {
+        auto &v = operand(it, ctx);
+        if (expr->kind() == Expression::Kind::kUnaryNot) {
+            if (v.isBool()) {
+                result = !v.getBool();
+                return result;
+            }
+        } else if (v.isInt() && v.getInt() != std::numeric_limits<int64_t>::min()) {
+            result = -v.getInt();
+            return result;
+        } else if (v.isFloat()) {
+            result = -v.getFloat();
+            return result;
+        }
+        return expr->eval(ctx(it));
+    };
+}
+
+// static
+CompiledExpr::Closure CompiledExpr::buildRow(Expression *expr) {
+    return [expr](Iterator *it, QueryExpressionContext &ctx) -> const Value & {
+        return expr->eval(ctx(it));
+    };
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,73 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_COMPILEDEXPR_H_
+#define UTIL_COMPILEDEXPR_H_
+
+#include "common/base/Base.h"
+#include "common/expression/Expression.h"
+
+namespace nebula {
+namespace graph {
+
+class Iterator;
+class QueryExpressionContext;
+
+/***************************************************************************
+ *
+ * An expression lowered to a tree of closures for the rows of an iterator.
+ *
+ * The input, variable, tag and edge properties are resolved to the positions
+ * in the rows once when compiling, so evaluating a row doesn't look up any
+ * names. Constants, arithmetic, comparison and logical operations on plain
+ * int, float, bool and string values are computed by the closures directly.
+ * The other values (e.g. NULL or overflow) and the other expressions are
+ * evaluated by the original expression, so the results are always the same.
+ *
+ * It's only evaluated on the rows of the iterator it's compiled for, and like
+ * the expression it's made from, it's not thread-safe.
+ *
+ **************************************************************************/
+class CompiledExpr final {
+public:
+    // Return nullptr if no property of `expr' could be resolved for `iter', it's
+    // evaluated as it is then.
+    static std::unique_ptr<CompiledExpr> compile(Expression *expr, const Iterator *iter);
+
+    // Evaluate on the current row of `iter', the same as `expr->eval(ctx(iter))'
+    const Value &eval(Iterator *iter, QueryExpressionContext &ctx) const {
+        return root_(iter, ctx);
+    }
+
+private:
+    using Closure = std::function<const Value &(Iterator *, QueryExpressionContext &)>;
+
+    explicit CompiledExpr(Closure root) : root_(std::move(root)) {}
+
+    // `numResolved' counts the properties resolved to positions
+    static Closure build(Expression *expr, const Iterator *iter, size_t *numResolved);
+
+    // Read the property from the position in the rows of `iter', nullptr if not resolved
+    static Closure buildProperty(Expression *expr, const Iterator *iter);
+
+    static Closure buildArithmetic(Expression *expr, Closure lhs, Closure rhs);
+
+    static Closure buildRelational(Expression *expr, Closure lhs, Closure rhs);
+
+    static Closure buildLogical(Expression *expr, std::vector<Closure> operands);
+
+    static Closure buildUnary(Expression *expr, Closure operand);
+
+    // Evaluate by the original expression
+    static Closure buildRow(Expression *expr);
+
+    Closure root_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_COMPILEDEXPR_H_
@@ -0,0 +1,94 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_EXPRKERNELS_H_
+#define UTIL_EXPRKERNELS_H_
+
+#include <limits>
+
+#include "common/base/Base.h"
+#include "common/expression/Expression.h"
+
+namespace nebula {
+namespace graph {
+
+// The typed operations shared by the vectorized and compiled expressions. They only
+// cover the results which are well defined on plain int, float, bool and string values,
+// the callers evaluate the original expression for the others.
+class ExprKernels final {
+public:
+    ExprKernels() = delete;
+
+    // Return false if the result could not be represented as int, e.g. overflow
+    static bool arithInt(Expression::Kind kind, int64_t lhs, int64_t rhs, int64_t *result) {
+        switch (kind) {
+            case Expression::Kind::kAdd:
+                return !__builtin_add_overflow(lhs, rhs, result);
+            case Expression::Kind::kMinus:
+                return !__builtin_sub_overflow(lhs, rhs, result);
+            case Expression::Kind::kMultiply:
+                return !__builtin_mul_overflow(lhs, rhs, result);
+            case Expression::Kind::kDivision:
+            case Expression::Kind::kMod:
+                if (rhs == 0 || (lhs == std::numeric_limits<int64_t>::min() && rhs == -1)) {
+                    return false;
+                }
+                *result = kind == Expression::Kind::kDivision ? lhs / rhs : lhs % rhs;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool arithFloat(Expression::Kind kind, double lhs, double rhs, double *result) {
+        switch (kind) {
+            case Expression::Kind::kAdd:
+                *result = lhs + rhs;
+                return true;
+            case Expression::Kind::kMinus:
+                *result = lhs - rhs;
+                return true;
+            case Expression::Kind::kMultiply:
+                *result = lhs * rhs;
+                return true;
+            case Expression::Kind::kDivision:
+                if (rhs == 0) {
+                    return false;
+                }
+                *result = lhs / rhs;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // The float values are not compared here, Value compares them with its own precision
+    template <typename T>
+    static bool compare(Expression::Kind kind, const T &lhs, const T &rhs) {
+        switch (kind) {
+            case Expression::Kind::kRelEQ:
+                return lhs == rhs;
+            case Expression::Kind::kRelNE:
+                return lhs != rhs;
+            case Expression::Kind::kRelLT:
+                return lhs < rhs;
+            case Expression::Kind::kRelLE:
+                return lhs <= rhs;
+            case Expression::Kind::kRelGT:
+                return lhs > rhs;
+            case Expression::Kind::kRelGE:
+                return lhs >= rhs;
+            default:
+                LOG(FATAL) << "Unexpected relational expression kind " << static_cast<int>(kind);
+                return false;
+        }
+    }
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_EXPRKERNELS_H_
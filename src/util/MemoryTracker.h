@@ -0,0 +1,177 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_MEMORYTRACKER_H_
+#define UTIL_MEMORYTRACKER_H_
+
+#include <atomic>
+#include <memory>
+
+#include "common/base/Logging.h"
+#include "common/cpp/helpers.h"
+
+namespace nebula {
+namespace graph {
+
+// Account the memory held by the results in a hierarchy of process -> session -> query
+// -> executor. The bytes consumed by a tracker are also consumed by all its ancestors,
+// and each tracker remembers its own peak. A tracker with non-zero limit is exceeded
+// when its current bytes go beyond the limit, the owner should stop the work then.
+//
+// All the methods are thread-safe.
+class MemoryTracker final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    // The root tracker of the whole process
+    static std::shared_ptr<MemoryTracker> root() {
+        static std::shared_ptr<MemoryTracker> kRoot = std::make_shared<MemoryTracker>(nullptr);
+        return kRoot;
+    }
+
+    explicit MemoryTracker(std::shared_ptr<MemoryTracker> parent, int64_t limit = 0)
+        : parent_(std::move(parent)), limit_(limit) {}
+
+    ~MemoryTracker() {
+        // Return what's still held to the ancestors
+        if (parent_ != nullptr) {
+            parent_->release(current());
+        }
+    }
+
+    // Consume the bytes in this tracker and all its ancestors.
+    // Return false if any of them is exceeded, the bytes are consumed anyway.
+    bool consume(int64_t bytes) {
+        bool ok = true;
+        for (auto *tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+            auto current = tracker->current_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            tracker->updatePeak(current);
+            auto limit = tracker->limit_.load(std::memory_order_relaxed);
+            if (limit > 0 && current > limit) {
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    void release(int64_t bytes) {
+        for (auto *tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+            tracker->current_.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    // Whether this tracker or any of its ancestors goes beyond its limit
+    bool exceeded() const {
+        for (auto *tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+            auto limit = tracker->limit();
+            if (limit > 0 && tracker->current() > limit) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Whether this tracker or any of its ancestors has a limit
+    bool limited() const {
+        for (auto *tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+            if (tracker->limit() > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int64_t current() const {
+        return current_.load(std::memory_order_relaxed);
+    }
+
+    int64_t peak() const {
+        return peak_.load(std::memory_order_relaxed);
+    }
+
+    // Start a new peak from the current bytes, e.g. for each execution of an executor in loop
+    void resetPeak() {
+        peak_.store(current(), std::memory_order_relaxed);
+    }
+
+    int64_t limit() const {
+        return limit_.load(std::memory_order_relaxed);
+    }
+
+    // 0 for unlimited
+    void setLimit(int64_t limit) {
+        limit_.store(limit, std::memory_order_relaxed);
+    }
+
+    MemoryTracker *parent() const {
+        return parent_.get();
+    }
+
+private:
+    void updatePeak(int64_t current) {
+        auto peak = peak_.load(std::memory_order_relaxed);
+        while (current > peak &&
+               !peak_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Keep the ancestors alive as long as some bytes may be released to them
+    std::shared_ptr<MemoryTracker> parent_;
+    std::atomic<int64_t> current_{0};
+    std::atomic<int64_t> peak_{0};
+    std::atomic<int64_t> limit_{0};
+};
+
+// The bytes consumed from a tracker, they are released back when this object is destroyed.
+// It's movable so that it could follow the object it accounts for.
+class MemoryReservation final {
+public:
+    MemoryReservation() = default;
+
+    MemoryReservation(std::shared_ptr<MemoryTracker> tracker, int64_t bytes)
+        : tracker_(std::move(tracker)), bytes_(bytes) {}
+
+    MemoryReservation(MemoryReservation &&rhs) noexcept
+        : tracker_(std::move(rhs.tracker_)), bytes_(rhs.bytes_) {
+        rhs.bytes_ = 0;
+    }
+
+    MemoryReservation &operator=(MemoryReservation &&rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            tracker_ = std::move(rhs.tracker_);
+            bytes_ = rhs.bytes_;
+            rhs.bytes_ = 0;
+        }
+        return *this;
+    }
+
+    MemoryReservation(const MemoryReservation &) = delete;
+    MemoryReservation &operator=(const MemoryReservation &) = delete;
+
+    ~MemoryReservation() {
+        reset();
+    }
+
+    void reset() {
+        if (tracker_ != nullptr) {
+            tracker_->release(bytes_);
+            tracker_.reset();
+        }
+        bytes_ = 0;
+    }
+
+    int64_t bytes() const {
+        return bytes_;
+    }
+
+private:
+    std::shared_ptr<MemoryTracker> tracker_;
+    int64_t bytes_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_MEMORYTRACKER_H_
@@ -0,0 +1,128 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/MemoryUtil.h"
+
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// Approximate overhead of one node of the std::unordered_map/std::unordered_set
+constexpr size_t kHashNodeOverhead = 2 * sizeof(void *);
+
+size_t estimateProps(const std::unordered_map<std::string, Value> &props) {
+    size_t size = props.bucket_count() * sizeof(void *);
+    for (auto &kv : props) {
+        size += kHashNodeOverhead + sizeof(kv) + kv.first.capacity();
+        size += MemoryUtil::estimateSize(kv.second) - sizeof(Value);
+    }
+    return size;
+}
+
+size_t estimateVertex(const Vertex &vertex) {
+    size_t size = sizeof(Vertex) + MemoryUtil::estimateSize(vertex.vid);
+    for (auto &tag : vertex.tags) {
+        size += sizeof(tag) + tag.name.capacity() + estimateProps(tag.props);
+    }
+    return size;
+}
+
+}   // namespace
+
+// static
+size_t MemoryUtil::estimateSize(const Value &value) {
+    size_t size = sizeof(Value);
+    switch (value.type()) {
+        case Value::Type::STRING: {
+            size += value.getStr().capacity();
+            break;
+        }
+        case Value::Type::VERTEX: {
+            size += estimateVertex(value.getVertex());
+            break;
+        }
+        case Value::Type::EDGE: {
+            auto &edge = value.getEdge();
+            size += sizeof(Edge) + estimateSize(edge.src) + estimateSize(edge.dst);
+            size += edge.name.capacity() + estimateProps(edge.props);
+            break;
+        }
+        case Value::Type::PATH: {
+            auto &path = value.getPath();
+            size += sizeof(Path) + estimateVertex(path.src);
+            for (auto &step : path.steps) {
+                size += sizeof(step) + estimateVertex(step.dst);
+                size += step.name.capacity() + estimateProps(step.props);
+            }
+            break;
+        }
+        case Value::Type::LIST: {
+            size += estimateSize(value.getList());
+            break;
+        }
+        case Value::Type::MAP: {
+            size += sizeof(Map) + estimateProps(value.getMap().kvs);
+            break;
+        }
+        case Value::Type::SET: {
+            auto &set = value.getSet();
+            size += sizeof(Set) + set.values.bucket_count() * sizeof(void *);
+            for (auto &v : set.values) {
+                size += kHashNodeOverhead + estimateSize(v);
+            }
+            break;
+        }
+        case Value::Type::DATASET: {
+            size += estimateSize(value.getDataSet());
+            break;
+        }
+        default: {
+            // The scalar values are stored inline
+            break;
+        }
+    }
+    return size;
+}
+
+// static
+size_t MemoryUtil::estimateSize(const List &list) {
+    size_t size = sizeof(List);
+    for (auto &v : list.values) {
+        size += estimateSize(v);
+    }
+    return size;
+}
+
+// static
+size_t MemoryUtil::estimateSize(const Row &row) {
+    size_t size = sizeof(Row);
+    for (auto &v : row.values) {
+        size += estimateSize(v);
+    }
+    return size;
+}
+
+// static
+size_t MemoryUtil::estimateSize(const DataSet &ds) {
+    size_t size = sizeof(DataSet);
+    for (auto &col : ds.colNames) {
+        size += sizeof(col) + col.capacity();
+    }
+    for (auto &row : ds.rows) {
+        size += estimateSize(row);
+    }
+    return size;
+}
+
+}  // namespace graph
+}  // namespace nebula
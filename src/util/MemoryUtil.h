@@ -0,0 +1,35 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_MEMORYUTIL_H_
+#define UTIL_MEMORYUTIL_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Estimate the memory held by the values. It's not the exact allocated size, but is
+// accurate enough to decide whether some data should be spilled or rejected.
+class MemoryUtil final {
+public:
+    MemoryUtil() = delete;
+
+    static size_t estimateSize(const Value &value);
+
+    static size_t estimateSize(const List &list);
+
+    static size_t estimateSize(const Row &row);
+
+    static size_t estimateSize(const DataSet &ds);
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // UTIL_MEMORYUTIL_H_
@@ -0,0 +1,173 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/MultiSourceBfs.h"
+
+namespace nebula {
+namespace graph {
+
+void MultiSourceBfs::setStarts(const std::vector<Id> &ids) {
+    DCHECK(layers_.empty());
+    auto size = index_->size();
+    fetched_.resize(size, false);
+    for (auto id : ids) {
+        if (!fetched_[id]) {
+            fetched_[id] = true;
+            starts_.emplace_back(id);
+        }
+    }
+    words_ = (starts_.size() + 63) / 64;
+    seen_.resize(size * words_, 0);
+
+    Layer starts;
+    starts.slots.resize(size, VidIndex::kNone);
+    for (size_t i = 0; i < starts_.size(); ++i) {
+        reach(starts, starts_[i])[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    addLayer(std::move(starts));
+}
+
+void MultiSourceBfs::addArc(Id src,
+                            Id dst,
+                            EdgeType type,
+                            EdgeRanking ranking,
+                            const std::string &name) {
+    if (index_->size() > outs_.size()) {
+        outs_.resize(index_->size(), VidIndex::kNone);
+        ins_.resize(index_->size(), VidIndex::kNone);
+    }
+    names_.emplace(type, name);
+    arcs_.emplace_back(Arc{src, dst, type, ranking, outs_[src], ins_[dst]});
+    outs_[src] = static_cast<uint32_t>(arcs_.size() - 1);
+    ins_[dst] = outs_[src];
+}
+
+std::vector<MultiSourceBfs::Id> MultiSourceBfs::expand() {
+    auto size = index_->size();
+    outs_.resize(size, VidIndex::kNone);
+    ins_.resize(size, VidIndex::kNone);
+    fetched_.resize(size, false);
+    seen_.resize(size * words_, 0);
+
+    DCHECK(!layers_.empty());
+
+    // Walk the arcs of each vertex once for all the starts reaching it
+    Layer next;
+    next.slots.resize(size, VidIndex::kNone);
+    auto &prev = layers_.back();
+    for (size_t i = 0; i < prev.vids.size(); ++i) {
+        auto *from = &prev.masks[i * words_];
+        for (auto a = outs_[prev.vids[i]]; a != VidIndex::kNone; a = arcs_[a].nextOut) {
+            auto dst = arcs_[a].dst;
+            auto *seen = &seen_[dst * words_];
+            for (size_t w = 0; w < words_; ++w) {
+                auto reached = from[w] & ~seen[w];
+                if (reached != 0) {
+                    reach(next, dst)[w] |= reached;
+                }
+            }
+        }
+    }
+    return addLayer(std::move(next));
+}
+
+uint64_t *MultiSourceBfs::reach(Layer &layer, Id id) const {
+    auto slot = layer.slots[id];
+    if (slot == VidIndex::kNone) {
+        slot = static_cast<uint32_t>(layer.vids.size());
+        layer.slots[id] = slot;
+        layer.vids.emplace_back(id);
+        layer.masks.resize(layer.masks.size() + words_, 0);
+    }
+    return &layer.masks[slot * words_];
+}
+
+std::vector<MultiSourceBfs::Id> MultiSourceBfs::addLayer(Layer &&next) {
+    std::vector<Id> frontier;
+    for (size_t i = 0; i < next.vids.size(); ++i) {
+        auto id = next.vids[i];
+        for (size_t w = 0; w < words_; ++w) {
+            seen_[id * words_ + w] |= next.masks[i * words_ + w];
+        }
+        if (!fetched_[id]) {
+            fetched_[id] = true;
+            frontier.emplace_back(id);
+        }
+    }
+    layers_.emplace_back(std::move(next));
+    return frontier;
+}
+
+const uint64_t *MultiSourceBfs::mask(size_t layer, Id id) const {
+    DCHECK_LT(layer, layers_.size());
+    auto &l = layers_[layer];
+    if (id >= l.slots.size() || l.slots[id] == VidIndex::kNone) {
+        return nullptr;
+    }
+    return &l.masks[l.slots[id] * words_];
+}
+
+void MultiSourceBfs::paths(size_t start,
+                           size_t layer,
+                           Id id,
+                           std::vector<std::vector<uint32_t>> &paths) const {
+    std::vector<uint32_t> path;
+    path.reserve(layer);
+    walk(start, layer, id, path, paths);
+}
+
+void MultiSourceBfs::walk(size_t start,
+                          size_t layer,
+                          Id id,
+                          std::vector<uint32_t> &path,
+                          std::vector<std::vector<uint32_t>> &paths) const {
+    if (layer == 0) {
+        DCHECK_EQ(id, starts_[start]);
+        paths.emplace_back(path);
+        return;
+    }
+    if (id >= ins_.size()) {
+        return;
+    }
+    // Step back to each vertex the start reaches first in the previous layer
+    for (auto a = ins_[id]; a != VidIndex::kNone; a = arcs_[a].nextIn) {
+        auto *prev = mask(layer - 1, arcs_[a].src);
+        if (prev == nullptr || !test(prev, start)) {
+            continue;
+        }
+        path.emplace_back(a);
+        walk(start, layer - 1, arcs_[a].src, path, paths);
+        path.pop_back();
+    }
+}
+
+void MultiSourceBfs::forwardSteps(const std::vector<uint32_t> &path, Path &result) const {
+    DCHECK(!path.empty());
+    result.src = Vertex(index_->vid(arcs_[path.back()].src), {});
+    result.steps.reserve(result.steps.size() + path.size());
+    for (auto i = path.rbegin(); i != path.rend(); ++i) {
+        result.steps.emplace_back(step(arcs_[*i], false));
+    }
+}
+
+void MultiSourceBfs::backwardSteps(const std::vector<uint32_t> &path, Path &result) const {
+    result.steps.reserve(result.steps.size() + path.size());
+    for (auto a : path) {
+        result.steps.emplace_back(step(arcs_[a], true));
+    }
+}
+
+Step MultiSourceBfs::step(const Arc &arc, bool reverse) const {
+    // The arcs reached backward are stepped over reversely
+    return Step(Vertex(index_->vid(reverse ? arc.src : arc.dst), {}),
+                reverse ? -arc.type : arc.type,
+                names_.at(arc.type),
+                arc.ranking,
+                {});
+}
+
+}  // namespace graph
+}  // namespace nebula
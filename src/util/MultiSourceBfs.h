@@ -0,0 +1,135 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_MULTISOURCEBFS_H_
+#define UTIL_MULTISOURCEBFS_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Path.h"
+#include "util/PathTree.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * A BFS from many starts at once. Each vertex keeps a mask of the starts
+ * reaching it, one bit per start, so a layer is reached from all of them
+ * by walking the arcs once, 64 starts a word.
+ *
+ * Each layer keeps the vertices reached first in it, along with the masks
+ * of the starts reaching them first. No path is kept, the shortest ones
+ * are walked back through the layers only for the vertices asked, see
+ * `paths'.
+ *
+ **************************************************************************/
+class MultiSourceBfs final {
+public:
+    using Id = VidIndex::Id;
+
+    explicit MultiSourceBfs(VidIndex *index) : index_(index) {}
+
+    // Set the starts as the first layer, each once however many times it's given. The bit of
+    // each start is its index in `starts()'. The starts are taken as fetched, so their arcs
+    // must be added before the first `expand'.
+    void setStarts(const std::vector<Id> &ids);
+
+    const std::vector<Id> &starts() const {
+        return starts_;
+    }
+
+    // The words of each mask
+    size_t words() const {
+        return words_;
+    }
+
+    // Add the arc fetched from `src', which is stepped over as an edge of `type'
+    void addArc(Id src, Id dst, EdgeType type, EdgeRanking ranking, const std::string &name);
+
+    // Reach the next layer by the arcs of the latest one. Return the vertices of the new layer
+    // never returned before, which are taken as fetched, so their arcs must be added before
+    // the next call.
+    std::vector<Id> expand();
+
+    size_t layers() const {
+        return layers_.size();
+    }
+
+    const std::vector<Id> &vids(size_t layer) const {
+        DCHECK_LT(layer, layers_.size());
+        return layers_[layer].vids;
+    }
+
+    // The mask of the starts reaching `id' first in `layer', nullptr if none
+    const uint64_t *mask(size_t layer, Id id) const;
+
+    // Append each shortest path from the start of bit `start' to `id' of `layer' to `paths',
+    // as its arcs from `id' back to the start
+    void paths(size_t start, size_t layer, Id id, std::vector<std::vector<uint32_t>> &paths) const;
+
+    // Set the src of `result' to the start of `path', and append its steps
+    void forwardSteps(const std::vector<uint32_t> &path, Path &result) const;
+
+    // Append the steps of `path' reversely, from its end back to the start
+    void backwardSteps(const std::vector<uint32_t> &path, Path &result) const;
+
+    static bool test(const uint64_t *mask, size_t bit) {
+        return (mask[bit / 64] >> (bit % 64)) & 1;
+    }
+
+private:
+    struct Arc {
+        Id              src;
+        Id              dst;
+        EdgeType        type;
+        EdgeRanking     ranking;
+        // The next arc of the same src, and of the same dst, kNone if it's the last one
+        uint32_t        nextOut;
+        uint32_t        nextIn;
+    };
+
+    struct Layer {
+        std::vector<Id>         vids;
+        // The masks of `vids', `words_' each
+        std::vector<uint64_t>   masks;
+        // The index of each vertex in `vids' by its id, kNone if it's not in the layer
+        std::vector<uint32_t>   slots;
+    };
+
+    // The mask of `id' in `layer', added to it if it's not in yet
+    uint64_t *reach(Layer &layer, Id id) const;
+
+    // Add `next' as the latest layer, and return its vertices not fetched yet
+    std::vector<Id> addLayer(Layer &&next);
+
+    void walk(size_t start,
+              size_t layer,
+              Id id,
+              std::vector<uint32_t> &path,
+              std::vector<std::vector<uint32_t>> &paths) const;
+
+    Step step(const Arc &arc, bool reverse) const;
+
+    VidIndex                                   *index_{nullptr};
+    std::vector<Id>                             starts_;
+    size_t                                      words_{0};
+    std::vector<Arc>                            arcs_;
+    // The first arc of each src and of each dst, indexed by their ids
+    std::vector<uint32_t>                       outs_;
+    std::vector<uint32_t>                       ins_;
+    // The vertices returned by `expand' or started from
+    std::vector<bool>                           fetched_;
+    // The starts reaching each vertex so far, `words_' each
+    std::vector<uint64_t>                       seen_;
+    std::vector<Layer>                          layers_;
+    // The edge names by their types
+    std::unordered_map<EdgeType, std::string>   names_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // UTIL_MULTISOURCEBFS_H_
@@ -0,0 +1,113 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/PathTree.h"
+
+namespace nebula {
+namespace graph {
+
+VidIndex::Id VidIndex::insert(const Value &vid) {
+    auto result = ids_.emplace(vid, static_cast<Id>(vids_.size()));
+    if (result.second) {
+        vids_.emplace_back(&result.first->first);
+    }
+    return result.first->second;
+}
+
+VidIndex::Id VidIndex::find(const Value &vid) const {
+    auto found = ids_.find(vid);
+    return found == ids_.end() ? kNone : found->second;
+}
+
+void PathTree::add(const Value &vid, const Edge *edge) {
+    DCHECK_GT(layers_, 0);
+    auto id = index_->insert(vid);
+    auto parent = edge == nullptr ? id : index_->insert(edge->src);
+    if (index_->size() > head_.size()) {
+        head_.resize(index_->size(), VidIndex::kNone);
+        tail_.resize(index_->size(), VidIndex::kNone);
+        lastLayer_.resize(index_->size(), VidIndex::kNone);
+    }
+    auto entry = static_cast<uint32_t>(entries_.size());
+    auto layer = static_cast<uint32_t>(layers_ - 1);
+    entries_.emplace_back(Entry{id, parent, layer, VidIndex::kNone, edge});
+    // Keep the entries of each vertex in the order they're added
+    if (head_[id] == VidIndex::kNone) {
+        head_[id] = entry;
+    } else {
+        entries_[tail_[id]].next = entry;
+    }
+    tail_[id] = entry;
+    if (lastLayer_[id] != layer) {
+        lastLayer_[id] = layer;
+        latestVids_.emplace_back(id);
+    }
+}
+
+std::vector<std::vector<uint32_t>> PathTree::paths(Id id) const {
+    std::vector<std::vector<uint32_t>> paths;
+    if (layers_ == 0) {
+        // Nothing is reached yet, so `id' is the start itself
+        paths.emplace_back();
+        return paths;
+    }
+    std::vector<uint32_t> path;
+    path.reserve(layers_);
+    collect(id, layers_ - 1, path, paths);
+    return paths;
+}
+
+void PathTree::collect(Id id,
+                       uint32_t layer,
+                       std::vector<uint32_t> &path,
+                       std::vector<std::vector<uint32_t>> &paths) const {
+    if (id >= head_.size()) {
+        return;
+    }
+    for (auto i = head_[id]; i != VidIndex::kNone; i = entries_[i].next) {
+        auto &entry = entries_[i];
+        if (entry.layer != layer) {
+            continue;
+        }
+        // `path' is from `id' back to the start by now
+        path.emplace_back(i);
+        if (layer == 0) {
+            paths.emplace_back(path.rbegin(), path.rend());
+        } else {
+            collect(entry.parent, layer - 1, path, paths);
+        }
+        path.pop_back();
+    }
+}
+
+void PathTree::forwardSteps(const std::vector<uint32_t> &path, Path &result) const {
+    DCHECK(!path.empty());
+    // The start is the src of the first edge, or the first vertex itself
+    result.src = Vertex(index_->vid(entries_[path.front()].parent), {});
+    for (auto i : path) {
+        auto &entry = entries_[i];
+        if (entry.edge != nullptr) {
+            auto *edge = entry.edge;
+            result.steps.emplace_back(Step(
+                Vertex(index_->vid(entry.vid), {}), edge->type, edge->name, edge->ranking, {}));
+        }
+    }
+}
+
+void PathTree::backwardSteps(const std::vector<uint32_t> &path, Path &result) const {
+    for (auto i = path.rbegin(); i != path.rend(); ++i) {
+        auto &entry = entries_[*i];
+        if (entry.edge != nullptr) {
+            auto *edge = entry.edge;
+            // The edges were reached backward, step over them reversely
+            result.steps.emplace_back(Step(
+                Vertex(index_->vid(entry.parent), {}), -edge->type, edge->name, edge->ranking, {}));
+        }
+    }
+}
+
+}  // namespace graph
+}  // namespace nebula
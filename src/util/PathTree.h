@@ -0,0 +1,141 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_PATHTREE_H_
+#define UTIL_PATHTREE_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * Map each vid seen by a path search to a dense id once, so the search
+ * keeps its state in flat arrays indexed by the ids, instead of hashing
+ * the vids again and again.
+ *
+ **************************************************************************/
+class VidIndex final {
+public:
+    using Id = uint32_t;
+
+    static constexpr Id kNone = std::numeric_limits<Id>::max();
+
+    // The id of `vid', a new one if it's not seen yet
+    Id insert(const Value &vid);
+
+    // The id of `vid', kNone if it's not seen yet
+    Id find(const Value &vid) const;
+
+    const Value &vid(Id id) const {
+        DCHECK_LT(id, vids_.size());
+        return *vids_[id];
+    }
+
+    size_t size() const {
+        return vids_.size();
+    }
+
+private:
+    std::unordered_map<Value, Id>           ids_;
+    // Point to the keys of `ids_', which never move
+    std::vector<const Value*>               vids_;
+};
+
+/***************************************************************************
+ *
+ * The vertices reached by one side of a BFS, layer by layer, each along
+ * with all the edges it's reached by from the previous layer. The edges
+ * are kept in a flat array and chained per vertex, and they're not copied,
+ * so they must outlive the tree.
+ *
+ * The paths are only built for the vertices asked, see `paths'.
+ *
+ **************************************************************************/
+class PathTree final {
+public:
+    using Id = VidIndex::Id;
+
+    explicit PathTree(VidIndex *index) : index_(index) {}
+
+    // Start the next layer, the first one holds the starts
+    void newLayer() {
+        ++layers_;
+        layerBegin_ = entries_.size();
+        latestVids_.clear();
+    }
+
+    size_t layers() const {
+        return layers_;
+    }
+
+    // `vid' is reached by `edge' in the latest layer, or it's kept from the
+    // previous layer if `edge' is nullptr, e.g. for the starts
+    void add(const Value &vid, const Edge *edge);
+
+    // The vertices reached in the latest layer, in the order they're reached
+    const std::vector<Id> &latestVids() const {
+        return latestVids_;
+    }
+
+    // The number of edges reaching the latest layer
+    size_t latestEdges() const {
+        return entries_.size() - layerBegin_;
+    }
+
+    // Whether `id' is reached in the latest layer
+    bool inLatestLayer(Id id) const {
+        return layers_ > 0 && id < lastLayer_.size() && lastLayer_[id] == layers_ - 1;
+    }
+
+    // The ids of the edges from a start to `id' in the latest layer, one
+    // vector for each path, from the start to `id'. A single empty path if
+    // no layer is added yet.
+    std::vector<std::vector<uint32_t>> paths(Id id) const;
+
+    // Append the steps of `path', from its start to the end, to `result'
+    // whose src is set to the start
+    void forwardSteps(const std::vector<uint32_t> &path, Path &result) const;
+
+    // Append the steps of `path', from its end back to the start, to `result'
+    void backwardSteps(const std::vector<uint32_t> &path, Path &result) const;
+
+private:
+    struct Entry {
+        Id              vid;
+        // The vertex of the previous layer, `vid' itself if `edge' is nullptr
+        Id              parent;
+        uint32_t        layer;
+        // The next entry of the same vertex, kNone if it's the last one
+        uint32_t        next;
+        const Edge     *edge;
+    };
+
+    void collect(Id id,
+                 uint32_t layer,
+                 std::vector<uint32_t> &path,
+                 std::vector<std::vector<uint32_t>> &paths) const;
+
+    VidIndex                               *index_{nullptr};
+    size_t                                  layers_{0};
+    std::vector<Entry>                      entries_;
+    // The first and last entries of each vertex, indexed by its id
+    std::vector<uint32_t>                   head_;
+    std::vector<uint32_t>                   tail_;
+    // The latest layer each vertex is reached in
+    std::vector<uint32_t>                   lastLayer_;
+    size_t                                  layerBegin_{0};
+    std::vector<Id>                         latestVids_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // UTIL_PATHTREE_H_
@@ -0,0 +1,101 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/PathTrie.h"
+
+namespace nebula {
+namespace graph {
+
+uint32_t PathTrie::add(uint32_t parent,
+                       Id src,
+                       Id dst,
+                       EdgeType type,
+                       EdgeRanking ranking,
+                       const Edge *edge) {
+    Node node;
+    node.vid = dst;
+    node.src = src;
+    node.parent = parent;
+    node.type = type;
+    node.ranking = ranking;
+    node.edge = edge;
+    if (parent == kRoot) {
+        node.start = src;
+        node.vertices = bit(src) | bit(dst);
+    } else {
+        auto &prev = nodes_[parent];
+        DCHECK_EQ(prev.vid, src);
+        node.start = prev.start;
+        node.vertices = prev.vertices | bit(dst);
+    }
+    nodes_.emplace_back(std::move(node));
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+bool PathTrie::hasVertex(uint32_t id, Id vid) const {
+    if ((nodes_[id].vertices & bit(vid)) == 0) {
+        return false;
+    }
+    if (nodes_[id].start == vid) {
+        return true;
+    }
+    for (auto i = id; i != kRoot; i = nodes_[i].parent) {
+        if (nodes_[i].vid == vid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PathTrie::hasEdge(uint32_t id, Id src, Id dst, EdgeType type, EdgeRanking ranking) const {
+    // Both ends of an edge on the path are on it
+    auto ends = bit(src) | bit(dst);
+    if ((nodes_[id].vertices & ends) != ends) {
+        return false;
+    }
+    for (auto i = id; i != kRoot; i = nodes_[i].parent) {
+        auto &node = nodes_[i];
+        if (node.ranking != ranking) {
+            continue;
+        }
+        if (node.type == type && node.src == src && node.vid == dst) {
+            return true;
+        }
+        // The same edge stepped over reversely
+        if (node.type == -type && node.src == dst && node.vid == src) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PathTrie::forwardSteps(uint32_t id, Path &result) const {
+    std::vector<uint32_t> path;
+    for (auto i = id; i != kRoot; i = nodes_[i].parent) {
+        path.emplace_back(i);
+    }
+    result.src = Vertex(index_->vid(nodes_[id].start), {});
+    result.steps.reserve(result.steps.size() + path.size());
+    for (auto i = path.rbegin(); i != path.rend(); ++i) {
+        auto &node = nodes_[*i];
+        DCHECK(node.edge != nullptr);
+        result.steps.emplace_back(Step(
+            Vertex(index_->vid(node.vid), {}), node.type, node.edge->name, node.ranking, {}));
+    }
+}
+
+void PathTrie::backwardSteps(uint32_t id, Path &result) const {
+    for (auto i = id; i != kRoot; i = nodes_[i].parent) {
+        auto &node = nodes_[i];
+        DCHECK(node.edge != nullptr);
+        // The edges were reached backward, step over them reversely
+        result.steps.emplace_back(Step(
+            Vertex(index_->vid(node.src), {}), -node.type, node.edge->name, node.ranking, {}));
+    }
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,99 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_PATHTRIE_H_
+#define UTIL_PATHTRIE_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/Path.h"
+#include "util/PathTree.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * The paths found by a search, as a tree of the paths sharing prefixes.
+ * Each path is the path of its parent followed by one edge, so it's kept
+ * in a fixed size node, whatever its length.
+ *
+ * Each node has a bitset of the vertices on its path, hashed by their ids,
+ * so most of the vertices and edges not on the path are told without
+ * walking it.
+ *
+ * The Path values are only built for the paths asked, see `forwardSteps'.
+ *
+ **************************************************************************/
+class PathTrie final {
+public:
+    using Id = VidIndex::Id;
+
+    // The parent of the paths of a single edge
+    static constexpr uint32_t kRoot = VidIndex::kNone;
+
+    struct Node {
+        // The end of the path
+        Id              vid;
+        // The src of the last edge
+        Id              src;
+        // The start of the path
+        Id              start;
+        uint32_t        parent;
+        EdgeType        type;
+        EdgeRanking     ranking;
+        // The vertices on the path, hashed by their ids
+        uint64_t        vertices;
+        // The last edge, only to build the steps
+        const Edge     *edge;
+    };
+
+    explicit PathTrie(VidIndex *index) : index_(index) {}
+
+    // Add the path of `parent' followed by the edge, or the edge alone if `parent' is kRoot,
+    // and return its id. `edge' is kept to build the steps if it's not nullptr, and it must
+    // outlive the trie then.
+    uint32_t add(uint32_t parent,
+                 Id src,
+                 Id dst,
+                 EdgeType type,
+                 EdgeRanking ranking,
+                 const Edge *edge = nullptr);
+
+    const Node &node(uint32_t id) const {
+        DCHECK_LT(id, nodes_.size());
+        return nodes_[id];
+    }
+
+    size_t size() const {
+        return nodes_.size();
+    }
+
+    // Whether `vid' is on the path of `id'
+    bool hasVertex(uint32_t id, Id vid) const;
+
+    // Whether the edge is on the path of `id', either way
+    bool hasEdge(uint32_t id, Id src, Id dst, EdgeType type, EdgeRanking ranking) const;
+
+    // Set the src of `result' to the start of the path of `id', and append its steps
+    void forwardSteps(uint32_t id, Path &result) const;
+
+    // Append the steps of the path of `id' reversely, from its end back to the start
+    void backwardSteps(uint32_t id, Path &result) const;
+
+private:
+    static uint64_t bit(Id vid) {
+        return uint64_t{1} << (vid % 64);
+    }
+
+    VidIndex                               *index_{nullptr};
+    std::vector<Node>                       nodes_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // UTIL_PATHTRIE_H_
@@ -0,0 +1,152 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/RowCache.h"
+
+#include "util/MemoryUtil.h"
+
+namespace nebula {
+namespace graph {
+
+RowCache::RowCache(size_t capacity,
+                   std::chrono::milliseconds ttl,
+                   size_t numShards,
+                   size_t maxBytes)
+    : ttl_(ttl) {
+    numShards = std::max<size_t>(numShards, 1);
+    capacityPerShard_ = std::max<size_t>(capacity / numShards, 1);
+    maxBytesPerShard_ = maxBytes == 0 ? 0 : std::max<size_t>(maxBytes / numShards, 1);
+    shards_.reserve(numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+        shards_.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+std::shared_ptr<const Row> RowCache::get(GraphSpaceID space,
+                                         const Value &vid,
+                                         const std::string &sig,
+                                         ColNames *colNames) {
+    Key key{space, vid};
+    auto &shard = shardOf(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.lock);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            auto &entry = *found->second;
+            auto cached = entry.rows.find(sig);
+            if (cached != entry.rows.end()) {
+                if (ttl_.count() == 0 || Clock::now() < cached->second.expireAt) {
+                    shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+                    if (colNames != nullptr) {
+                        *colNames = cached->second.colNames;
+                    }
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return cached->second.row;
+                }
+                entry.bytes -= cached->second.bytes;
+                shard.bytes -= cached->second.bytes;
+                entry.rows.erase(cached);
+            }
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void RowCache::put(GraphSpaceID space,
+                   const Value &vid,
+                   const std::string &sig,
+                   uint64_t generation,
+                   Row row,
+                   ColNames colNames) {
+    auto bytes = MemoryUtil::estimateSize(row);
+    if (maxBytesPerShard_ != 0 && bytes > maxBytesPerShard_) {
+        // Too large to share the shard with others, e.g. the neighbors of a super vertex
+        return;
+    }
+    Key key{space, vid};
+    auto &shard = shardOf(key);
+    auto expireAt = Clock::now() + ttl_;
+    auto cached = std::make_shared<const Row>(std::move(row));
+    std::lock_guard<std::mutex> lock(shard.lock);
+    if (shard.evicted > generation) {
+        // It may be read before a write evicted since then
+        return;
+    }
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+    } else {
+        shard.lru.emplace_front(Entry{key, {}});
+        shard.index.emplace(std::move(key), shard.lru.begin());
+    }
+    auto &entry = shard.lru.front();
+    auto &slot = entry.rows[sig];
+    entry.bytes += bytes - slot.bytes;
+    shard.bytes += bytes - slot.bytes;
+    slot = Cached{std::move(cached), std::move(colNames), expireAt, bytes};
+    // Drop the least recently used ones, but never the one just put
+    while (shard.lru.size() > 1 &&
+           (shard.lru.size() > capacityPerShard_ ||
+            (maxBytesPerShard_ != 0 && shard.bytes > maxBytesPerShard_))) {
+        shard.bytes -= shard.lru.back().bytes;
+        shard.index.erase(shard.lru.back().key);
+        shard.lru.pop_back();
+    }
+}
+
+void RowCache::evict(GraphSpaceID space, const Value &vid) {
+    Key key{space, vid};
+    auto &shard = shardOf(key);
+    auto generation = generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.evicted = std::max(shard.evicted, generation);
+    auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        return;
+    }
+    shard.bytes -= found->second->bytes;
+    shard.lru.erase(found->second);
+    shard.index.erase(found);
+}
+
+void RowCache::evictSpace(GraphSpaceID space) {
+    auto generation = generation_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->lock);
+        shard->evicted = std::max(shard->evicted, generation);
+        for (auto it = shard->lru.begin(); it != shard->lru.end();) {
+            if (it->key.space != space) {
+                ++it;
+                continue;
+            }
+            shard->bytes -= it->bytes;
+            shard->index.erase(it->key);
+            it = shard->lru.erase(it);
+        }
+    }
+}
+
+size_t RowCache::size() const {
+    size_t size = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->lock);
+        size += shard->lru.size();
+    }
+    return size;
+}
+
+size_t RowCache::bytes() const {
+    size_t bytes = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->lock);
+        bytes += shard->bytes;
+    }
+    return bytes;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,161 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_ROWCACHE_H_
+#define UTIL_ROWCACHE_H_
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+#include "common/datatypes/DataSet.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * A bounded cache of the rows returned by storage for each vertex. The rows
+ * are keyed by the space, the vertex id and the signature of the request,
+ * e.g. the tags and props fetched, since the same vertex is fetched with
+ * different props by different plans. The column names of the rows could
+ * be kept along with them, e.g. for the neighbors, whose columns are only
+ * known from the response.
+ *
+ * All the rows of a vertex are evicted together when it's written by this
+ * graph service. The writes made elsewhere are only seen after the rows
+ * expire, which is `ttl' after they are put. Each eviction starts a new
+ * generation, and the rows fetched in an older generation than the latest
+ * eviction of their shard are not put, so a row read before a write never
+ * outlives the eviction of the write. A write touching the rows of unknown
+ * vertices, e.g. deleting a vertex along with all its edges, evicts the
+ * whole space.
+ *
+ * The vertices are split into shards by id, and each shard is an LRU list
+ * guarded by its own lock. The least recently used vertices are dropped
+ * when a shard holds more vertices or more bytes of rows than its share.
+ * All the methods are thread-safe.
+ *
+ **************************************************************************/
+class RowCache final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    static constexpr size_t kDefaultShards = 16;
+
+    // The column names of a row, shared by all the rows of the same response
+    using ColNames = std::shared_ptr<const std::vector<std::string>>;
+
+    // Keep at most `capacity' vertices, and at most `maxBytes' of rows unless it's zero.
+    // The rows never expire if `ttl' is zero.
+    RowCache(size_t capacity,
+             std::chrono::milliseconds ttl,
+             size_t numShards = kDefaultShards,
+             size_t maxBytes = 0);
+
+    // The current generation, to be taken before fetching the rows to put
+    uint64_t generation() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    // The row of vertex, and its column names to `colNames' if it's not nullptr. Return
+    // nullptr if not cached or expired. The row is shared with the cache and never modified.
+    std::shared_ptr<const Row> get(GraphSpaceID space,
+                                   const Value &vid,
+                                   const std::string &sig,
+                                   ColNames *colNames = nullptr);
+
+    // Put the row fetched after `generation' is taken, it's dropped if any vertex of the
+    // same shard is evicted since then
+    void put(GraphSpaceID space,
+             const Value &vid,
+             const std::string &sig,
+             uint64_t generation,
+             Row row,
+             ColNames colNames = nullptr);
+
+    // Drop all the rows of vertex, and the ones being fetched
+    void evict(GraphSpaceID space, const Value &vid);
+
+    // Drop all the rows of the vertices in space, and the ones being fetched
+    void evictSpace(GraphSpaceID space);
+
+    // The number of vertices cached
+    size_t size() const;
+
+    // The estimated bytes of the rows cached
+    size_t bytes() const;
+
+    uint64_t hits() const {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Key {
+        GraphSpaceID space;
+        Value vid;
+
+        bool operator==(const Key &rhs) const {
+            return space == rhs.space && vid == rhs.vid;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const {
+            return std::hash<Value>()(key.vid) ^ std::hash<GraphSpaceID>()(key.space);
+        }
+    };
+
+    struct Cached {
+        std::shared_ptr<const Row> row;
+        ColNames colNames;
+        Clock::time_point expireAt;
+        size_t bytes{0};
+    };
+
+    struct Entry {
+        Key key;
+        // signature -> row
+        std::unordered_map<std::string, Cached> rows;
+        size_t bytes{0};
+    };
+
+    struct Shard {
+        mutable std::mutex lock;
+        // The most recently used vertex is at front
+        std::list<Entry> lru;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+        // The generation of the latest eviction
+        uint64_t evicted{0};
+        size_t bytes{0};
+    };
+
+    Shard &shardOf(const Key &key) {
+        return *shards_[KeyHash()(key) % shards_.size()];
+    }
+
+    size_t capacityPerShard_;
+    // Zero if the bytes are not limited
+    size_t maxBytesPerShard_;
+    std::chrono::milliseconds ttl_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_ROWCACHE_H_
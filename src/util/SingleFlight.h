@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_SINGLEFLIGHT_H_
+#define UTIL_SINGLEFLIGHT_H_
+
+#include <atomic>
+#include <mutex>
+
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+#include "common/base/Base.h"
+#include "common/cpp/helpers.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * Coalesce the identical calls in flight. The first call of a key is made,
+ * and the others of the same key made before it completes wait for it and
+ * share a copy of its result. Once completed, the next call of that key is
+ * made again, so nothing is cached beyond the flight.
+ *
+ * It's thread-safe, and the result type must be copyable.
+ *
+ **************************************************************************/
+template <typename T>
+class SingleFlight final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    // Make the call of `fn' for `key', or join the one in flight. `joined' is set to
+    // whether it's joined if it's not nullptr.
+    template <typename Fn>
+    folly::SemiFuture<T> call(const std::string &key, Fn &&fn, bool *joined = nullptr) {
+        std::shared_ptr<folly::SharedPromise<T>> promise;
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            auto found = calls_.find(key);
+            if (found != calls_.end()) {
+                numJoined_.fetch_add(1, std::memory_order_relaxed);
+                if (joined != nullptr) {
+                    *joined = true;
+                }
+                return found->second->getSemiFuture();
+            }
+            promise = std::make_shared<folly::SharedPromise<T>>();
+            calls_.emplace(key, promise);
+        }
+        if (joined != nullptr) {
+            *joined = false;
+        }
+        auto future = promise->getSemiFuture();
+        folly::makeFutureWith(std::forward<Fn>(fn))
+            .thenTry([this, key, promise](folly::Try<T> &&result) {
+                {
+                    std::lock_guard<std::mutex> lock(lock_);
+                    calls_.erase(key);
+                }
+                promise->setTry(std::move(result));
+            });
+        return future;
+    }
+
+    // The number of calls in flight
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(lock_);
+        return calls_.size();
+    }
+
+    // The number of calls which joined others
+    uint64_t numJoined() const {
+        return numJoined_.load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable std::mutex lock_;
+    std::unordered_map<std::string, std::shared_ptr<folly::SharedPromise<T>>> calls_;
+    std::atomic<uint64_t> numJoined_{0};
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_SINGLEFLIGHT_H_
@@ -0,0 +1,105 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/SpillFile.h"
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <unistd.h>
+
+#include "common/interface/gen-cpp2/common_types.h"
+
+namespace nebula {
+namespace graph {
+
+// static
+StatusOr<std::unique_ptr<SpillFile>> SpillFile::create(const std::string &dir) {
+    auto path = folly::stringPrintf("%s/nebula-graphd-spill-XXXXXX", dir.c_str());
+    int fd = ::mkstemp(&path[0]);
+    if (fd < 0) {
+        return Status::Error("Create spill file in `%s' failed: %s",
+                             dir.c_str(), ::strerror(errno));
+    }
+    ::unlink(path.c_str());
+    auto *file = ::fdopen(fd, "w+b");
+    if (file == nullptr) {
+        ::close(fd);
+        return Status::Error("Open spill file failed: %s", ::strerror(errno));
+    }
+    return std::unique_ptr<SpillFile>(new SpillFile(file));
+}
+
+SpillFile::~SpillFile() {
+    if (file_ != nullptr) {
+        ::fclose(file_);
+    }
+}
+
+Status SpillFile::write(const Row &row) {
+    buffer_.clear();
+    apache::thrift::CompactSerializer::serialize(row, &buffer_);
+    // Each row is stored as | length : uint32 | serialized row |
+    auto len = static_cast<uint32_t>(buffer_.size());
+    if (::fwrite(&len, sizeof(len), 1, file_) != 1 ||
+        ::fwrite(buffer_.data(), 1, len, file_) != len) {
+        return Status::Error("Write spill file failed: %s", ::strerror(errno));
+    }
+    numRows_++;
+    bytes_ += sizeof(len) + len;
+    return Status::OK();
+}
+
+Status SpillFile::flush() {
+    if (::fflush(file_) != 0) {
+        return Status::Error("Flush spill file failed: %s", ::strerror(errno));
+    }
+    return Status::OK();
+}
+
+StatusOr<bool> SpillFile::Reader::read(Row *row) {
+    if (offset_ >= end_) {
+        return false;
+    }
+    uint32_t len = 0;
+    NG_RETURN_IF_ERROR(fill(sizeof(len)));
+    ::memcpy(&len, &buffer_[offset_ - bufOffset_], sizeof(len));
+    offset_ += sizeof(len);
+    NG_RETURN_IF_ERROR(fill(len));
+    row->values.clear();
+    apache::thrift::CompactSerializer::deserialize(
+        folly::StringPiece(&buffer_[offset_ - bufOffset_], len), *row);
+    offset_ += len;
+    return true;
+}
+
+Status SpillFile::Reader::fill(size_t size) {
+    if (offset_ + size > end_) {
+        return Status::Error("Read spill file failed: truncated row");
+    }
+    if (offset_ + size <= bufOffset_ + buffer_.size()) {
+        return Status::OK();
+    }
+    // Read on from the current offset by the positional reads, which don't move the
+    // offset of the file shared by the readers
+    auto fd = ::fileno(file_->file_);
+    buffer_.resize(std::min(std::max(size, kBufferSize), end_ - offset_));
+    bufOffset_ = offset_;
+    size_t done = 0;
+    while (done < buffer_.size()) {
+        auto n = ::pread(fd, &buffer_[done], buffer_.size() - done, offset_ + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return Status::Error("Read spill file failed: %s",
+                                 n < 0 ? ::strerror(errno) : "truncated row");
+        }
+        done += static_cast<size_t>(n);
+    }
+    return Status::OK();
+}
+
+}  // namespace graph
+}  // namespace nebula
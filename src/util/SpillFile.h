@@ -0,0 +1,85 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_SPILLFILE_H_
+#define UTIL_SPILLFILE_H_
+
+#include <cstdio>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/cpp/helpers.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+// A local temporary file to spill rows out of memory. The rows are appended, and read back
+// in the order they are written by the ranges of their offsets, see `Reader'. The file is
+// unlinked as soon as it's created, so it's released automatically when closed, even if the
+// process crashes.
+class SpillFile final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    // Read the rows in the offsets [begin, end) of a flushed file. Each reader keeps its own
+    // position and buffer, so many readers could read one file at the same time.
+    class Reader final {
+    public:
+        Reader(const SpillFile *file, size_t begin, size_t end)
+            : file_(file), offset_(begin), end_(end) {}
+
+        // Read the next row into `row', return false if all rows have been read
+        StatusOr<bool> read(Row *row);
+
+    private:
+        // Make sure the `size' bytes from the current offset are in the buffer
+        Status fill(size_t size);
+
+        static constexpr size_t kBufferSize = 16 * 1024;
+
+        const SpillFile    *file_{nullptr};
+        // The file offset of the next row, and of the first byte of the buffer
+        size_t              offset_{0};
+        size_t              bufOffset_{0};
+        size_t              end_{0};
+        std::string         buffer_;
+    };
+
+    // Create an anonymous spill file under `dir'
+    static StatusOr<std::unique_ptr<SpillFile>> create(const std::string &dir);
+
+    ~SpillFile();
+
+    Status write(const Row &row);
+
+    // Flush the rows written so far, so they could be read
+    Status flush();
+
+    // Read all the rows written so far
+    Reader reader() const {
+        return Reader(this, 0, bytes_);
+    }
+
+    size_t numRows() const {
+        return numRows_;
+    }
+
+    // Also the offset of the next row written
+    size_t bytes() const {
+        return bytes_;
+    }
+
+private:
+    explicit SpillFile(FILE *file) : file_(file) {}
+
+    FILE           *file_{nullptr};
+    size_t          numRows_{0};
+    size_t          bytes_{0};
+    std::string     buffer_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // UTIL_SPILLFILE_H_
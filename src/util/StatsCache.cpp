@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/StatsCache.h"
+
+namespace nebula {
+namespace graph {
+
+StatsCache::StatsCache(meta::MetaClient *metaClient, std::chrono::seconds ttl)
+    : metaClient_(metaClient), ttl_(ttl), entries_(std::make_shared<Entries>()) {}
+
+std::shared_ptr<const StatsCache::Stats> StatsCache::get(GraphSpaceID space) {
+    std::shared_ptr<const Stats> stats;
+    {
+        std::lock_guard<std::mutex> lock(entries_->lock);
+        auto &entry = entries_->entries[space];
+        stats = entry.stats;
+        bool stale = entry.fetchedAt == Clock::time_point() ||
+                     Clock::now() - entry.fetchedAt > ttl_;
+        if (metaClient_ == nullptr || entry.fetching || !stale) {
+            return stats;
+        }
+        entry.fetching = true;
+    }
+    fetch(space);
+    return stats;
+}
+
+void StatsCache::put(GraphSpaceID space, const meta::cpp2::StatisItem &item) {
+    put(*entries_, space, item);
+}
+
+// static
+void StatsCache::put(Entries &entries, GraphSpaceID space, const meta::cpp2::StatisItem &item) {
+    auto stats = std::make_shared<Stats>();
+    stats->vertices = item.space_vertices;
+    stats->edges = item.space_edges;
+    for (auto &tag : item.get_tag_vertices()) {
+        stats->tagVertices.emplace(tag.first, tag.second);
+    }
+    for (auto &edge : item.get_edges()) {
+        stats->edgeCounts.emplace(edge.first, edge.second);
+    }
+    std::lock_guard<std::mutex> lock(entries.lock);
+    auto &entry = entries.entries[space];
+    entry.stats = std::move(stats);
+    entry.fetchedAt = Clock::now();
+}
+
+void StatsCache::fetch(GraphSpaceID space) {
+    std::weak_ptr<Entries> weak = entries_;
+    metaClient_->getStatis(space).thenTry(
+        [weak, space](folly::Try<StatusOr<meta::cpp2::StatisItem>> &&resp) {
+            auto entries = weak.lock();
+            if (entries == nullptr) {
+                // The cache is destroyed
+                return;
+            }
+            if (resp.hasValue() && resp.value().ok()) {
+                put(*entries, space, resp.value().value());
+            } else {
+                // Probably no STATS job is done, try again after `ttl'
+                VLOG(1) << "Failed to fetch the stats of space " << space;
+            }
+            std::lock_guard<std::mutex> lock(entries->lock);
+            auto &entry = entries->entries[space];
+            entry.fetching = false;
+            entry.fetchedAt = Clock::now();
+        });
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,79 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_STATSCACHE_H_
+#define UTIL_STATSCACHE_H_
+
+#include <chrono>
+#include <mutex>
+
+#include "common/base/Base.h"
+#include "common/clients/meta/MetaClient.h"
+#include "common/cpp/helpers.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * The number of vertices of each tag and edges of each edge type in the
+ * spaces, counted by the last STATS job, which the optimizer and planners
+ * estimate the rows of plans by.
+ *
+ * The stats are fetched from meta in the background, so planning never
+ * waits for them. They're missing until fetched the first time, and
+ * fetched again `ttl' after that. The fetches in flight only hold the
+ * entries weakly, so the cache could be destroyed before they're done.
+ *
+ * All the methods are thread-safe.
+ *
+ **************************************************************************/
+class StatsCache final : private cpp::NonCopyable, private cpp::NonMovable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        int64_t                                     vertices{0};
+        int64_t                                     edges{0};
+        std::unordered_map<std::string, int64_t>    tagVertices;
+        std::unordered_map<std::string, int64_t>    edgeCounts;
+    };
+
+    // The stats are only put by `put' if `metaClient' is nullptr
+    StatsCache(meta::MetaClient *metaClient, std::chrono::seconds ttl);
+
+    // The stats of `space', nullptr if they're not fetched yet or no STATS job is done
+    std::shared_ptr<const Stats> get(GraphSpaceID space);
+
+    // Put the stats fetched, e.g. by SHOW STATS
+    void put(GraphSpaceID space, const meta::cpp2::StatisItem &item);
+
+private:
+    struct Entry {
+        std::shared_ptr<const Stats>    stats;
+        Clock::time_point               fetchedAt;
+        bool                            fetching{false};
+    };
+
+    struct Entries {
+        std::mutex                                  lock;
+        std::unordered_map<GraphSpaceID, Entry>     entries;
+    };
+
+    void fetch(GraphSpaceID space);
+
+    static void put(Entries &entries, GraphSpaceID space, const meta::cpp2::StatisItem &item);
+
+    meta::MetaClient                               *metaClient_{nullptr};
+    std::chrono::seconds                            ttl_;
+    std::shared_ptr<Entries>                        entries_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_STATSCACHE_H_
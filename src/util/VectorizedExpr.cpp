@@ -0,0 +1,320 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VectorizedExpr.h"
+
+#include <limits>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "context/QueryExpressionContext.h"
+#include "util/ExprKernels.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+bool isNumeric(Column::Type type) {
+    return type == Column::Type::kInt || type == Column::Type::kFloat;
+}
+
+double toFloat(const Column &column, size_t i) {
+    return column.type() == Column::Type::kInt ? static_cast<double>(column.getInt(i))
+                                               : column.getFloat(i);
+}
+
+}   // namespace
+
+// static
+std::unique_ptr<VectorizedExpr> VectorizedExpr::make(
+    Expression *expr,
+    const std::unordered_map<std::string, size_t> &colIndices) {
+    auto root = build(expr, colIndices);
+    if (root->kind == NodeKind::kRow) {
+        return nullptr;
+    }
+    return std::unique_ptr<VectorizedExpr>(new VectorizedExpr(std::move(root)));
+}
+
+// static
+std::unique_ptr<VectorizedExpr::Node> VectorizedExpr::build(
+    Expression *expr,
+    const std::unordered_map<std::string, size_t> &colIndices) {
+    auto node = std::make_unique<Node>();
+    node->expr = expr;
+    node->kind = NodeKind::kRow;
+    switch (expr->kind()) {
+        case Expression::Kind::kInputProperty:
+        case Expression::Kind::kVarProperty: {
+            // Both of them are read from the current row of input in row mode
+            auto *prop = static_cast<PropertyExpression *>(expr)->prop();
+            auto found = colIndices.find(*prop);
+            if (found != colIndices.end()) {
+                node->kind = NodeKind::kColumn;
+                node->colIdx = found->second;
+            }
+            break;
+        }
+        case Expression::Kind::kConstant: {
+            node->kind = NodeKind::kConstant;
+            break;
+        }
+        case Expression::Kind::kAdd:
+        case Expression::Kind::kMinus:
+        case Expression::Kind::kMultiply:
+        case Expression::Kind::kDivision:
+        case Expression::Kind::kMod: {
+            auto *arith = static_cast<ArithmeticExpression *>(expr);
+            node->kind = NodeKind::kArithmetic;
+            node->children.emplace_back(build(arith->left(), colIndices));
+            node->children.emplace_back(build(arith->right(), colIndices));
+            break;
+        }
+        case Expression::Kind::kRelEQ:
+        case Expression::Kind::kRelNE:
+        case Expression::Kind::kRelLT:
+        case Expression::Kind::kRelLE:
+        case Expression::Kind::kRelGT:
+        case Expression::Kind::kRelGE: {
+            auto *rel = static_cast<RelationalExpression *>(expr);
+            node->kind = NodeKind::kRelational;
+            node->children.emplace_back(build(rel->left(), colIndices));
+            node->children.emplace_back(build(rel->right(), colIndices));
+            break;
+        }
+        case Expression::Kind::kLogicalAnd:
+        case Expression::Kind::kLogicalOr: {
+            node->kind = NodeKind::kLogical;
+            for (auto &operand : static_cast<LogicalExpression *>(expr)->operands()) {
+                node->children.emplace_back(build(operand.get(), colIndices));
+            }
+            break;
+        }
+        case Expression::Kind::kUnaryNot:
+        case Expression::Kind::kUnaryNegate: {
+            node->kind = expr->kind() == Expression::Kind::kUnaryNot ? NodeKind::kNot
+                                                                     : NodeKind::kNegate;
+            node->children.emplace_back(
+                build(static_cast<UnaryExpression *>(expr)->operand(), colIndices));
+            break;
+        }
+        default:
+            break;
+    }
+    return node;
+}
+
+Column VectorizedExpr::eval(ColumnBatch *batch, QueryExpressionContext &ctx) const {
+    return eval(*root_, batch, ctx);
+}
+
+Column VectorizedExpr::eval(const Node &node,
+                            ColumnBatch *batch,
+                            QueryExpressionContext &ctx) const {
+    switch (node.kind) {
+        case NodeKind::kColumn:
+            return batch->column(node.colIdx);
+        case NodeKind::kConstant: {
+            auto &val = static_cast<ConstantExpression *>(node.expr)->value();
+            Column column(Column::typeOf(val.type()), batch->size());
+            for (size_t i = 0; i < batch->size(); ++i) {
+                column.setRef(i, val);
+            }
+            return column;
+        }
+        case NodeKind::kArithmetic:
+            return evalArithmetic(node, batch, ctx);
+        case NodeKind::kRelational:
+            return evalRelational(node, batch, ctx);
+        case NodeKind::kLogical:
+            return evalLogical(node, batch, ctx);
+        case NodeKind::kNot:
+        case NodeKind::kNegate:
+            return evalUnary(node, batch, ctx);
+        case NodeKind::kRow:
+            return evalRows(node, batch, ctx);
+    }
+    return evalRows(node, batch, ctx);
+}
+
+Column VectorizedExpr::evalArithmetic(const Node &node,
+                                      ColumnBatch *batch,
+                                      QueryExpressionContext &ctx) const {
+    auto lhs = eval(*node.children[0], batch, ctx);
+    auto rhs = eval(*node.children[1], batch, ctx);
+    auto kind = node.expr->kind();
+    auto size = batch->size();
+    if (lhs.type() == Column::Type::kInt && rhs.type() == Column::Type::kInt) {
+        Column result(Column::Type::kInt, size);
+        for (size_t i = 0; i < size; ++i) {
+            int64_t val;
+            if (!lhs.isNull(i) && !rhs.isNull(i) &&
+                ExprKernels::arithInt(kind, lhs.getInt(i), rhs.getInt(i), &val)) {
+                result.setInt(i, val);
+            } else {
+                result.set(i, evalRow(node, batch, i, ctx));
+            }
+        }
+        return result;
+    }
+    if (isNumeric(lhs.type()) && isNumeric(rhs.type())) {
+        // At least one of them is float, the result is float
+        Column result(Column::Type::kFloat, size);
+        for (size_t i = 0; i < size; ++i) {
+            double val;
+            if (!lhs.isNull(i) && !rhs.isNull(i) &&
+                ExprKernels::arithFloat(kind, toFloat(lhs, i), toFloat(rhs, i), &val)) {
+                result.setFloat(i, val);
+            } else {
+                result.set(i, evalRow(node, batch, i, ctx));
+            }
+        }
+        return result;
+    }
+    return evalRows(node, batch, ctx);
+}
+
+Column VectorizedExpr::evalRelational(const Node &node,
+                                      ColumnBatch *batch,
+                                      QueryExpressionContext &ctx) const {
+    auto lhs = eval(*node.children[0], batch, ctx);
+    auto rhs = eval(*node.children[1], batch, ctx);
+    auto kind = node.expr->kind();
+    auto size = batch->size();
+    auto type = lhs.type();
+    bool equality = kind == Expression::Kind::kRelEQ || kind == Expression::Kind::kRelNE;
+    // Only compare the values of the same type, and bool values only for equality. The float
+    // values are compared by the original expression, which has its own precision.
+    bool supported = type == rhs.type() && type != Column::Type::kValue &&
+                     type != Column::Type::kFloat && (type != Column::Type::kBool || equality);
+    Column result(Column::Type::kBool, size);
+    for (size_t i = 0; i < size; ++i) {
+        if (!supported || lhs.isNull(i) || rhs.isNull(i)) {
+            result.set(i, evalRow(node, batch, i, ctx));
+            continue;
+        }
+        switch (type) {
+            case Column::Type::kInt:
+                result.setBool(i, ExprKernels::compare(kind, lhs.getInt(i), rhs.getInt(i)));
+                break;
+            case Column::Type::kBool:
+                result.setBool(i, ExprKernels::compare(kind, lhs.getBool(i), rhs.getBool(i)));
+                break;
+            case Column::Type::kString:
+                result.setBool(i, ExprKernels::compare(kind, lhs.getStr(i), rhs.getStr(i)));
+                break;
+            case Column::Type::kFloat:
+            case Column::Type::kValue:
+                break;
+        }
+    }
+    return result;
+}
+
+Column VectorizedExpr::evalLogical(const Node &node,
+                                   ColumnBatch *batch,
+                                   QueryExpressionContext &ctx) const {
+    std::vector<Column> operands;
+    operands.reserve(node.children.size());
+    for (auto &child : node.children) {
+        operands.emplace_back(eval(*child, batch, ctx));
+    }
+    bool isAnd = node.expr->kind() == Expression::Kind::kLogicalAnd;
+    auto size = batch->size();
+    Column result(Column::Type::kBool, size);
+    for (size_t i = 0; i < size; ++i) {
+        bool allBool = true;
+        bool val = isAnd;
+        for (auto &operand : operands) {
+            if (operand.type() != Column::Type::kBool || operand.isNull(i)) {
+                allBool = false;
+                break;
+            }
+            val = isAnd ? (val && operand.getBool(i)) : (val || operand.getBool(i));
+        }
+        if (allBool) {
+            result.setBool(i, val);
+        } else {
+            // NULL and EMPTY follow the three-valued logic of row mode
+            result.set(i, evalRow(node, batch, i, ctx));
+        }
+    }
+    return result;
+}
+
+Column VectorizedExpr::evalUnary(const Node &node,
+                                 ColumnBatch *batch,
+                                 QueryExpressionContext &ctx) const {
+    auto operand = eval(*node.children[0], batch, ctx);
+    auto size = batch->size();
+    auto type = operand.type();
+    if (node.kind == NodeKind::kNot && type == Column::Type::kBool) {
+        Column result(Column::Type::kBool, size);
+        for (size_t i = 0; i < size; ++i) {
+            if (operand.isNull(i)) {
+                result.set(i, evalRow(node, batch, i, ctx));
+            } else {
+                result.setBool(i, !operand.getBool(i));
+            }
+        }
+        return result;
+    }
+    if (node.kind == NodeKind::kNegate && isNumeric(type)) {
+        Column result(type, size);
+        for (size_t i = 0; i < size; ++i) {
+            if (operand.isNull(i) || (type == Column::Type::kInt &&
+                                      operand.getInt(i) == std::numeric_limits<int64_t>::min())) {
+                result.set(i, evalRow(node, batch, i, ctx));
+            } else if (type == Column::Type::kInt) {
+                result.setInt(i, -operand.getInt(i));
+            } else {
+                result.setFloat(i, -operand.getFloat(i));
+            }
+        }
+        return result;
+    }
+    return evalRows(node, batch, ctx);
+}
+
+Value VectorizedExpr::evalRow(const Node &node,
+                              ColumnBatch *batch,
+                              size_t i,
+                              QueryExpressionContext &ctx) const {
+    return node.expr->eval(ctx(batch->rowAt(i)));
+}
+
+Column VectorizedExpr::evalRows(const Node &node,
+                                ColumnBatch *batch,
+                                QueryExpressionContext &ctx) const {
+    auto size = batch->size();
+    std::vector<Value> values;
+    values.reserve(size);
+    auto type = Column::Type::kValue;
+    for (size_t i = 0; i < size; ++i) {
+        values.emplace_back(evalRow(node, batch, i, ctx));
+        auto &val = values.back();
+        if (type == Column::Type::kValue && !val.isNull() && !val.empty()) {
+            type = Column::typeOf(val.type());
+        }
+    }
+    // The string column can't own the strings, so keep them as values
+    if (type == Column::Type::kString) {
+        type = Column::Type::kValue;
+    }
+    Column column(type, size);
+    for (size_t i = 0; i < size; ++i) {
+        column.set(i, std::move(values[i]));
+    }
+    return column;
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,95 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_VECTORIZEDEXPR_H_
+#define UTIL_VECTORIZEDEXPR_H_
+
+#include "common/base/Base.h"
+#include "common/expression/Expression.h"
+#include "context/ColumnBatch.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryExpressionContext;
+
+/***************************************************************************
+ *
+ * Evaluate an expression on a batch of rows column by column. The input
+ * properties, constants, arithmetic, comparison and logical operations are
+ * computed by typed kernels, other sub-expressions are evaluated row by row.
+ *
+ * A kernel only handles the values of the same numeric, string or bool type.
+ * For the others, e.g. NULL operands, overflow or dividing by zero, it
+ * evaluates the original expression on that row, so the results are always
+ * the same as the row mode.
+ *
+ * Like the expression it's made from, it's not thread-safe.
+ *
+ **************************************************************************/
+class VectorizedExpr final {
+public:
+    // Number of rows evaluated at one time
+    static constexpr size_t kBatchSize = 1024;
+
+    // Return nullptr if there is no kernel for `expr' on the input with `colIndices',
+    // it should be evaluated row by row then.
+    static std::unique_ptr<VectorizedExpr> make(
+        Expression *expr,
+        const std::unordered_map<std::string, size_t> &colIndices);
+
+    Column eval(ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+private:
+    enum class NodeKind : uint8_t {
+        kColumn,
+        kConstant,
+        kArithmetic,
+        kRelational,
+        kLogical,
+        kNot,
+        kNegate,
+        // Evaluated row by row
+        kRow,
+    };
+
+    struct Node {
+        NodeKind kind;
+        Expression *expr;
+        size_t colIdx{0};
+        std::vector<std::unique_ptr<Node>> children;
+    };
+
+    explicit VectorizedExpr(std::unique_ptr<Node> root) : root_(std::move(root)) {}
+
+    static std::unique_ptr<Node> build(Expression *expr,
+                                       const std::unordered_map<std::string, size_t> &colIndices);
+
+    Column eval(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    Column evalArithmetic(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    Column evalRelational(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    Column evalLogical(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    Column evalUnary(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    // Evaluate the expression of `node' on the `i'th row in row mode
+    Value evalRow(const Node &node,
+                  ColumnBatch *batch,
+                  size_t i,
+                  QueryExpressionContext &ctx) const;
+
+    Column evalRows(const Node &node, ColumnBatch *batch, QueryExpressionContext &ctx) const;
+
+    std::unique_ptr<Node> root_;
+};
+
+}   // namespace graph
+}   // namespace nebula
+
+#endif   // UTIL_VECTORIZEDEXPR_H_
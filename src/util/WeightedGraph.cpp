@@ -0,0 +1,117 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/WeightedGraph.h"
+
+#include <queue>
+
+namespace nebula {
+namespace graph {
+
+void WeightedGraph::addArc(Id src,
+                           Id dst,
+                           EdgeType type,
+                           EdgeRanking ranking,
+                           const std::string &name,
+                           double weight) {
+    DCHECK_GE(weight, 0.0);
+    if (!keys_.emplace(ArcKey{src, dst, type, ranking}).second) {
+        return;
+    }
+    if (index_->size() > head_.size()) {
+        head_.resize(index_->size(), VidIndex::kNone);
+    }
+    names_.emplace(type, name);
+    arcs_.emplace_back(Arc{dst, type, ranking, weight, head_[src]});
+    head_[src] = static_cast<uint32_t>(arcs_.size() - 1);
+}
+
+std::vector<std::pair<Path, double>> WeightedGraph::shortestPaths(Id src,
+                                                                  const std::vector<Id> &dsts,
+                                                                  size_t maxSteps) const {
+    std::vector<std::pair<Path, double>> paths;
+    // The label each dst is reached by, kNone if it's not reached yet
+    std::unordered_map<Id, uint32_t> found;
+    for (auto dst : dsts) {
+        if (dst != src) {
+            found.emplace(dst, VidIndex::kNone);
+        }
+    }
+    auto left = found.size();
+
+    // The fewest steps each vertex is settled by
+    std::vector<uint32_t> settled(index_->size(), std::numeric_limits<uint32_t>::max());
+    std::vector<Label> labels;
+    labels.emplace_back(Label{src, 0, VidIndex::kNone, VidIndex::kNone, 0.0});
+    // Pop the lightest label first, then the one of fewer steps
+    using Entry = std::tuple<double, uint32_t, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    heap.emplace(0.0, 0, 0);
+    while (!heap.empty() && left > 0) {
+        auto weight = std::get<0>(heap.top());
+        auto label = std::get<2>(heap.top());
+        heap.pop();
+        auto vid = labels[label].vid;
+        auto steps = labels[label].steps;
+        if (steps >= settled[vid]) {
+            // The vertex is settled by as few steps already, and not heavier
+            continue;
+        }
+        // A dst is reached by the lightest path when it's settled first
+        auto target = settled[vid] == std::numeric_limits<uint32_t>::max() ? found.find(vid)
+                                                                             : found.end();
+        settled[vid] = steps;
+        if (target != found.end()) {
+            target->second = label;
+            --left;
+        }
+        if (steps >= maxSteps || vid >= head_.size()) {
+            continue;
+        }
+        for (auto i = head_[vid]; i != VidIndex::kNone; i = arcs_[i].next) {
+            auto &arc = arcs_[i];
+            if (steps + 1 >= settled[arc.dst]) {
+                continue;
+            }
+            labels.emplace_back(Label{arc.dst, steps + 1, label, i, weight + arc.weight});
+            heap.emplace(weight + arc.weight, steps + 1, labels.size() - 1);
+        }
+    }
+
+    for (auto dst : dsts) {
+        auto reached = found.find(dst);
+        if (reached == found.end() || reached->second == VidIndex::kNone) {
+            continue;
+        }
+        auto &label = labels[reached->second];
+        paths.emplace_back(buildPath(src, labels, reached->second), label.weight);
+        // Once for each dst however many times it's given
+        reached->second = VidIndex::kNone;
+    }
+    return paths;
+}
+
+Path WeightedGraph::buildPath(Id src, const std::vector<Label> &labels, uint32_t label) const {
+    std::vector<uint32_t> chain;
+    for (auto i = label; labels[i].parent != VidIndex::kNone; i = labels[i].parent) {
+        chain.emplace_back(i);
+    }
+    Path path;
+    path.src = Vertex(index_->vid(src), {});
+    path.steps.reserve(chain.size());
+    for (auto i = chain.rbegin(); i != chain.rend(); ++i) {
+        auto &arc = arcs_[labels[*i].arc];
+        path.steps.emplace_back(Step(Vertex(index_->vid(arc.dst), {}),
+                                     arc.type,
+                                     names_.at(arc.type),
+                                     arc.ranking,
+                                     {}));
+    }
+    return path;
+}
+
+}  // namespace graph
+}  // namespace nebula
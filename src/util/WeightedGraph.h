@@ -0,0 +1,106 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#ifndef UTIL_WEIGHTEDGRAPH_H_
+#define UTIL_WEIGHTEDGRAPH_H_
+
+#include "common/base/Base.h"
+#include "common/datatypes/Path.h"
+#include "util/PathTree.h"
+
+namespace nebula {
+namespace graph {
+
+/***************************************************************************
+ *
+ * The weighted arcs fetched by a path search, chained per vertex in a flat
+ * array by the dense ids of the vertices, so the lightest paths are found
+ * without fetching anything more.
+ *
+ * The lightest paths are found by Dijkstra on the (vertex, steps) states:
+ * a state is settled unless its vertex is settled by fewer steps already,
+ * which is then at most as heavy. So the paths found are the lightest ones
+ * within the steps, even if a heavier path of fewer steps is the only one
+ * to go on within them.
+ *
+ **************************************************************************/
+class WeightedGraph final {
+public:
+    using Id = VidIndex::Id;
+
+    explicit WeightedGraph(VidIndex *index) : index_(index) {}
+
+    // Add the arc from `src' to `dst', which is stepped over as an edge of `type', once
+    // however many times it's added. The weight must not be negative.
+    void addArc(Id src,
+                Id dst,
+                EdgeType type,
+                EdgeRanking ranking,
+                const std::string &name,
+                double weight);
+
+    size_t arcs() const {
+        return arcs_.size();
+    }
+
+    // The lightest path of at most `maxSteps' arcs from `src' to each of `dsts' reachable
+    // along with its weight, in the order of `dsts'. Of the paths as light, the one of the
+    // fewest steps is chosen.
+    std::vector<std::pair<Path, double>> shortestPaths(Id src,
+                                                       const std::vector<Id> &dsts,
+                                                       size_t maxSteps) const;
+
+private:
+    struct Arc {
+        Id              dst;
+        EdgeType        type;
+        EdgeRanking     ranking;
+        double          weight;
+        // The next arc of the same src, kNone if it's the last one
+        uint32_t        next;
+    };
+
+    struct ArcKey {
+        Id              src;
+        Id              dst;
+        EdgeType        type;
+        EdgeRanking     ranking;
+
+        bool operator==(const ArcKey &rhs) const {
+            return src == rhs.src && dst == rhs.dst && type == rhs.type && ranking == rhs.ranking;
+        }
+    };
+
+    struct ArcKeyHash {
+        size_t operator()(const ArcKey &key) const {
+            return folly::hash::hash_combine(key.src, key.dst, key.type, key.ranking);
+        }
+    };
+
+    // A path found by Dijkstra, of the arc from the path of `parent'
+    struct Label {
+        Id              vid;
+        uint32_t        steps;
+        uint32_t        parent;
+        uint32_t        arc;
+        double          weight;
+    };
+
+    Path buildPath(Id src, const std::vector<Label> &labels, uint32_t label) const;
+
+    VidIndex                                   *index_{nullptr};
+    std::vector<Arc>                            arcs_;
+    // The first arc of each src, indexed by its id
+    std::vector<uint32_t>                       head_;
+    std::unordered_set<ArcKey, ArcKeyHash>      keys_;
+    // The edge names by their types
+    std::unordered_map<EdgeType, std::string>   names_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // UTIL_WEIGHTEDGRAPH_H_
@@ -0,0 +1,146 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/CompiledExpr.h"
+
+#include <gtest/gtest.h>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "context/Iterator.h"
+#include "context/QueryExpressionContext.h"
+
+namespace nebula {
+namespace graph {
+
+class CompiledExprTest : public ::testing::Test {
+protected:
+    static Expression *input(const std::string &name) {
+        return new InputPropertyExpression(new std::string(name));
+    }
+
+    // The compiled expression must be evaluated the same as the original one
+    static void check(Iterator *iter, Expression *expr) {
+        std::unique_ptr<Expression> holder(expr);
+        auto compiled = CompiledExpr::compile(expr, iter);
+        ASSERT_NE(compiled, nullptr) << expr->toString();
+        QueryExpressionContext ctx;
+        size_t numRows = 0;
+        for (iter->reset(); iter->valid(); iter->next(), ++numRows) {
+            Value expected = expr->eval(ctx(iter));
+            Value val = compiled->eval(iter, ctx);
+            EXPECT_EQ(expected.type(), val.type()) << expr->toString() << " at row " << numRows;
+            if (!expected.isNull()) {
+                EXPECT_EQ(expected, val) << expr->toString() << " at row " << numRows;
+            }
+        }
+        EXPECT_GT(numRows, 0);
+    }
+
+    static std::shared_ptr<Value> neighbors() {
+        List datasets;
+        for (auto dir : {"+", "-"}) {
+            DataSet ds;
+            auto tag = dir[0] == '+' ? std::string("tag1") : std::string("tag2");
+            auto edge = dir + std::string(dir[0] == '+' ? "edge1" : "edge2");
+            ds.colNames = {kVid,
+                           "_stats",
+                           "_tag:" + tag + ":prop1:prop2",
+                           "_edge:" + edge + ":prop1:prop2:_dst:_type:_rank",
+                           "_expr"};
+            for (auto i = 0; i < 5; ++i) {
+                Row row;
+                row.values.emplace_back(folly::to<std::string>(i));
+                row.values.emplace_back(Value());
+                // The prop2 of odd vertices is EMPTY
+                row.values.emplace_back(List({Value(i), i % 2 == 0 ? Value(i * 2) : Value()}));
+                List edges;
+                for (auto j = 0; j < 2; ++j) {
+                    edges.values.emplace_back(
+                        List({Value(j), Value(i + j), Value("2"), Value(1), Value(j)}));
+                }
+                row.values.emplace_back(std::move(edges));
+                row.values.emplace_back(Value());
+                ds.rows.emplace_back(std::move(row));
+            }
+            datasets.values.emplace_back(std::move(ds));
+        }
+        return std::make_shared<Value>(std::move(datasets));
+    }
+};
+
+TEST_F(CompiledExprTest, Sequential) {
+    DataSet ds({"a", "b", "s", "player.age"});
+    for (int64_t i = 0; i < 10; ++i) {
+        ds.emplace_back(Row({Value(i), Value(i * 0.5), Value(i % 2 == 0 ? "x" : "y"), Value(i)}));
+    }
+    ds.emplace_back(Row({Value::kNullValue, Value::kNullValue, Value::kNullValue, Value::kEmpty}));
+    ds.emplace_back(
+        Row({Value(std::numeric_limits<int64_t>::max()), Value(1.0), Value("x"), Value(1)}));
+    SequentialIter iter(std::make_shared<Value>(std::move(ds)));
+
+    check(&iter, input("a"));
+    check(&iter, new ArithmeticExpression(
+                     Expression::Kind::kAdd, input("a"), new ConstantExpression(1)));
+    check(&iter, new ArithmeticExpression(Expression::Kind::kMultiply, input("a"), input("b")));
+    check(&iter, new ArithmeticExpression(
+                     Expression::Kind::kDivision, input("a"), new ConstantExpression(0)));
+    check(&iter, new UnaryExpression(Expression::Kind::kUnaryNegate, input("a")));
+    check(&iter, new RelationalExpression(
+                     Expression::Kind::kRelLT, input("b"), new ConstantExpression(2.0)));
+    check(&iter,
+          new LogicalExpression(
+              Expression::Kind::kLogicalAnd,
+              new RelationalExpression(
+                  Expression::Kind::kRelGE, input("a"), new ConstantExpression(3)),
+              new RelationalExpression(
+                  Expression::Kind::kRelEQ, input("s"), new ConstantExpression("x"))));
+    check(&iter,
+          new UnaryExpression(
+              Expression::Kind::kUnaryNot,
+              new RelationalExpression(
+                  Expression::Kind::kRelNE, input("s"), new ConstantExpression("y"))));
+    // The vertex properties are the columns named `tag.prop'
+    check(&iter, new RelationalExpression(
+                     Expression::Kind::kRelGT,
+                     new TagPropertyExpression(new std::string("player"), new std::string("age")),
+                     input("a")));
+    // Only the arguments of function are resolved
+    auto *args = new ArgumentList();
+    args->addArgument(std::unique_ptr<Expression>(input("a")));
+    check(&iter, new FunctionCallExpression(new std::string("abs"), args));
+
+    // Nothing to resolve
+    std::unique_ptr<Expression> unknown(input("unknown"));
+    EXPECT_EQ(CompiledExpr::compile(unknown.get(), &iter), nullptr);
+}
+
+TEST_F(CompiledExprTest, GetNeighbors) {
+    GetNeighborsIter iter(neighbors());
+
+    check(&iter, input(kVid));
+    auto *srcProp = new SourcePropertyExpression(new std::string("tag1"), new std::string("prop1"));
+    check(&iter,
+          new ArithmeticExpression(Expression::Kind::kAdd, srcProp, new ConstantExpression(1)));
+    check(&iter, new ArithmeticExpression(
+                     Expression::Kind::kMultiply,
+                     new TagPropertyExpression(new std::string("tag2"), new std::string("prop2")),
+                     new ConstantExpression(3)));
+    check(&iter, new RelationalExpression(
+                     Expression::Kind::kRelGT,
+                     new EdgePropertyExpression(new std::string("edge1"), new std::string("prop2")),
+                     new ConstantExpression(2)));
+    auto *edgeProp = new EdgePropertyExpression(new std::string("edge2"), new std::string("prop1"));
+    check(&iter, new UnaryExpression(Expression::Kind::kUnaryNegate, edgeProp));
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,69 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/MemoryTracker.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(MemoryTrackerTest, Hierarchy) {
+    auto session = std::make_shared<MemoryTracker>(nullptr);
+    auto query = std::make_shared<MemoryTracker>(session, 100);
+    auto executor = std::make_shared<MemoryTracker>(query);
+
+    EXPECT_TRUE(executor->consume(60));
+    EXPECT_EQ(executor->current(), 60);
+    EXPECT_EQ(query->current(), 60);
+    EXPECT_EQ(session->current(), 60);
+    EXPECT_TRUE(executor->limited());
+    EXPECT_FALSE(session->limited());
+
+    EXPECT_FALSE(executor->consume(60));
+    EXPECT_TRUE(executor->exceeded());
+    EXPECT_TRUE(query->exceeded());
+    EXPECT_FALSE(session->exceeded());
+
+    executor->release(100);
+    EXPECT_FALSE(executor->exceeded());
+    EXPECT_EQ(executor->current(), 20);
+    EXPECT_EQ(executor->peak(), 120);
+    EXPECT_EQ(session->peak(), 120);
+
+    executor->resetPeak();
+    EXPECT_EQ(executor->peak(), 20);
+
+    // The left bytes are returned to the ancestors
+    executor.reset();
+    EXPECT_EQ(query->current(), 0);
+    EXPECT_EQ(session->current(), 0);
+}
+
+TEST(MemoryTrackerTest, Reservation) {
+    auto query = std::make_shared<MemoryTracker>(nullptr);
+    auto executor = std::make_shared<MemoryTracker>(query);
+    {
+        EXPECT_TRUE(executor->consume(10));
+        MemoryReservation reservation(executor, 10);
+        MemoryReservation moved(std::move(reservation));
+        EXPECT_EQ(reservation.bytes(), 0);
+        EXPECT_EQ(moved.bytes(), 10);
+        EXPECT_EQ(query->current(), 10);
+    }
+    EXPECT_EQ(query->current(), 0);
+
+    // The reservation keeps the tracker alive
+    EXPECT_TRUE(executor->consume(10));
+    MemoryReservation reservation(executor, 10);
+    executor.reset();
+    EXPECT_EQ(query->current(), 10);
+    reservation.reset();
+    EXPECT_EQ(query->current(), 0);
+}
+
+}   // namespace graph
+}   // namespace nebula
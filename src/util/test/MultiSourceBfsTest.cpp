@@ -0,0 +1,151 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/MultiSourceBfs.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+class MultiSourceBfsTest : public testing::Test {
+protected:
+    VidIndex::Id id(const std::string& vid) {
+        return index_.insert(vid);
+    }
+
+    void addArc(const std::string& src, const std::string& dst) {
+        bfs_.addArc(id(src), id(dst), 1, "like", 0);
+    }
+
+    std::vector<std::string> sorted(const std::vector<VidIndex::Id>& ids) const {
+        std::vector<std::string> vids;
+        for (auto i : ids) {
+            vids.emplace_back(index_.vid(i).getStr());
+        }
+        std::sort(vids.begin(), vids.end());
+        return vids;
+    }
+
+    std::vector<Path> paths(size_t start, size_t layer, const std::string& vid) {
+        std::vector<std::vector<uint32_t>> arcs;
+        bfs_.paths(start, layer, id(vid), arcs);
+        std::vector<Path> result;
+        for (auto& path : arcs) {
+            Path p;
+            bfs_.forwardSteps(path, p);
+            result.emplace_back(std::move(p));
+        }
+        // By the vids on them
+        auto vids = [](const Path& p) {
+            std::vector<std::string> result = {p.src.vid.getStr()};
+            for (auto& step : p.steps) {
+                result.emplace_back(step.dst.vid.getStr());
+            }
+            return result;
+        };
+        std::sort(result.begin(), result.end(), [&vids](const Path& lhs, const Path& rhs) {
+            return vids(lhs) < vids(rhs);
+        });
+        return result;
+    }
+
+    static Path path(const std::string& src, const std::vector<std::string>& dsts) {
+        Path result;
+        result.src = Vertex(src, {});
+        for (auto& dst : dsts) {
+            result.steps.emplace_back(Step(Vertex(dst, {}), 1, "like", 0, {}));
+        }
+        return result;
+    }
+
+    VidIndex index_;
+    MultiSourceBfs bfs_{&index_};
+};
+
+TEST_F(MultiSourceBfsTest, Layers) {
+    bfs_.setStarts({id("a"), id("b"), id("a")});
+    ASSERT_EQ(bfs_.starts().size(), 2u);
+    EXPECT_EQ(bfs_.words(), 1u);
+
+    // a->c, b->c, a->e, then c->d, e->d
+    addArc("a", "c");
+    addArc("b", "c");
+    addArc("a", "e");
+    EXPECT_EQ(sorted(bfs_.expand()), std::vector<std::string>({"c", "e"}));
+    addArc("c", "d");
+    addArc("e", "d");
+    EXPECT_EQ(sorted(bfs_.expand()), std::vector<std::string>({"d"}));
+    EXPECT_EQ(bfs_.layers(), 3u);
+
+    auto* c = bfs_.mask(1, id("c"));
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(c[0], 3u);
+    auto* e = bfs_.mask(1, id("e"));
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e[0], 1u);
+    EXPECT_EQ(bfs_.mask(1, id("d")), nullptr);
+
+    EXPECT_EQ(paths(0, 2, "d"),
+              std::vector<Path>({path("a", {"c", "d"}), path("a", {"e", "d"})}));
+    EXPECT_EQ(paths(1, 2, "d"), std::vector<Path>({path("b", {"c", "d"})}));
+    EXPECT_TRUE(paths(1, 1, "e").empty());
+}
+
+TEST_F(MultiSourceBfsTest, ReachAgainWithoutFetching) {
+    bfs_.setStarts({id("a"), id("b")});
+    // a->x, b->y, then y->x, x->z
+    addArc("a", "x");
+    addArc("b", "y");
+    EXPECT_EQ(sorted(bfs_.expand()), std::vector<std::string>({"x", "y"}));
+    addArc("y", "x");
+    addArc("x", "z");
+    // x is reached by b a layer later, by the arcs fetched already
+    EXPECT_EQ(sorted(bfs_.expand()), std::vector<std::string>({"z"}));
+    EXPECT_TRUE(bfs_.expand().empty());
+    ASSERT_EQ(bfs_.vids(3).size(), 1u);
+    EXPECT_EQ(paths(1, 3, "z"), std::vector<Path>({path("b", {"y", "x", "z"})}));
+    EXPECT_EQ(paths(0, 2, "z"), std::vector<Path>({path("a", {"x", "z"})}));
+}
+
+TEST_F(MultiSourceBfsTest, BackwardSteps) {
+    bfs_.setStarts({id("d")});
+    // Fetched backward from d and then from c: c->d, b->c
+    bfs_.addArc(id("d"), id("c"), -1, "like", 0);
+    bfs_.expand();
+    bfs_.addArc(id("c"), id("b"), -1, "like", 0);
+    bfs_.expand();
+
+    std::vector<std::vector<uint32_t>> arcs;
+    bfs_.paths(0, 2, id("b"), arcs);
+    ASSERT_EQ(arcs.size(), 1u);
+    Path result;
+    result.src = Vertex("b", {});
+    bfs_.backwardSteps(arcs.front(), result);
+    EXPECT_EQ(result, path("b", {"c", "d"}));
+}
+
+TEST_F(MultiSourceBfsTest, ManyStarts) {
+    // More starts than a word holds
+    std::vector<VidIndex::Id> starts;
+    for (auto i = 0; i < 100; ++i) {
+        starts.emplace_back(id(folly::to<std::string>(i)));
+    }
+    bfs_.setStarts(starts);
+    for (auto i = 0; i < 100; ++i) {
+        addArc(folly::to<std::string>(i), "hub");
+    }
+    EXPECT_EQ(bfs_.words(), 2u);
+    EXPECT_EQ(sorted(bfs_.expand()), std::vector<std::string>({"hub"}));
+    auto* hub = bfs_.mask(1, id("hub"));
+    ASSERT_NE(hub, nullptr);
+    EXPECT_EQ(hub[0], ~uint64_t{0});
+    EXPECT_EQ(hub[1], (uint64_t{1} << 36) - 1);
+    EXPECT_EQ(paths(99, 1, "hub"), std::vector<Path>({path("99", {"hub"})}));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,106 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/PathTree.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(PathTreeTest, VidIndex) {
+    VidIndex index;
+    EXPECT_EQ(index.find("a"), VidIndex::kNone);
+    EXPECT_EQ(index.insert("a"), 0u);
+    EXPECT_EQ(index.insert("b"), 1u);
+    EXPECT_EQ(index.insert("a"), 0u);
+    EXPECT_EQ(index.find("b"), 1u);
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.vid(1), "b");
+}
+
+TEST(PathTreeTest, Paths) {
+    // a->b, a->c, b->d@0, b->d@1, c->d
+    Edge ab("a", "b", 1, "like", 0, {});
+    Edge ac("a", "c", 1, "like", 0, {});
+    Edge bd0("b", "d", 1, "like", 0, {});
+    Edge bd1("b", "d", 1, "like", 1, {});
+    Edge cd("c", "d", 1, "like", 0, {});
+
+    VidIndex index;
+    PathTree tree(&index);
+    tree.newLayer();
+    tree.add("a", nullptr);
+    tree.newLayer();
+    tree.add("b", &ab);
+    tree.add("c", &ac);
+    tree.newLayer();
+    tree.add("d", &bd0);
+    tree.add("d", &bd1);
+    tree.add("d", &cd);
+
+    auto d = index.find("d");
+    EXPECT_TRUE(tree.inLatestLayer(d));
+    EXPECT_FALSE(tree.inLatestLayer(index.find("b")));
+
+    auto paths = tree.paths(d);
+    ASSERT_EQ(paths.size(), 3u);
+    std::vector<Path> results;
+    for (auto &path : paths) {
+        Path result;
+        tree.forwardSteps(path, result);
+        results.emplace_back(std::move(result));
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].src, Vertex("a", {}));
+        ASSERT_EQ(results[i].steps.size(), 2u);
+        EXPECT_EQ(results[i].steps.back().dst, Vertex("d", {}));
+    }
+    EXPECT_EQ(results[0].steps[0].dst, Vertex("b", {}));
+    EXPECT_EQ(results[0].steps[1].ranking, 0);
+    EXPECT_EQ(results[1].steps[0].dst, Vertex("b", {}));
+    EXPECT_EQ(results[1].steps[1].ranking, 1);
+    EXPECT_EQ(results[2].steps[0].dst, Vertex("c", {}));
+
+    // Backward from d to a
+    Path backward;
+    backward.src = Vertex("d", {});
+    tree.backwardSteps(paths[2], backward);
+    ASSERT_EQ(backward.steps.size(), 2u);
+    EXPECT_EQ(backward.steps[0].dst, Vertex("c", {}));
+    EXPECT_EQ(backward.steps[0].type, -1);
+    EXPECT_EQ(backward.steps[1].dst, Vertex("a", {}));
+}
+
+TEST(PathTreeTest, StartFromEdges) {
+    // The first layer holds the edges from the start, a->b
+    Edge ab("a", "b", 1, "like", 0, {});
+
+    VidIndex index;
+    PathTree forward(&index);
+    PathTree backward(&index);
+    forward.newLayer();
+    forward.add("b", &ab);
+
+    auto b = index.find("b");
+    auto forwardPaths = forward.paths(b);
+    ASSERT_EQ(forwardPaths.size(), 1u);
+    // Met at the start of the backward side
+    auto backwardPaths = backward.paths(b);
+    ASSERT_EQ(backwardPaths.size(), 1u);
+    EXPECT_TRUE(backwardPaths.front().empty());
+
+    Path result;
+    forward.forwardSteps(forwardPaths.front(), result);
+    backward.backwardSteps(backwardPaths.front(), result);
+    EXPECT_EQ(result.src, Vertex("a", {}));
+    ASSERT_EQ(result.steps.size(), 1u);
+    EXPECT_EQ(result.steps.front().dst, Vertex("b", {}));
+    EXPECT_EQ(result.steps.front().type, 1);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,91 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/PathTrie.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(PathTrieTest, SharePrefix) {
+    // a->b, a->b->c, a->b->d
+    Edge ab("a", "b", 1, "like", 0, {});
+    Edge bc("b", "c", 1, "like", 0, {});
+    Edge bd("b", "d", 1, "like", 0, {});
+
+    VidIndex index;
+    auto a = index.insert("a");
+    auto b = index.insert("b");
+    auto c = index.insert("c");
+    auto d = index.insert("d");
+    PathTrie trie(&index);
+    auto nab = trie.add(PathTrie::kRoot, a, b, 1, 0, &ab);
+    auto nbc = trie.add(nab, b, c, 1, 0, &bc);
+    auto nbd = trie.add(nab, b, d, 1, 0, &bd);
+    EXPECT_EQ(trie.size(), 3u);
+    EXPECT_EQ(trie.node(nbc).start, a);
+    EXPECT_EQ(trie.node(nbd).parent, nab);
+
+    EXPECT_TRUE(trie.hasVertex(nbc, a));
+    EXPECT_TRUE(trie.hasVertex(nbc, b));
+    EXPECT_TRUE(trie.hasVertex(nbc, c));
+    EXPECT_FALSE(trie.hasVertex(nbc, d));
+    EXPECT_FALSE(trie.hasVertex(nab, c));
+
+    Path path;
+    trie.forwardSteps(nbd, path);
+    Path expected;
+    expected.src = Vertex("a", {});
+    expected.steps.emplace_back(Step(Vertex("b", {}), 1, "like", 0, {}));
+    expected.steps.emplace_back(Step(Vertex("d", {}), 1, "like", 0, {}));
+    EXPECT_EQ(path, expected);
+}
+
+TEST(PathTrieTest, HasEdge) {
+    // a->b@0, b->a@0 reversely
+    Edge ab("a", "b", 1, "like", 0, {});
+    Edge ba("b", "a", -1, "like", 0, {});
+
+    VidIndex index;
+    auto a = index.insert("a");
+    auto b = index.insert("b");
+    auto c = index.insert("c");
+    PathTrie trie(&index);
+    auto nab = trie.add(PathTrie::kRoot, a, b, 1, 0, &ab);
+    EXPECT_TRUE(trie.hasEdge(nab, a, b, 1, 0));
+    // The same edge stepped over reversely
+    EXPECT_TRUE(trie.hasEdge(nab, b, a, -1, 0));
+    EXPECT_FALSE(trie.hasEdge(nab, a, b, 1, 1));
+    EXPECT_FALSE(trie.hasEdge(nab, b, a, 1, 0));
+    EXPECT_FALSE(trie.hasEdge(nab, b, c, 1, 0));
+}
+
+TEST(PathTrieTest, BackwardSteps) {
+    // The backward search from c reaches b, then a
+    Edge cb("c", "b", -1, "like", 0, {});
+    Edge ba("b", "a", -1, "like", 0, {});
+
+    VidIndex index;
+    auto a = index.insert("a");
+    auto b = index.insert("b");
+    auto c = index.insert("c");
+    PathTrie trie(&index);
+    auto ncb = trie.add(PathTrie::kRoot, c, b, -1, 0, &cb);
+    auto nba = trie.add(ncb, b, a, -1, 0, &ba);
+
+    Path path;
+    path.src = Vertex("a", {});
+    trie.backwardSteps(nba, path);
+    Path expected;
+    expected.src = Vertex("a", {});
+    expected.steps.emplace_back(Step(Vertex("b", {}), 1, "like", 0, {}));
+    expected.steps.emplace_back(Step(Vertex("c", {}), 1, "like", 0, {}));
+    EXPECT_EQ(path, expected);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,164 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/RowCache.h"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "util/MemoryUtil.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(RowCacheTest, GetAndEvict) {
+    RowCache cache(100, std::chrono::milliseconds(0));
+    EXPECT_EQ(cache.get(1, "a", "1:p1;"), nullptr);
+
+    auto generation = cache.generation();
+    cache.put(1, "a", "1:p1;", generation, Row({"a", 1}));
+    cache.put(1, "a", "1:p1,p2;", generation, Row({"a", 1, 2}));
+    cache.put(2, "a", "1:p1;", generation, Row({"a", 3}));
+    EXPECT_EQ(cache.size(), 2);
+
+    auto row = cache.get(1, "a", "1:p1;");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, Row({"a", 1}));
+    row = cache.get(1, "a", "1:p1,p2;");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, Row({"a", 1, 2}));
+    // Different space
+    row = cache.get(2, "a", "1:p1;");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, Row({"a", 3}));
+    EXPECT_EQ(cache.get(1, "a", "2:p1;"), nullptr);
+
+    // All the rows of vertex are evicted
+    cache.evict(1, "a");
+    EXPECT_EQ(cache.get(1, "a", "1:p1;"), nullptr);
+    EXPECT_EQ(cache.get(1, "a", "1:p1,p2;"), nullptr);
+    EXPECT_NE(cache.get(2, "a", "1:p1;"), nullptr);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.hits(), 4);
+    EXPECT_EQ(cache.misses(), 4);
+    // The row got before is still valid
+    EXPECT_EQ(*row, Row({"a", 3}));
+}
+
+TEST(RowCacheTest, EvictSpace) {
+    RowCache cache(100, std::chrono::milliseconds(0), 4);
+    auto generation = cache.generation();
+    for (auto i = 0; i < 10; ++i) {
+        cache.put(1, i, "", generation, Row({i}));
+        cache.put(2, i, "", generation, Row({i}));
+    }
+    EXPECT_EQ(cache.size(), 20);
+
+    cache.evictSpace(1);
+    EXPECT_EQ(cache.size(), 10);
+    for (auto i = 0; i < 10; ++i) {
+        EXPECT_EQ(cache.get(1, i, ""), nullptr);
+        EXPECT_NE(cache.get(2, i, ""), nullptr);
+    }
+    // Fetched before the eviction
+    cache.put(1, 0, "", generation, Row({0}));
+    EXPECT_EQ(cache.get(1, 0, ""), nullptr);
+    cache.put(1, 0, "", cache.generation(), Row({0}));
+    EXPECT_NE(cache.get(1, 0, ""), nullptr);
+}
+
+TEST(RowCacheTest, LeastRecentlyUsed) {
+    RowCache cache(2, std::chrono::milliseconds(0), 1);
+    cache.put(1, 1, "", cache.generation(), Row({1}));
+    cache.put(1, 2, "", cache.generation(), Row({2}));
+    // Vertex 1 is used after 2, so 2 is evicted
+    EXPECT_NE(cache.get(1, 1, ""), nullptr);
+    cache.put(1, 3, "", cache.generation(), Row({3}));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_NE(cache.get(1, 1, ""), nullptr);
+    EXPECT_EQ(cache.get(1, 2, ""), nullptr);
+    EXPECT_NE(cache.get(1, 3, ""), nullptr);
+}
+
+TEST(RowCacheTest, Expire) {
+    RowCache cache(10, std::chrono::milliseconds(10));
+    cache.put(1, "a", "", cache.generation(), Row({"a"}));
+    EXPECT_NE(cache.get(1, "a", ""), nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(cache.get(1, "a", ""), nullptr);
+
+    // Put again after expired
+    cache.put(1, "a", "", cache.generation(), Row({"b"}));
+    auto row = cache.get(1, "a", "");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, Row({"b"}));
+}
+
+TEST(RowCacheTest, ColNames) {
+    RowCache cache(10, std::chrono::milliseconds(0));
+    auto colNames = std::make_shared<const std::vector<std::string>>(
+        std::vector<std::string>{"_vid", "_stats", "_expr"});
+    cache.put(1, "a", "", cache.generation(), Row({"a", Value(), Value()}), colNames);
+    cache.put(1, "b", "", cache.generation(), Row({"b"}));
+
+    RowCache::ColNames cachedColNames;
+    ASSERT_NE(cache.get(1, "a", "", &cachedColNames), nullptr);
+    EXPECT_EQ(cachedColNames, colNames);
+    ASSERT_NE(cache.get(1, "b", "", &cachedColNames), nullptr);
+    EXPECT_EQ(cachedColNames, nullptr);
+}
+
+TEST(RowCacheTest, StaleFill) {
+    RowCache cache(10, std::chrono::milliseconds(0), 1);
+    // Fetched before the vertex is written and evicted
+    auto generation = cache.generation();
+    cache.evict(1, "a");
+    cache.put(1, "a", "", generation, Row({"old"}));
+    EXPECT_EQ(cache.get(1, "a", ""), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+
+    // Fetched after the eviction
+    generation = cache.generation();
+    cache.put(1, "a", "", generation, Row({"new"}));
+    auto row = cache.get(1, "a", "");
+    ASSERT_NE(row, nullptr);
+    EXPECT_EQ(*row, Row({"new"}));
+}
+
+TEST(RowCacheTest, MaxBytes) {
+    Row small({"a", 1});
+    auto bytes = MemoryUtil::estimateSize(small);
+    RowCache cache(100, std::chrono::milliseconds(0), 1, bytes * 2);
+    cache.put(1, 1, "", cache.generation(), small);
+    cache.put(1, 2, "", cache.generation(), small);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.bytes(), bytes * 2);
+
+    // The least recently used one is dropped for the bytes
+    EXPECT_NE(cache.get(1, 1, ""), nullptr);
+    cache.put(1, 3, "", cache.generation(), small);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.bytes(), bytes * 2);
+    EXPECT_NE(cache.get(1, 1, ""), nullptr);
+    EXPECT_EQ(cache.get(1, 2, ""), nullptr);
+
+    // Never cached if larger than the shard
+    List neighbors;
+    for (auto i = 0; i < 100; ++i) {
+        neighbors.values.emplace_back(i);
+    }
+    cache.put(1, 4, "", cache.generation(), Row({4, std::move(neighbors)}));
+    EXPECT_EQ(cache.get(1, 4, ""), nullptr);
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.evict(1, 1);
+    cache.evict(1, 3);
+    EXPECT_EQ(cache.bytes(), 0);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,55 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/SingleFlight.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(SingleFlightTest, Join) {
+    SingleFlight<int> flight;
+    folly::Promise<int> a;
+    folly::Promise<int> b;
+    int numCalls = 0;
+    bool joined = false;
+    auto f1 = flight.call("a", [&]() { ++numCalls; return a.getFuture(); }, &joined);
+    EXPECT_FALSE(joined);
+    auto f2 = flight.call("a", [&]() { ++numCalls; return a.getFuture(); }, &joined);
+    EXPECT_TRUE(joined);
+    auto f3 = flight.call("b", [&]() { ++numCalls; return b.getFuture(); });
+    EXPECT_EQ(numCalls, 2);
+    EXPECT_EQ(flight.size(), 2);
+
+    a.setValue(1);
+    b.setValue(2);
+    EXPECT_EQ(std::move(f1).get(), 1);
+    EXPECT_EQ(std::move(f2).get(), 1);
+    EXPECT_EQ(std::move(f3).get(), 2);
+    EXPECT_EQ(flight.size(), 0);
+    EXPECT_EQ(flight.numJoined(), 1);
+
+    // Called again once completed
+    auto f4 = flight.call("a", [&]() { ++numCalls; return folly::makeFuture(3); }, &joined);
+    EXPECT_FALSE(joined);
+    EXPECT_EQ(std::move(f4).get(), 3);
+    EXPECT_EQ(numCalls, 3);
+}
+
+TEST(SingleFlightTest, Exception) {
+    SingleFlight<int> flight;
+    folly::Promise<int> a;
+    auto f1 = flight.call("a", [&]() { return a.getFuture(); });
+    auto f2 = flight.call("a", [&]() { return a.getFuture(); });
+    a.setException(std::runtime_error("failed"));
+    EXPECT_THROW(std::move(f1).get(), std::runtime_error);
+    EXPECT_THROW(std::move(f2).get(), std::runtime_error);
+    EXPECT_EQ(flight.size(), 0);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,111 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/SpillFile.h"
+
+#include <gtest/gtest.h>
+
+#include "common/fs/TempDir.h"
+#include "util/MemoryUtil.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(SpillFileTest, WriteAndRead) {
+    fs::TempDir dir("/tmp/SpillFileTest.XXXXXX");
+    auto ret = SpillFile::create(dir.path());
+    ASSERT_TRUE(ret.ok()) << ret.status();
+    auto file = std::move(ret).value();
+
+    std::vector<Row> rows;
+    for (int64_t i = 0; i < 100; ++i) {
+        Row row;
+        row.values.emplace_back(i);
+        row.values.emplace_back(folly::to<std::string>(i));
+        row.values.emplace_back(List({i, Value::kNullValue}));
+        rows.emplace_back(std::move(row));
+    }
+    for (auto &row : rows) {
+        EXPECT_TRUE(file->write(row).ok());
+    }
+    EXPECT_EQ(file->numRows(), rows.size());
+    EXPECT_GT(file->bytes(), 0);
+
+    ASSERT_TRUE(file->flush().ok());
+    auto reader = file->reader();
+    Row row;
+    for (auto &expected : rows) {
+        auto hasNext = reader.read(&row);
+        ASSERT_TRUE(hasNext.ok());
+        ASSERT_TRUE(hasNext.value());
+        EXPECT_EQ(row, expected);
+    }
+    auto hasNext = reader.read(&row);
+    ASSERT_TRUE(hasNext.ok());
+    EXPECT_FALSE(hasNext.value());
+}
+
+TEST(SpillFileTest, ReadRanges) {
+    fs::TempDir dir("/tmp/SpillFileTest.XXXXXX");
+    auto ret = SpillFile::create(dir.path());
+    ASSERT_TRUE(ret.ok()) << ret.status();
+    auto file = std::move(ret).value();
+
+    // Two ranges of rows larger than the buffer of the readers
+    std::string str(1024, 'a');
+    std::vector<size_t> offsets = {0};
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(file->write(Row({i, str})).ok());
+        if (i == 49) {
+            offsets.emplace_back(file->bytes());
+        }
+    }
+    offsets.emplace_back(file->bytes());
+    ASSERT_TRUE(file->flush().ok());
+
+    // Read both ranges in turn
+    SpillFile::Reader first(file.get(), offsets[0], offsets[1]);
+    SpillFile::Reader second(file.get(), offsets[1], offsets[2]);
+    Row row;
+    for (int64_t i = 0; i < 50; ++i) {
+        auto hasNext = first.read(&row);
+        ASSERT_TRUE(hasNext.ok()) << hasNext.status();
+        ASSERT_TRUE(hasNext.value());
+        EXPECT_EQ(row, Row({i, str}));
+        hasNext = second.read(&row);
+        ASSERT_TRUE(hasNext.ok()) << hasNext.status();
+        ASSERT_TRUE(hasNext.value());
+        EXPECT_EQ(row, Row({i + 50, str}));
+    }
+    EXPECT_FALSE(first.read(&row).value());
+    EXPECT_FALSE(second.read(&row).value());
+}
+
+TEST(SpillFileTest, BadDir) {
+    auto ret = SpillFile::create("/path/not/exists");
+    EXPECT_FALSE(ret.ok());
+}
+
+TEST(MemoryUtilTest, EstimateSize) {
+    EXPECT_EQ(MemoryUtil::estimateSize(Value(1)), sizeof(Value));
+    std::string str(100, 'a');
+    EXPECT_GE(MemoryUtil::estimateSize(Value(str)), sizeof(Value) + str.size());
+
+    Row row;
+    row.values.emplace_back(1);
+    row.values.emplace_back(str);
+    auto rowSize = MemoryUtil::estimateSize(row);
+    EXPECT_GE(rowSize, 2 * sizeof(Value) + str.size());
+
+    DataSet ds({"col1", "col2"});
+    ds.rows.emplace_back(row);
+    ds.rows.emplace_back(row);
+    EXPECT_GE(MemoryUtil::estimateSize(ds), 2 * rowSize);
+    EXPECT_GE(MemoryUtil::estimateSize(Value(ds)), 2 * rowSize);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,37 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/StatsCache.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+TEST(StatsCacheTest, PutAndGet) {
+    StatsCache cache(nullptr, std::chrono::seconds(60));
+    EXPECT_EQ(cache.get(1), nullptr);
+
+    meta::cpp2::StatisItem item;
+    item.set_tag_vertices({{"person", 100}, {"team", 3}});
+    item.set_edges({{"like", 1000}});
+    item.set_space_vertices(103);
+    item.set_space_edges(1000);
+    cache.put(1, item);
+
+    auto stats = cache.get(1);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->vertices, 103);
+    EXPECT_EQ(stats->edges, 1000);
+    EXPECT_EQ(stats->tagVertices.at("person"), 100);
+    EXPECT_EQ(stats->tagVertices.at("team"), 3);
+    EXPECT_EQ(stats->edgeCounts.at("like"), 1000);
+    // Different space
+    EXPECT_EQ(cache.get(2), nullptr);
+}
+
+}   // namespace graph
+}   // namespace nebula
@@ -0,0 +1,118 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/VectorizedExpr.h"
+
+#include <gtest/gtest.h>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "context/ColumnBatch.h"
+#include "context/Iterator.h"
+#include "context/QueryExpressionContext.h"
+
+namespace nebula {
+namespace graph {
+
+class VectorizedExprTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        DataSet ds({"a", "b", "s"});
+        for (int64_t i = 0; i < 10; ++i) {
+            ds.emplace_back(Row({Value(i), Value(i * 0.5), Value(i % 2 == 0 ? "x" : "y")}));
+        }
+        ds.emplace_back(Row({Value::kNullValue, Value::kNullValue, Value::kNullValue}));
+        ds.emplace_back(
+            Row({Value(std::numeric_limits<int64_t>::max()), Value(1.0), Value::kEmpty}));
+        ds.emplace_back(Row({Value("z"), Value(2.0), Value(1)}));
+        iter_ = std::make_unique<SequentialIter>(std::make_shared<Value>(std::move(ds)));
+    }
+
+    static Expression *col(const std::string &name) {
+        return new InputPropertyExpression(new std::string(name));
+    }
+
+    // The vectorized results must be the same as evaluating row by row
+    void check(Expression *expr) {
+        std::unique_ptr<Expression> holder(expr);
+        auto vectorized = VectorizedExpr::make(expr, iter_->getColIndices());
+        ASSERT_NE(vectorized, nullptr) << expr->toString();
+        QueryExpressionContext ctx;
+        ColumnBatch batch(iter_.get(), 0, iter_->size());
+        auto column = vectorized->eval(&batch, ctx);
+        ASSERT_EQ(column.size(), iter_->size());
+        for (size_t i = 0; i < iter_->size(); ++i) {
+            iter_->reset(i);
+            Value expected = expr->eval(ctx(iter_.get()));
+            auto val = column.value(i);
+            EXPECT_EQ(expected.type(), val.type()) << expr->toString() << " at row " << i;
+            if (!expected.isNull()) {
+                EXPECT_EQ(expected, val) << expr->toString() << " at row " << i;
+            }
+        }
+    }
+
+    std::unique_ptr<SequentialIter> iter_;
+};
+
+TEST_F(VectorizedExprTest, Column) {
+    ColumnBatch batch(iter_.get(), 0, iter_->size());
+    auto &a = batch.column(0);
+    EXPECT_EQ(a.type(), Column::Type::kInt);
+    EXPECT_FALSE(a.isNull(1));
+    EXPECT_EQ(a.getInt(1), 1);
+    EXPECT_TRUE(a.isNull(10));
+    EXPECT_TRUE(a.value(10).isNull());
+    EXPECT_TRUE(a.isNull(12));
+    EXPECT_EQ(a.value(12), Value("z"));
+
+    auto &s = batch.column(2);
+    EXPECT_EQ(s.type(), Column::Type::kString);
+    EXPECT_EQ(s.getStr(0), "x");
+    EXPECT_TRUE(s.value(11).empty());
+}
+
+TEST_F(VectorizedExprTest, Arithmetic) {
+    check(new ArithmeticExpression(Expression::Kind::kAdd, col("a"), new ConstantExpression(1)));
+    check(new ArithmeticExpression(Expression::Kind::kMultiply, col("a"), col("b")));
+    check(new ArithmeticExpression(
+        Expression::Kind::kDivision, col("a"), new ConstantExpression(0)));
+    check(new ArithmeticExpression(Expression::Kind::kMod, col("a"), new ConstantExpression(3)));
+    check(new ArithmeticExpression(
+        Expression::Kind::kMinus, col("b"), new ConstantExpression(0.5)));
+    check(new UnaryExpression(Expression::Kind::kUnaryNegate, col("a")));
+}
+
+TEST_F(VectorizedExprTest, RelationalAndLogical) {
+    check(new RelationalExpression(Expression::Kind::kRelGT, col("a"), new ConstantExpression(2)));
+    check(new RelationalExpression(
+        Expression::Kind::kRelEQ, col("s"), new ConstantExpression("x")));
+    check(new RelationalExpression(
+        Expression::Kind::kRelLE, col("b"), new ConstantExpression(2.0)));
+    check(new LogicalExpression(
+        Expression::Kind::kLogicalAnd,
+        new RelationalExpression(Expression::Kind::kRelGE, col("a"), new ConstantExpression(3)),
+        new RelationalExpression(Expression::Kind::kRelNE, col("s"), new ConstantExpression("y"))));
+    check(new LogicalExpression(
+        Expression::Kind::kLogicalOr,
+        new RelationalExpression(Expression::Kind::kRelLT, col("a"), new ConstantExpression(2)),
+        new RelationalExpression(Expression::Kind::kRelEQ, col("s"), new ConstantExpression("y"))));
+    check(new UnaryExpression(
+        Expression::Kind::kUnaryNot,
+        new RelationalExpression(Expression::Kind::kRelLT, col("a"), new ConstantExpression(3))));
+}
+
+TEST_F(VectorizedExprTest, NoKernel) {
+    std::unique_ptr<Expression> unknown(col("unknown"));
+    EXPECT_EQ(VectorizedExpr::make(unknown.get(), iter_->getColIndices()), nullptr);
+}
+
+}   // namespace graph
+}   // namespace nebula
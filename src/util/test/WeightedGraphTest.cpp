@@ -0,0 +1,79 @@
+/* Copyright (c) 2020 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License,
+ * attached with Common Clause Condition 1.0, found in the LICENSES directory.
+ */
+
+#include "util/WeightedGraph.h"
+
+#include <gtest/gtest.h>
+
+namespace nebula {
+namespace graph {
+
+class WeightedGraphTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // a->b: 1, b->c: 1, a->c: 10, c->d: 1
+        a_ = index_.insert("a");
+        b_ = index_.insert("b");
+        c_ = index_.insert("c");
+        d_ = index_.insert("d");
+        graph_.addArc(a_, b_, 1, "like", 0, 1.0);
+        graph_.addArc(b_, c_, 1, "like", 0, 1.0);
+        graph_.addArc(a_, c_, 1, "like", 0, 10.0);
+        graph_.addArc(c_, d_, 1, "like", 0, 1.0);
+    }
+
+    static Path path(const std::string& src, const std::vector<std::string>& dsts) {
+        Path result;
+        result.src = Vertex(src, {});
+        for (auto& dst : dsts) {
+            result.steps.emplace_back(Step(Vertex(dst, {}), 1, "like", 0, {}));
+        }
+        return result;
+    }
+
+    VidIndex index_;
+    WeightedGraph graph_{&index_};
+    VidIndex::Id a_, b_, c_, d_;
+};
+
+TEST_F(WeightedGraphTest, AddArcOnce) {
+    graph_.addArc(a_, b_, 1, "like", 0, 1.0);
+    EXPECT_EQ(graph_.arcs(), 4u);
+    graph_.addArc(a_, b_, 1, "like", 1, 1.0);
+    EXPECT_EQ(graph_.arcs(), 5u);
+}
+
+TEST_F(WeightedGraphTest, Lightest) {
+    auto paths = graph_.shortestPaths(a_, {c_, d_}, 5);
+    ASSERT_EQ(paths.size(), 2u);
+    EXPECT_EQ(paths[0].first, path("a", {"b", "c"}));
+    EXPECT_EQ(paths[0].second, 2.0);
+    EXPECT_EQ(paths[1].first, path("a", {"b", "c", "d"}));
+    EXPECT_EQ(paths[1].second, 3.0);
+}
+
+TEST_F(WeightedGraphTest, WithinSteps) {
+    // The lighter path to c takes too many steps to go on to d
+    auto paths = graph_.shortestPaths(a_, {d_, c_}, 2);
+    ASSERT_EQ(paths.size(), 2u);
+    EXPECT_EQ(paths[0].first, path("a", {"c", "d"}));
+    EXPECT_EQ(paths[0].second, 11.0);
+    EXPECT_EQ(paths[1].first, path("a", {"b", "c"}));
+    EXPECT_EQ(paths[1].second, 2.0);
+
+    paths = graph_.shortestPaths(a_, {c_}, 1);
+    ASSERT_EQ(paths.size(), 1u);
+    EXPECT_EQ(paths[0].first, path("a", {"c"}));
+    EXPECT_EQ(paths[0].second, 10.0);
+}
+
+TEST_F(WeightedGraphTest, Unreachable) {
+    EXPECT_TRUE(graph_.shortestPaths(d_, {a_}, 5).empty());
+    EXPECT_TRUE(graph_.shortestPaths(a_, {a_}, 5).empty());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -9,6 +9,7 @@
 #include "common/expression/VariableExpression.h"
 #include "planner/Algo.h"
 #include "planner/Logic.h"
+#include "util/SchemaUtil.h"
 
 namespace nebula {
 namespace graph {
@@ -21,12 +22,42 @@ Status FindPathValidator::validateImpl() {
     NG_RETURN_IF_ERROR(validateStarts(fpSentence->to(), to_));
     NG_RETURN_IF_ERROR(validateOver(fpSentence->over(), over_));
     NG_RETURN_IF_ERROR(validateStep(fpSentence->step(), steps_));
+    if (fpSentence->weight() != nullptr) {
+        isWeight_ = true;
+        weightProp_ = *fpSentence->weight();
+        NG_RETURN_IF_ERROR(validateWeight());
+    }
 
     outputs_.emplace_back("path", Value::Type::PATH);
+    if (isWeight_) {
+        outputs_.emplace_back("weight", Value::Type::FLOAT);
+    }
+    return Status::OK();
+}
+
+Status FindPathValidator::validateWeight() {
+    for (auto edgeType : over_.edgeTypes) {
+        auto schema = qctx_->schemaMng()->getEdgeSchema(space_.id, std::abs(edgeType));
+        if (schema == nullptr) {
+            return Status::SemanticError(
+                "Not exist edge `%d' in space `%d'.", edgeType, space_.id);
+        }
+        auto type = SchemaUtil::propTypeToValueType(schema->getFieldType(weightProp_));
+        if (type != Value::Type::INT && type != Value::Type::FLOAT) {
+            auto name = qctx_->schemaMng()->toEdgeName(space_.id, std::abs(edgeType));
+            NG_RETURN_IF_ERROR(name);
+            return Status::SemanticError("Weight `%s' should be a numeric property of edge `%s'.",
+                                         weightProp_.c_str(),
+                                         name.value().c_str());
+        }
+    }
     return Status::OK();
 }
 
 Status FindPathValidator::toPlan() {
+    if (isWeight_) {
+        return weightedPairPlan();
+    }
     if (!isShortest_ || noLoop_) {
         return allPairPaths();
     }
@@ -56,22 +87,31 @@ Status FindPathValidator::singlePairPlan() {
     auto* bodyStart = StartNode::make(qctx_);
     auto* passThrough = PassThroughNode::make(qctx_, bodyStart);
 
+    std::string fromStartVidsVar;
     std::string fromPathVar;
-    auto* forward = bfs(passThrough, from_, fromPathVar, false);
+    auto* forward = bfs(passThrough, from_, fromStartVidsVar, fromPathVar, false);
     VLOG(1) << "forward: " << fromPathVar;
 
+    std::string toStartVidsVar;
     std::string toPathVar;
-    auto* backward = bfs(passThrough, to_, toPathVar, true);
+    auto* backward = bfs(passThrough, to_, toStartVidsVar, toPathVar, true);
     VLOG(1) << "backward: " << toPathVar;
 
     auto* conjunct =
         ConjunctPath::make(qctx_, forward, backward, ConjunctPath::PathKind::kBiBFS, steps_.steps);
     conjunct->setLeftVar(fromPathVar);
     conjunct->setRightVar(toPathVar);
+    // Only the cheaper side is expanded in each round, see ConjunctPathExecutor
+    conjunct->setStartVidsVars(fromStartVidsVar, toStartVidsVar);
     conjunct->setColNames({"_path"});
 
-    auto* loop = Loop::make(
-        qctx_, nullptr, conjunct, buildBfsLoopCondition(steps_.steps, conjunct->outputVar()));
+    auto* loop = Loop::make(qctx_,
+                            nullptr,
+                            conjunct,
+                            buildBfsLoopCondition(steps_.steps,
+                                                  conjunct->outputVar(),
+                                                  fromStartVidsVar,
+                                                  toStartVidsVar));
 
     auto* dataCollect = DataCollect::make(
         qctx_, loop, DataCollect::CollectKind::kBFSShortest, {conjunct->outputVar()});
@@ -82,11 +122,59 @@ Status FindPathValidator::singlePairPlan() {
     return Status::OK();
 }
 
+Status FindPathValidator::weightedPairPlan() {
+    auto* bodyStart = StartNode::make(qctx_);
+    auto* passThrough = PassThroughNode::make(qctx_, bodyStart);
+
+    std::string fromStartVidsVar;
+    buildStart(from_, fromStartVidsVar, false);
+    auto* forward = GetNeighbors::make(qctx_, passThrough, space_.id);
+    forward->setSrc(from_.src);
+    forward->setEdgeProps(buildEdgeKey(false));
+    forward->setInputVar(fromStartVidsVar);
+
+    std::string toStartVidsVar;
+    buildStart(to_, toStartVidsVar, true);
+    auto* backward = GetNeighbors::make(qctx_, passThrough, space_.id);
+    backward->setSrc(to_.src);
+    backward->setEdgeProps(buildEdgeKey(true));
+    backward->setInputVar(toStartVidsVar);
+
+    // Both sides fetch the edges around them with the weights, then Dijkstra finds the
+    // lightest paths over all of them, see ConjunctPathExecutor
+    auto* conjunct = ConjunctPath::make(
+        qctx_, forward, backward, ConjunctPath::PathKind::kWeighted, steps_.steps);
+    conjunct->setLeftVar(forward->outputVar());
+    conjunct->setRightVar(backward->outputVar());
+    conjunct->setStartVidsVars(fromStartVidsVar, toStartVidsVar);
+    conjunct->setWeightProp(weightProp_);
+    conjunct->setColNames({"_path", "weight"});
+
+    PlanNode* loopDep = nullptr;
+    linkLoopDepFromTo(loopDep);
+
+    auto* loop = Loop::make(qctx_,
+                            loopDep,
+                            conjunct,
+                            buildBfsLoopCondition(steps_.steps,
+                                                  conjunct->outputVar(),
+                                                  fromStartVidsVar,
+                                                  toStartVidsVar));
+
+    auto* dataCollect = DataCollect::make(
+        qctx_, loop, DataCollect::CollectKind::kAllPaths, {conjunct->outputVar()});
+    dataCollect->setColNames({"path", "weight"});
+
+    root_ = dataCollect;
+    tail_ = loopDepTail_ == nullptr ? loop : loopDepTail_;
+    return Status::OK();
+}
+
 PlanNode* FindPathValidator::bfs(PlanNode* dep,
                                  Starts& starts,
+                                 std::string& startVidsVar,
                                  std::string& pathVar,
                                  bool reverse) {
-    std::string startVidsVar;
     buildConstantInput(starts, startVidsVar);
 
     auto* gn = GetNeighbors::make(qctx_, dep, space_.id);
@@ -123,8 +211,13 @@ PlanNode* FindPathValidator::bfs(PlanNode* dep,
     return dedup;
 }
 
-Expression* FindPathValidator::buildBfsLoopCondition(uint32_t steps, const std::string& pathVar) {
-    // ++loopSteps{0} <= (steps/2+steps%2) && size(pathVar) == 0
+Expression* FindPathValidator::buildBfsLoopCondition(uint32_t steps,
+                                                     const std::string& pathVar,
+                                                     const std::string& fromStartVidsVar,
+                                                     const std::string& toStartVidsVar) {
+    // ++loopSteps{0} <= steps && (pathVar == NULL || size(pathVar) == 0) &&
+    // (size(fromStartVidsVar) != 0 || size(toStartVidsVar) != 0)
+    // Each round expands one side at least, and neither side when no path is within the steps
     auto loopSteps = vctx_->anonVarGen()->getVar();
     qctx_->ectx()->setValue(loopSteps, 0);
 
@@ -133,7 +226,7 @@ Expression* FindPathValidator::buildBfsLoopCondition(uint32_t steps, const std::
         new UnaryExpression(
             Expression::Kind::kUnaryIncr,
             new VersionedVariableExpression(new std::string(loopSteps), new ConstantExpression(0))),
-        new ConstantExpression(static_cast<int32_t>(steps / 2 + steps % 2)));
+        new ConstantExpression(static_cast<int32_t>(steps)));
 
     auto* args = new ArgumentList();
     args->addArgument(std::make_unique<VariableExpression>(new std::string(pathVar)));
@@ -147,8 +240,23 @@ Expression* FindPathValidator::buildBfsLoopCondition(uint32_t steps, const std::
                                  new VariableExpression(new std::string(pathVar)),
                                  new ConstantExpression(Value())),
         pathEmpty);
-    return qctx_->objPool()->add(
-        new LogicalExpression(Expression::Kind::kLogicalAnd, nSteps, notFoundPath));
+
+    auto startVidsNotEmpty = [](const std::string& startVidsVar) {
+        auto* startVidsArgs = new ArgumentList();
+        startVidsArgs->addArgument(
+            std::make_unique<VariableExpression>(new std::string(startVidsVar)));
+        return new RelationalExpression(
+            Expression::Kind::kRelNE,
+            new FunctionCallExpression(new std::string("size"), startVidsArgs),
+            new ConstantExpression(0));
+    };
+    auto* anyExpanded = new LogicalExpression(Expression::Kind::kLogicalOr,
+                                              startVidsNotEmpty(fromStartVidsVar),
+                                              startVidsNotEmpty(toStartVidsVar));
+    return qctx_->objPool()->add(new LogicalExpression(
+        Expression::Kind::kLogicalAnd,
+        new LogicalExpression(Expression::Kind::kLogicalAnd, nSteps, notFoundPath),
+        anyExpanded));
 }
 
 void FindPathValidator::buildEdgeProps(GetNeighbors::EdgeProps& edgeProps,
@@ -161,7 +269,11 @@ void FindPathValidator::buildEdgeProps(GetNeighbors::EdgeProps& edgeProps,
         } else {
             ep.set_type(-e);
         }
-        ep.set_props({kDst, kType, kRank});
+        std::vector<std::string> props{kDst, kType, kRank};
+        if (isWeight_) {
+            props.emplace_back(weightProp_);
+        }
+        ep.set_props(std::move(props));
         edgeProps->emplace_back(std::move(ep));
     }
 }
@@ -192,22 +304,19 @@ PlanNode* FindPathValidator::buildAllPairFirstDataSet(PlanNode* dep,
     auto* vid =
         new YieldColumn(new VariablePropertyExpression(new std::string("*"), new std::string(kVid)),
                         new std::string(kVid));
-    auto* pathExpr = new PathBuildExpression();
-    pathExpr->add(
-        std::make_unique<VariablePropertyExpression>(new std::string("*"), new std::string(kVid)));
-    auto* exprList = new ExpressionList();
-    exprList->add(pathExpr);
-    auto* listExprssion = new ListExpression(exprList);
-    auto* path = new YieldColumn(listExprssion, new std::string("path"));
+    // The starts are the paths of no edge
+    auto* edge = new YieldColumn(new ConstantExpression(Value()), new std::string("edge"));
+    auto* parent = new YieldColumn(new ConstantExpression(-1), new std::string("parent"));
 
     auto* columns = qctx_->objPool()->add(new YieldColumns());
     columns->addColumn(vid);
-    columns->addColumn(path);
+    columns->addColumn(edge);
+    columns->addColumn(parent);
 
     auto* project = Project::make(qctx_, dep, columns);
     project->setInputVar(inputVar);
     auto* outputVarPtr = qctx_->symTable()->getVar(outputVar);
-    outputVarPtr->colNames = {kVid, "path"};
+    outputVarPtr->colNames = {kVid, "edge", "parent"};
     project->setOutputVar(outputVar);
     return project;
 }
@@ -264,7 +373,7 @@ PlanNode* FindPathValidator::allPaths(PlanNode* dep,
     gn->setInputVar(startVidsVar);
 
     auto* allPaths = ProduceAllPaths::make(qctx_, gn);
-    allPaths->setColNames({kVid, "path"});
+    allPaths->setColNames({kVid, "edge", "parent"});
     pathVar = allPaths->outputVar();
 
     auto* columns = qctx_->objPool()->add(new YieldColumns());
@@ -328,121 +437,57 @@ void FindPathValidator::linkLoopDepFromTo(PlanNode*& projectDep) {
     }
 }
 
-PlanNode* FindPathValidator::buildMultiPairFirstDataSet(PlanNode* dep,
-                                                        const std::string& inputVar,
-                                                        const std::string& outputVar) {
-    auto* dst =
-        new YieldColumn(new VariablePropertyExpression(new std::string("*"), new std::string(kVid)),
-                        new std::string(kDst));
-    auto* src =
-        new YieldColumn(new VariablePropertyExpression(new std::string("*"), new std::string(kVid)),
-                        new std::string(kSrc));
-    auto* cost = new YieldColumn(new ConstantExpression(0), new std::string("cost"));
-    auto* pathExpr = new PathBuildExpression();
-    pathExpr->add(
-        std::make_unique<VariablePropertyExpression>(new std::string("*"), new std::string(kVid)));
-    auto* exprList = new ExpressionList();
-    exprList->add(pathExpr);
-    auto* listExprssion = new ListExpression(exprList);
-    auto* paths = new YieldColumn(listExprssion, new std::string("paths"));
-
-    auto* columns = qctx_->objPool()->add(new YieldColumns());
-    columns->addColumn(dst);
-    columns->addColumn(src);
-    columns->addColumn(cost);
-    columns->addColumn(paths);
-
-    auto* project = Project::make(qctx_, dep, columns);
-    project->setInputVar(inputVar);
-    auto* outputVarPtr = qctx_->symTable()->getVar(outputVar);
-    outputVarPtr->colNames = {kDst, kSrc, "cost", "paths"};
-    project->setOutputVar(outputVar);
-    return project;
-}
-
 Status FindPathValidator::multiPairPlan() {
     auto* bodyStart = StartNode::make(qctx_);
     auto* passThrough = PassThroughNode::make(qctx_, bodyStart);
 
     std::string fromStartVidsVar;
     buildStart(from_, fromStartVidsVar, false);
-    std::string fromPathVar;
-    auto* forward = multiPairShortestPath(passThrough, from_, fromStartVidsVar, fromPathVar, false);
-    VLOG(1) << "forward: " << fromPathVar;
+    auto* forward = GetNeighbors::make(qctx_, passThrough, space_.id);
+    forward->setSrc(from_.src);
+    forward->setEdgeProps(buildEdgeKey(false));
+    forward->setInputVar(fromStartVidsVar);
 
     std::string toStartVidsVar;
     buildStart(to_, toStartVidsVar, true);
-    std::string toPathVar;
-    auto* backward = multiPairShortestPath(passThrough, to_, toStartVidsVar, toPathVar, true);
-    VLOG(1) << "backward: " << toPathVar;
-
-    auto* conjunct =
-        ConjunctPath::make(qctx_, forward, backward, ConjunctPath::PathKind::kFloyd, steps_.steps);
-
-    conjunct->setLeftVar(fromPathVar);
-    conjunct->setRightVar(toPathVar);
-    conjunct->setColNames({"_path", "cost"});
-
-    PlanNode* projectFromDep = nullptr;
-    linkLoopDepFromTo(projectFromDep);
+    auto* backward = GetNeighbors::make(qctx_, passThrough, space_.id);
+    backward->setSrc(to_.src);
+    backward->setEdgeProps(buildEdgeKey(true));
+    backward->setInputVar(toStartVidsVar);
 
-    auto* projectFrom = buildMultiPairFirstDataSet(projectFromDep, fromStartVidsVar, fromPathVar);
-    auto* projectTo = buildMultiPairFirstDataSet(projectFrom, toStartVidsVar, toPathVar);
-
-    auto* cartesianProduct = CartesianProduct::make(qctx_, projectTo);
-    NG_RETURN_IF_ERROR(cartesianProduct->addVar(fromStartVidsVar));
-    NG_RETURN_IF_ERROR(cartesianProduct->addVar(toStartVidsVar));
+    // Each side searches from all of its starts at once, and the paths of each pair are
+    // built once met, see ConjunctPathExecutor
+    auto* conjunct = ConjunctPath::make(
+        qctx_, forward, backward, ConjunctPath::PathKind::kMultiBFS, steps_.steps);
+    conjunct->setLeftVar(forward->outputVar());
+    conjunct->setRightVar(backward->outputVar());
+    conjunct->setStartVidsVars(fromStartVidsVar, toStartVidsVar);
+    conjunct->setColNames({"_path"});
 
-    conjunct->setConditionalVar(cartesianProduct->outputVar());
+    PlanNode* loopDep = nullptr;
+    linkLoopDepFromTo(loopDep);
 
-    auto* loop =
-        Loop::make(qctx_,
-                   cartesianProduct,
-                   conjunct,
-                   buildMultiPairLoopCondition(steps_.steps, cartesianProduct->outputVar()));
+    auto* loop = Loop::make(
+        qctx_,
+        loopDep,
+        conjunct,
+        buildMultiPairLoopCondition(steps_.steps, fromStartVidsVar, toStartVidsVar));
 
     auto* dataCollect = DataCollect::make(
-        qctx_, loop, DataCollect::CollectKind::kMultiplePairShortest, {conjunct->outputVar()});
+        qctx_, loop, DataCollect::CollectKind::kAllPaths, {conjunct->outputVar()});
     dataCollect->setColNames({"path"});
 
     root_ = dataCollect;
-    tail_ = loopDepTail_ == nullptr ? projectFrom : loopDepTail_;
+    tail_ = loopDepTail_ == nullptr ? loop : loopDepTail_;
     return Status::OK();
 }
 
-PlanNode* FindPathValidator::multiPairShortestPath(PlanNode* dep,
-                                                   Starts& starts,
-                                                   std::string& startVidsVar,
-                                                   std::string& pathVar,
-                                                   bool reverse) {
-    auto* gn = GetNeighbors::make(qctx_, dep, space_.id);
-    gn->setSrc(starts.src);
-    gn->setEdgeProps(buildEdgeKey(reverse));
-    gn->setInputVar(startVidsVar);
-
-    auto* pssp = ProduceSemiShortestPath::make(qctx_, gn);
-    pssp->setColNames({kDst, kSrc, "cost", "paths"});
-    pathVar = pssp->outputVar();
-
-    auto* columns = qctx_->objPool()->add(new YieldColumns());
-    auto* column =
-        new YieldColumn(new VariablePropertyExpression(new std::string("*"), new std::string(kDst)),
-                        new std::string(kVid));
-    columns->addColumn(column);
-    auto* project = Project::make(qctx_, pssp, columns);
-    project->setColNames(deduceColNames(columns));
-
-    auto* dedup = Dedup::make(qctx_, project);
-    auto* startVidsVarPtr = qctx_->symTable()->getVar(startVidsVar);
-    startVidsVarPtr->colNames = project->colNames();
-    dedup->setOutputVar(startVidsVar);
-
-    return dedup;
-}
-
 Expression* FindPathValidator::buildMultiPairLoopCondition(uint32_t steps,
-                                                           std::string conditionalVar) {
-    // (++loopSteps{0} <= steps/2+steps%2) && (isWeight_ == true || size(conditionalVar) == 0)
+                                                           const std::string& fromStartVidsVar,
+                                                           const std::string& toStartVidsVar) {
+    // ++loopSteps{0} <= steps/2+steps%2 &&
+    // (size(fromStartVidsVar) != 0 || size(toStartVidsVar) != 0)
+    // The start vids are cleared once all the pairs are met
     auto loopSteps = vctx_->anonVarGen()->getVar();
     qctx_->ectx()->setValue(loopSteps, 0);
 
@@ -453,23 +498,18 @@ Expression* FindPathValidator::buildMultiPairLoopCondition(uint32_t steps,
             new VersionedVariableExpression(new std::string(loopSteps), new ConstantExpression(0))),
         new ConstantExpression(static_cast<int32_t>(steps / 2 + steps % 2)));
 
-    auto* args = new ArgumentList();
-    args->addArgument(std::make_unique<VariableExpression>(new std::string(conditionalVar)));
-    auto* notAllPathFind =
-        new RelationalExpression(Expression::Kind::kRelEQ,
-                                 new FunctionCallExpression(new std::string("size"), args),
-                                 new ConstantExpression(0));
-
-    auto* terminationCondition =
-        new LogicalExpression(Expression::Kind::kLogicalOr,
-                              new RelationalExpression(Expression::Kind::kRelEQ,
-                                                       new ConstantExpression(isWeight_),
-                                                       new ConstantExpression(true)),
-                              notAllPathFind);
-    auto* condition =
-        new LogicalExpression(Expression::Kind::kLogicalAnd, nSteps, terminationCondition);
-
-    return qctx_->objPool()->add(condition);
+    auto startVidsNotEmpty = [](const std::string& startVidsVar) {
+        auto* args = new ArgumentList();
+        args->addArgument(std::make_unique<VariableExpression>(new std::string(startVidsVar)));
+        return new RelationalExpression(Expression::Kind::kRelNE,
+                                        new FunctionCallExpression(new std::string("size"), args),
+                                        new ConstantExpression(0));
+    };
+    auto* anyExpanded = new LogicalExpression(Expression::Kind::kLogicalOr,
+                                              startVidsNotEmpty(fromStartVidsVar),
+                                              startVidsNotEmpty(toStartVidsVar));
+    return qctx_->objPool()->add(
+        new LogicalExpression(Expression::Kind::kLogicalAnd, nSteps, anyExpanded));
 }
 
 }  // namespace graph
@@ -21,6 +21,8 @@ public:
 private:
     Status validateImpl() override;
 
+    Status validateWeight();
+
     Status toPlan() override;
     void buildEdgeProps(GetNeighbors::EdgeProps& edgeProps, bool reverse, bool isInEdge);
     void buildStart(Starts& starts, std::string& startVidsVar, bool reverse);
@@ -28,8 +30,18 @@ private:
     void linkLoopDepFromTo(PlanNode*& projectDep);
     // bfs
     Status singlePairPlan();
-    PlanNode* bfs(PlanNode* dep, Starts& starts, std::string& pathVar, bool reverse);
-    Expression* buildBfsLoopCondition(uint32_t steps, const std::string& pathVar);
+    PlanNode* bfs(PlanNode* dep,
+                  Starts& starts,
+                  std::string& startVidsVar,
+                  std::string& pathVar,
+                  bool reverse);
+    Expression* buildBfsLoopCondition(uint32_t steps,
+                                      const std::string& pathVar,
+                                      const std::string& fromStartVidsVar,
+                                      const std::string& toStartVidsVar);
+
+    // weighted by an edge property
+    Status weightedPairPlan();
 
     // allPath
     Status allPairPaths();
@@ -45,19 +57,14 @@ private:
 
     // multi-pair
     Status multiPairPlan();
-    PlanNode* multiPairShortestPath(PlanNode* dep,
-                                    Starts& starts,
-                                    std::string& startVidsVar,
-                                    std::string& pathVar,
-                                    bool reverse);
-    Expression* buildMultiPairLoopCondition(uint32_t steps, std::string conditionalVar);
-    PlanNode* buildMultiPairFirstDataSet(PlanNode* dep,
-                                         const std::string& inputVar,
-                                         const std::string& outputVar);
+    Expression* buildMultiPairLoopCondition(uint32_t steps,
+                                            const std::string& fromStartVidsVar,
+                                            const std::string& toStartVidsVar);
 
 private:
     bool isShortest_{false};
     bool isWeight_{false};
+    std::string weightProp_;
     bool noLoop_{false};
     Starts to_;
     Over over_;
@@ -26,6 +26,9 @@ Status InsertVerticesValidator::validateImpl() {
         if (!status.ok()) {
             break;
         }
+        // The vertices are all made of the rows, which aren't needed any more
+        rows_.clear();
+        rowList_.reset();
     } while (false);
     return status;
 }
@@ -44,7 +47,8 @@ Status InsertVerticesValidator::toPlan() {
 
 Status InsertVerticesValidator::check() {
     auto sentence = static_cast<InsertVerticesSentence*>(sentence_);
-    rows_ = sentence->rows();
+    rowList_ = sentence->moveRows();
+    rows_ = rowList_->rows();
     if (rows_.empty()) {
         return Status::SemanticError("VALUES cannot be empty");
     }
@@ -143,6 +147,9 @@ Status InsertEdgesValidator::validateImpl() {
     spaceId_ = vctx_->whichSpace().id;
     NG_RETURN_IF_ERROR(check());
     NG_RETURN_IF_ERROR(prepareEdges());
+    // The edges are all made of the rows, which aren't needed any more
+    rows_.clear();
+    rowList_.reset();
     return Status::OK();
 }
 
@@ -167,7 +174,8 @@ Status InsertEdgesValidator::check() {
     NG_RETURN_IF_ERROR(edgeStatus);
     edgeType_ = edgeStatus.value();
     auto props = sentence->properties();
-    rows_ = sentence->rows();
+    rowList_ = sentence->moveRows();
+    rows_ = rowList_->rows();
 
     schema_ = qctx_->schemaMng()->getEdgeSchema(spaceId_, edgeType_);
     if (schema_ == nullptr) {
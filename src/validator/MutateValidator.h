@@ -33,6 +33,8 @@ private:
 private:
     using TagSchema = std::shared_ptr<const meta::SchemaProviderIf>;
     GraphSpaceID                                                spaceId_{-1};
+    // Moved out of the sentence, dropped once the vertices are made
+    std::unique_ptr<VertexRowList>                              rowList_;
     std::vector<VertexRowItem*>                                 rows_;
     std::unordered_map<TagID, std::vector<std::string>>         tagPropNames_;
     std::vector<std::pair<TagID, TagSchema>>                    schemas_;
@@ -62,6 +64,8 @@ private:
     EdgeType                                          edgeType_{-1};
     std::shared_ptr<const meta::SchemaProviderIf>     schema_;
     std::vector<std::string>                          propNames_;
+    // Moved out of the sentence, dropped once the edges are made
+    std::unique_ptr<EdgeRowList>                      rowList_;
     std::vector<EdgeRowItem*>                         rows_;
     std::vector<storage::cpp2::NewEdge>               edges_;
 };
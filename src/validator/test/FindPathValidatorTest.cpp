@@ -88,17 +88,8 @@ TEST_F(FindPathValidatorTest, MultiPairPath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
             PK::kStart,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
             PK::kPassThrough,
@@ -111,17 +102,8 @@ TEST_F(FindPathValidatorTest, MultiPairPath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
             PK::kStart,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
             PK::kPassThrough,
@@ -135,23 +117,44 @@ TEST_F(FindPathValidatorTest, MultiPairPath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
+            PK::kStart,
             PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
+            PK::kGetNeighbors,
+            PK::kGetNeighbors,
+            PK::kPassThrough,
+            PK::kStart,
+        };
+        EXPECT_TRUE(checkResult(query, expected, {"path"}));
+    }
+}
+
+TEST_F(FindPathValidatorTest, WeightedPath) {
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like UPTO 5 STEPS "
+                            "WEIGHT BY likeness";
+        std::vector<PlanNode::Kind> expected = {
+            PK::kDataCollect,
+            PK::kLoop,
             PK::kStart,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
             PK::kPassThrough,
             PK::kStart,
         };
-        EXPECT_TRUE(checkResult(query, expected));
+        EXPECT_TRUE(checkResult(query, expected, {"path", "weight"}));
+    }
+    {
+        // Not a property of serve
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like, serve "
+                            "WEIGHT BY likeness";
+        auto result = checkResult(query);
+        EXPECT_EQ(std::string(result.message()),
+                  "SemanticError: Weight `likeness' should be a numeric property of edge `serve'.");
+    }
+    {
+        std::string query = "FIND SHORTEST PATH FROM \"1\" TO \"2\" OVER like WEIGHT BY weight";
+        EXPECT_FALSE(checkResult(query));
     }
 }
 
@@ -254,17 +257,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
             PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
-            PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
@@ -315,17 +309,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
             PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
@@ -344,17 +329,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
             PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
-            PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
@@ -373,17 +349,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
             PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
-            PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
@@ -404,17 +371,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
-            PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
             PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
@@ -437,17 +395,8 @@ TEST_F(FindPathValidatorTest, RunTimePath) {
         std::vector<PlanNode::Kind> expected = {
             PK::kDataCollect,
             PK::kLoop,
-            PK::kCartesianProduct,
-            PK::kConjunctPath,
-            PK::kProject,
-            PK::kDedup,
             PK::kDedup,
-            PK::kProject,
-            PK::kProject,
-            PK::kProject,
-            PK::kDedup,
-            PK::kProduceSemiShortestPath,
-            PK::kProduceSemiShortestPath,
+            PK::kConjunctPath,
             PK::kProject,
             PK::kGetNeighbors,
             PK::kGetNeighbors,
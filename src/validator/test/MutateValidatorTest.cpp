@@ -4,6 +4,9 @@
  * attached with Common Clause Condition 1.0, found in the LICENSES directory.
  */
 
+#include "parser/MutateSentences.h"
+#include "parser/SequentialSentences.h"
+#include "planner/Mutate.h"
 #include "validator/test/ValidatorTestBase.h"
 
 namespace nebula {
@@ -49,6 +52,43 @@ TEST_F(MutateValidatorTest, InsertEdgeTest) {
     }
 }
 
+TEST_F(MutateValidatorTest, ClearInsertRows) {
+    // The rows are moved out of the sentence, and dropped once they're converted into the plan
+    auto validate = [this](const std::string& query) -> const PlanNode* {
+        auto result = GQLParser().parse(query);
+        EXPECT_TRUE(result.ok()) << result.status();
+        if (!result.ok()) {
+            return nullptr;
+        }
+        auto* seq = static_cast<SequentialSentences*>(
+            pool_->add(std::move(result).value().release()));
+        auto* sentence = seq->sentences().front();
+        auto* qctx = buildContext();
+        auto status = Validator::validate(seq, qctx);
+        EXPECT_TRUE(status.ok()) << status;
+        if (sentence->kind() == Sentence::Kind::kInsertVertices) {
+            EXPECT_TRUE(static_cast<InsertVerticesSentence*>(sentence)->consumed());
+        } else {
+            EXPECT_TRUE(static_cast<InsertEdgesSentence*>(sentence)->consumed());
+        }
+        return qctx->plan()->root();
+    };
+    {
+        auto* root = validate("INSERT VERTEX person(name, age) VALUES "
+                              "\"A\":(\"a\", 19), \"B\":(\"b\", 20)");
+        ASSERT_NE(root, nullptr);
+        ASSERT_EQ(root->kind(), PK::kInsertVertices);
+        EXPECT_EQ(static_cast<const InsertVertices*>(root)->getVertices().size(), 2);
+    }
+    {
+        auto* root = validate("INSERT EDGE like(start, end) VALUES "
+                              "\"A\"->\"B\":(2010, 2020), \"B\"->\"C\":(2011, 2021)");
+        ASSERT_NE(root, nullptr);
+        ASSERT_EQ(root->kind(), PK::kInsertEdges);
+        EXPECT_EQ(static_cast<const InsertEdges*>(root)->getEdges().size(), 2);
+    }
+}
+
 TEST_F(MutateValidatorTest, DeleteVertexTest) {
     // succeed
     {